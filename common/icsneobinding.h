@@ -0,0 +1,774 @@
+#ifndef __ICSNEOBINDING_H_
+#define __ICSNEOBINDING_H_
+
+/*
+ * The native code shared by the SWIG bindings, icsneojava and icsneocsharp. Each binding includes this
+ * from its interface file, exposes the functions meant for the managed side under its own prefix with
+ * %rename, and keeps only what really differs between the two.
+ *
+ * Everything here is static, so each binding's library gets its own copy. A binding can #define
+ * icsneobinding_filter_t and icsneobinding_listener_t before including this, to give the structs the names its
+ * proxy classes are generated from.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "icsneo/icsneoc.h"
+
+/* The threading primitives, for the table of owned payloads below and for the listeners */
+#ifdef _WIN32
+#include <windows.h>
+typedef SRWLOCK icsneobinding_mutex_t;
+typedef CONDITION_VARIABLE icsneobinding_cond_t;
+typedef HANDLE icsneobinding_thread_t;
+typedef uint64_t icsneobinding_deadline_t; /* In microseconds of the performance counter */
+#define ICSNEOBINDING_MUTEX_INITIALIZER SRWLOCK_INIT
+#else
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+typedef pthread_mutex_t icsneobinding_mutex_t;
+typedef pthread_cond_t icsneobinding_cond_t;
+typedef pthread_t icsneobinding_thread_t;
+typedef struct timespec icsneobinding_deadline_t;
+#define ICSNEOBINDING_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#endif
+
+#ifdef _WIN32
+static void icsneobinding_mutexInit(icsneobinding_mutex_t* mutex) { InitializeSRWLock(mutex); }
+static void icsneobinding_mutexDestroy(icsneobinding_mutex_t* mutex) { (void)mutex; }
+static void icsneobinding_lock(icsneobinding_mutex_t* mutex) { AcquireSRWLockExclusive(mutex); }
+static void icsneobinding_unlock(icsneobinding_mutex_t* mutex) { ReleaseSRWLockExclusive(mutex); }
+static void icsneobinding_condInit(icsneobinding_cond_t* cond) { InitializeConditionVariable(cond); }
+static void icsneobinding_condDestroy(icsneobinding_cond_t* cond) { (void)cond; }
+static void icsneobinding_signal(icsneobinding_cond_t* cond) { WakeAllConditionVariable(cond); }
+static void icsneobinding_wait(icsneobinding_cond_t* cond, icsneobinding_mutex_t* mutex) { SleepConditionVariableSRW(cond, mutex, INFINITE, 0); }
+
+static uint64_t icsneobinding_nowMicroseconds(void) {
+	LARGE_INTEGER counter, frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000 + (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+}
+
+static void icsneobinding_deadlineAfter(icsneobinding_deadline_t* deadline, uint64_t microseconds) {
+	*deadline = icsneobinding_nowMicroseconds() + microseconds;
+}
+
+/* Waits for a signal until deadline, returning 0 once the deadline has passed */
+static int icsneobinding_waitUntil(icsneobinding_cond_t* cond, icsneobinding_mutex_t* mutex, const icsneobinding_deadline_t* deadline) {
+	uint64_t now = icsneobinding_nowMicroseconds();
+	if(now >= *deadline)
+		return 0;
+	SleepConditionVariableSRW(cond, mutex, (DWORD)((*deadline - now + 999) / 1000), 0);
+	return 1;
+}
+#else
+static void icsneobinding_mutexInit(icsneobinding_mutex_t* mutex) { pthread_mutex_init(mutex, NULL); }
+static void icsneobinding_mutexDestroy(icsneobinding_mutex_t* mutex) { pthread_mutex_destroy(mutex); }
+static void icsneobinding_lock(icsneobinding_mutex_t* mutex) { pthread_mutex_lock(mutex); }
+static void icsneobinding_unlock(icsneobinding_mutex_t* mutex) { pthread_mutex_unlock(mutex); }
+static void icsneobinding_condInit(icsneobinding_cond_t* cond) { pthread_cond_init(cond, NULL); }
+static void icsneobinding_condDestroy(icsneobinding_cond_t* cond) { pthread_cond_destroy(cond); }
+static void icsneobinding_signal(icsneobinding_cond_t* cond) { pthread_cond_broadcast(cond); }
+static void icsneobinding_wait(icsneobinding_cond_t* cond, icsneobinding_mutex_t* mutex) { pthread_cond_wait(cond, mutex); }
+
+/* pthread_cond_timedwait measures against CLOCK_REALTIME */
+static void icsneobinding_deadlineAfter(icsneobinding_deadline_t* deadline, uint64_t microseconds) {
+	clock_gettime(CLOCK_REALTIME, deadline);
+	deadline->tv_sec += (time_t)(microseconds / 1000000);
+	deadline->tv_nsec += (long)(microseconds % 1000000) * 1000;
+	if(deadline->tv_nsec >= 1000000000) {
+		deadline->tv_sec++;
+		deadline->tv_nsec -= 1000000000;
+	}
+}
+
+/* Waits for a signal until deadline, returning 0 once the deadline has passed */
+static int icsneobinding_waitUntil(icsneobinding_cond_t* cond, icsneobinding_mutex_t* mutex, const icsneobinding_deadline_t* deadline) {
+	return pthread_cond_timedwait(cond, mutex, deadline) != ETIMEDOUT;
+}
+#endif
+
+/*
+ * A block of memory kept per thread and grown as needed, for arrays which only live for the length of one call,
+ * so a transmit or a filtered poll allocates nothing once the thread has made its largest one. It is freed when the
+ * thread exits. Each call may reuse the block, so the caller has to be done with it before calling again.
+ */
+typedef struct {
+	void* block;
+	size_t size;
+} icsneobinding_scratch_t;
+
+static void icsneobinding_freeScratch(void* scratch) {
+	if(scratch == NULL)
+		return;
+	free(((icsneobinding_scratch_t*) scratch)->block);
+	free(scratch);
+}
+
+#ifdef _WIN32
+static INIT_ONCE icsneobinding_scratchOnce = INIT_ONCE_STATIC_INIT;
+static DWORD icsneobinding_scratchKey = FLS_OUT_OF_INDEXES;
+
+static VOID NTAPI icsneobinding_scratchDestructor(PVOID scratch) {
+	icsneobinding_freeScratch(scratch);
+}
+
+static BOOL CALLBACK icsneobinding_createScratchKey(PINIT_ONCE once, PVOID parameter, PVOID* context) {
+	(void)once;
+	(void)parameter;
+	(void)context;
+	icsneobinding_scratchKey = FlsAlloc(icsneobinding_scratchDestructor);
+	return TRUE;
+}
+
+static icsneobinding_scratch_t* icsneobinding_getScratch(void) {
+	InitOnceExecuteOnce(&icsneobinding_scratchOnce, icsneobinding_createScratchKey, NULL, NULL);
+	if(icsneobinding_scratchKey == FLS_OUT_OF_INDEXES)
+		return NULL;
+	return (icsneobinding_scratch_t*) FlsGetValue(icsneobinding_scratchKey);
+}
+
+static bool icsneobinding_setScratch(icsneobinding_scratch_t* scratch) {
+	return FlsSetValue(icsneobinding_scratchKey, scratch) != 0;
+}
+#else
+static pthread_once_t icsneobinding_scratchOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t icsneobinding_scratchKey;
+static bool icsneobinding_scratchKeyCreated;
+
+static void icsneobinding_createScratchKey(void) {
+	icsneobinding_scratchKeyCreated = pthread_key_create(&icsneobinding_scratchKey, icsneobinding_freeScratch) == 0;
+}
+
+static icsneobinding_scratch_t* icsneobinding_getScratch(void) {
+	pthread_once(&icsneobinding_scratchOnce, icsneobinding_createScratchKey);
+	if(!icsneobinding_scratchKeyCreated)
+		return NULL;
+	return (icsneobinding_scratch_t*) pthread_getspecific(icsneobinding_scratchKey);
+}
+
+static bool icsneobinding_setScratch(icsneobinding_scratch_t* scratch) {
+	return pthread_setspecific(icsneobinding_scratchKey, scratch) == 0;
+}
+#endif
+
+/* Returns this thread's scratch block with room for at least size bytes, its contents undefined, or NULL on failure */
+static void* icsneobinding_scratch(size_t size) {
+	icsneobinding_scratch_t* scratch = icsneobinding_getScratch();
+
+	if(scratch == NULL) {
+		scratch = (icsneobinding_scratch_t*) calloc(1, sizeof(icsneobinding_scratch_t));
+		if(scratch == NULL)
+			return NULL;
+		if(!icsneobinding_setScratch(scratch)) {
+			free(scratch);
+			return NULL;
+		}
+	}
+	if(size > scratch->size) {
+		void* block = realloc(scratch->block, size);
+		if(block == NULL)
+			return NULL;
+		scratch->block = block;
+		scratch->size = size;
+	}
+	return scratch->block;
+}
+
+/*
+ * A payload set from managed code is copied into a block the binding allocates. Which messages own a block is
+ * kept here, keyed by the message's address, rather than anywhere in the message, so copies made with
+ * neomessage_t_array_setitem or _getitem, and polled messages, never own one and are never freed from. Copies
+ * point at the same block though, so they must not be used after the original is deleted or its data is set again.
+ */
+typedef struct {
+	const void* message;
+	uint8_t* data;
+} icsneobinding_ownedData_t;
+
+static icsneobinding_mutex_t icsneobinding_ownedDataMutex = ICSNEOBINDING_MUTEX_INITIALIZER;
+static icsneobinding_ownedData_t* icsneobinding_ownedData;
+static size_t icsneobinding_ownedDataCount;
+static size_t icsneobinding_ownedDataCapacity;
+
+/* The index of message's entry, or icsneobinding_ownedDataCount if it owns nothing. Called with the table locked. */
+static size_t icsneobinding_findOwnedData(const void* message) {
+	size_t i;
+	for(i = 0; i < icsneobinding_ownedDataCount; i++) {
+		if(icsneobinding_ownedData[i].message == message)
+			break;
+	}
+	return i;
+}
+
+/* Frees the payload message owns, if any. Messages which own nothing, such as polled ones, are left alone. */
+static void icsneobinding_freeData(void* message) {
+	neomessage_t* msg = (neomessage_t*) message;
+	uint8_t* data = NULL;
+	size_t i;
+
+	if(msg == NULL)
+		return;
+	icsneobinding_lock(&icsneobinding_ownedDataMutex);
+	i = icsneobinding_findOwnedData(message);
+	if(i < icsneobinding_ownedDataCount) {
+		data = icsneobinding_ownedData[i].data;
+		icsneobinding_ownedData[i] = icsneobinding_ownedData[--icsneobinding_ownedDataCount];
+	}
+	icsneobinding_unlock(&icsneobinding_ownedDataMutex);
+	if(data == NULL)
+		return;
+	if(msg->data == data)
+		msg->data = NULL;
+	free(data);
+}
+
+/*
+ * Sets the data of a neomessage_t, neomessage_can_t or neomessage_eth_t to a copy of length bytes, which the
+ * message owns and frees when it is deleted or its data is set again. NULL bytes or a length of 0 clear it.
+ * Returns false, leaving the message as it was, if the copy could not be allocated.
+ */
+static bool icsneobinding_setData(void* message, const void* bytes, size_t length) {
+	uint8_t* data = NULL;
+	uint8_t* previous = NULL;
+	size_t i;
+
+	if(message == NULL)
+		return false;
+	if(bytes != NULL && length > 0) {
+		data = (uint8_t*) malloc(length);
+		if(data == NULL)
+			return false;
+		memcpy(data, bytes, length);
+	}
+
+	icsneobinding_lock(&icsneobinding_ownedDataMutex);
+	i = icsneobinding_findOwnedData(message);
+	if(i < icsneobinding_ownedDataCount) {
+		previous = icsneobinding_ownedData[i].data;
+		if(data != NULL)
+			icsneobinding_ownedData[i].data = data;
+		else
+			icsneobinding_ownedData[i] = icsneobinding_ownedData[--icsneobinding_ownedDataCount];
+	} else if(data != NULL) {
+		if(icsneobinding_ownedDataCount == icsneobinding_ownedDataCapacity) {
+			size_t capacity = icsneobinding_ownedDataCapacity == 0 ? 16 : icsneobinding_ownedDataCapacity * 2;
+			icsneobinding_ownedData_t* ownedData = (icsneobinding_ownedData_t*) realloc(icsneobinding_ownedData, capacity * sizeof(icsneobinding_ownedData_t));
+			if(ownedData == NULL) {
+				icsneobinding_unlock(&icsneobinding_ownedDataMutex);
+				free(data);
+				return false;
+			}
+			icsneobinding_ownedData = ownedData;
+			icsneobinding_ownedDataCapacity = capacity;
+		}
+		icsneobinding_ownedData[icsneobinding_ownedDataCount].message = message;
+		icsneobinding_ownedData[icsneobinding_ownedDataCount].data = data;
+		icsneobinding_ownedDataCount++;
+	}
+	icsneobinding_unlock(&icsneobinding_ownedDataMutex);
+
+	((neomessage_t*) message)->data = data;
+	free(previous);
+	return true;
+}
+
+/*
+ * Receive filters are evaluated before messages are copied out for the managed side, so messages nobody
+ * asked for never cross the boundary. A message passes when each configured part of the filter accepts it:
+ *  - its network ID is in the netid set, if any netids were added
+ *  - its network type is in the type set, if any types were added
+ *  - for CAN messages, (arbid & mask) is within [low, high] for one of the arbid ranges, if any were added
+ * An empty filter passes everything.
+ */
+typedef struct {
+	uint32_t low;
+	uint32_t high;
+	uint32_t mask;
+} icsneobinding_arbidRange_t;
+
+struct icsneobinding_filter_t {
+	uint32_t netids[65536 / 32];
+	uint32_t types[256 / 32];
+	icsneobinding_arbidRange_t* arbidRanges;
+	size_t arbidRangeCount;
+	size_t arbidRangeCapacity;
+	bool anyNetid;
+	bool anyType;
+};
+
+static bool icsneobinding_filterMatches(const struct icsneobinding_filter_t* filter, const neomessage_t* message) {
+	size_t i;
+
+	if(filter == NULL)
+		return true;
+	if(!filter->anyNetid && !(filter->netids[message->netid / 32] & (1u << (message->netid % 32))))
+		return false;
+	if(!filter->anyType && !(filter->types[message->type / 32] & (1u << (message->type % 32))))
+		return false;
+	if(filter->arbidRangeCount == 0 || message->type != ICSNEO_NETWORK_TYPE_CAN)
+		return true;
+	for(i = 0; i < filter->arbidRangeCount; i++) {
+		const icsneobinding_arbidRange_t* range = &filter->arbidRanges[i];
+		uint32_t arbid = ((const neomessage_can_t*) message)->arbid & range->mask;
+		if(arbid >= range->low && arbid <= range->high)
+			return true;
+	}
+	return false;
+}
+
+static void icsneobinding_freeFilter(struct icsneobinding_filter_t* filter) {
+	if(filter == NULL)
+		return;
+	free(filter->arbidRanges);
+	free(filter);
+}
+
+/* Returns a copy of filter, for a poller or listener to own, or NULL on failure */
+static struct icsneobinding_filter_t* icsneobinding_duplicateFilter(const struct icsneobinding_filter_t* filter) {
+	struct icsneobinding_filter_t* copy = (struct icsneobinding_filter_t*) malloc(sizeof(struct icsneobinding_filter_t));
+	if(copy == NULL)
+		return NULL;
+	*copy = *filter;
+	copy->arbidRanges = NULL;
+	copy->arbidRangeCapacity = 0;
+	if(filter->arbidRangeCount != 0) {
+		copy->arbidRanges = (icsneobinding_arbidRange_t*) malloc(filter->arbidRangeCount * sizeof(icsneobinding_arbidRange_t));
+		if(copy->arbidRanges == NULL) {
+			free(copy);
+			return NULL;
+		}
+		memcpy(copy->arbidRanges, filter->arbidRanges, filter->arbidRangeCount * sizeof(icsneobinding_arbidRange_t));
+		copy->arbidRangeCapacity = filter->arbidRangeCount;
+	}
+	return copy;
+}
+
+/* Creates an empty filter, which passes everything */
+static struct icsneobinding_filter_t* icsneobinding_newFilter(void) {
+	struct icsneobinding_filter_t* filter = (struct icsneobinding_filter_t*) calloc(1, sizeof(struct icsneobinding_filter_t));
+	if(filter == NULL)
+		return NULL;
+	filter->anyNetid = true;
+	filter->anyType = true;
+	return filter;
+}
+
+static void icsneobinding_deleteFilter(struct icsneobinding_filter_t* filter) {
+	icsneobinding_freeFilter(filter);
+}
+
+/* Makes the filter pass everything again */
+static void icsneobinding_clearFilter(struct icsneobinding_filter_t* filter) {
+	if(filter == NULL)
+		return;
+	free(filter->arbidRanges);
+	memset(filter, 0, sizeof(struct icsneobinding_filter_t));
+	filter->anyNetid = true;
+	filter->anyType = true;
+}
+
+/* Passes messages on netid, along with any other netids added */
+static bool icsneobinding_filterAddNetid(struct icsneobinding_filter_t* filter, int netid) {
+	if(filter == NULL || netid < 0 || netid > 0xFFFF)
+		return false;
+	filter->netids[netid / 32] |= 1u << (netid % 32);
+	filter->anyNetid = false;
+	return true;
+}
+
+/* Passes messages of a network type, such as ICSNEO_NETWORK_TYPE_CAN, along with any other types added */
+static bool icsneobinding_filterAddType(struct icsneobinding_filter_t* filter, int type) {
+	if(filter == NULL || type < 0 || type > 0xFF)
+		return false;
+	filter->types[type / 32] |= 1u << (type % 32);
+	filter->anyType = false;
+	return true;
+}
+
+/*
+ * Passes CAN messages where (arbid & mask) is from low to high inclusive, along with any other ranges added.
+ * Use a mask of 0x7FF or 0x1FFFFFFF to compare the whole arbid, or low == high to match a single value under a mask.
+ */
+static bool icsneobinding_filterAddArbidRange(struct icsneobinding_filter_t* filter, uint32_t low, uint32_t high, uint32_t mask) {
+	if(filter == NULL || low > high)
+		return false;
+	if(filter->arbidRangeCount == filter->arbidRangeCapacity) {
+		size_t capacity = filter->arbidRangeCapacity == 0 ? 4 : filter->arbidRangeCapacity * 2;
+		icsneobinding_arbidRange_t* arbidRanges = (icsneobinding_arbidRange_t*) realloc(filter->arbidRanges, capacity * sizeof(icsneobinding_arbidRange_t));
+		if(arbidRanges == NULL)
+			return false;
+		filter->arbidRanges = arbidRanges;
+		filter->arbidRangeCapacity = capacity;
+	}
+	filter->arbidRanges[filter->arbidRangeCount].low = low;
+	filter->arbidRanges[filter->arbidRangeCount].high = high;
+	filter->arbidRanges[filter->arbidRangeCount].mask = mask;
+	filter->arbidRangeCount++;
+	return true;
+}
+
+/*
+ * icsneo_getMessages, keeping only the messages which pass filter. items is the size of messages going in,
+ * and the number of messages which passed coming out. Messages which did not pass are gone from the device.
+ * With a filter, the device is polled into this thread's scratch block and only the messages which pass are
+ * copied into messages, so the others are never written to the caller's memory, which may be managed memory.
+ * A NULL filter passes everything, and polls straight into messages.
+ */
+static bool icsneobinding_getMessagesFiltered(const neodevice_t* device, const struct icsneobinding_filter_t* filter, neomessage_t* messages, int* items, uint64_t timeout) {
+	neomessage_t* polled;
+	size_t count;
+	size_t i;
+	size_t passed = 0;
+
+	if(items == NULL || *items < 0)
+		return false;
+	count = (size_t) *items;
+	if(filter == NULL) {
+		if(!icsneo_getMessages(device, messages, &count, timeout))
+			return false;
+		*items = (int) count;
+		return true;
+	}
+
+	if(messages == NULL)
+		return false;
+	polled = (neomessage_t*) icsneobinding_scratch((count == 0 ? 1 : count) * sizeof(neomessage_t));
+	if(polled == NULL || !icsneo_getMessages(device, polled, &count, timeout))
+		return false;
+	for(i = 0; i < count; i++) {
+		if(icsneobinding_filterMatches(filter, &polled[i]))
+			messages[passed++] = polled[i];
+	}
+	*items = (int) passed;
+	return true;
+}
+
+
+/*
+ * Message listeners deliver received messages to managed code in batches. The callback runs on the library's
+ * thread and only has the binding store each message into the batch being filled. A delivery thread hands each
+ * batch to managed code in a single call, so the transition into the runtime happens per batch rather than per
+ * message. A batch is delivered once it holds batchSize messages, or once its first message has waited
+ * maxDelayMicroseconds, so a quiet bus does not hold messages back.
+ *
+ * There are two batches, one being filled while the other is with managed code. If the listener falls so far
+ * behind that the batch being filled is full too, new messages are dropped and counted rather than
+ * blocking the library's thread.
+ *
+ * icsneo_addMessageCallback does not pass a context to the callback, so each listener takes one of
+ * a fixed number of slots, each with its own trampoline.
+ */
+#define ICSNEOBINDING_MAX_LISTENERS 8
+
+/* Each batch holds at least this many bytes, so a full size Ethernet frame always fits */
+#define ICSNEOBINDING_LISTENER_MIN_BATCH_BYTES (64 * 1024)
+
+typedef struct {
+	unsigned char* data;
+	size_t used; /* Bytes of data in use */
+	size_t count; /* Messages stored */
+	void* context; /* Whatever else the binding keeps for this batch */
+} icsneobinding_batch_t;
+
+struct icsneobinding_listener_t;
+
+/* What each binding does differently */
+typedef struct {
+	/* Stores message as batch's next message, called with the listener locked. Returns false if it does not fit. */
+	bool (*store)(struct icsneobinding_listener_t* listener, icsneobinding_batch_t* batch, const neomessage_t* message);
+	/* Hands a batch to managed code, on the delivery thread with the listener unlocked */
+	void (*deliver)(struct icsneobinding_listener_t* listener, icsneobinding_batch_t* batch);
+	/* Optional, called on the delivery thread as it starts and before it ends. attach returns false if it cannot call managed code. */
+	bool (*attach)(struct icsneobinding_listener_t* listener);
+	void (*detach)(struct icsneobinding_listener_t* listener);
+} icsneobinding_listenerOps_t;
+
+struct icsneobinding_listener_t {
+	int slot;
+	int callbackId;
+	neodevice_t device;
+	const icsneobinding_listenerOps_t* ops;
+	void* context; /* The binding's own state, such as the managed callback */
+
+	size_t batchSize;
+	size_t capacity; /* Bytes of data in each batch */
+	uint64_t maxDelayMicroseconds;
+
+	icsneobinding_mutex_t mutex;
+	icsneobinding_cond_t cond;
+	icsneobinding_thread_t thread;
+	icsneobinding_batch_t batches[2];
+	int filling; /* The batch the callback writes into, the other one may be with managed code */
+	icsneobinding_deadline_t deadline; /* When the batch being filled must be delivered, set as its first message arrives */
+	int full; /* The batch being filled has no room left, deliver it now */
+	int state; /* 0 while the delivery thread starts, 1 once it can call managed code, -1 if it cannot */
+	int started; /* The delivery thread is running */
+	int stopping;
+	uint64_t dropped;
+	struct icsneobinding_filter_t* filter; /* Messages which do not pass are not collected, NULL passes everything */
+};
+
+static icsneobinding_mutex_t icsneobinding_listenersMutex = ICSNEOBINDING_MUTEX_INITIALIZER;
+static int icsneobinding_slotsUsed[ICSNEOBINDING_MAX_LISTENERS];
+static struct icsneobinding_listener_t* volatile icsneobinding_listeners[ICSNEOBINDING_MAX_LISTENERS];
+
+/* Runs on the library's thread for every message */
+static void icsneobinding_collect(struct icsneobinding_listener_t* listener, const neomessage_t* message) {
+	icsneobinding_batch_t* batch;
+
+	icsneobinding_lock(&listener->mutex);
+	if(!icsneobinding_filterMatches(listener->filter, message)) {
+		icsneobinding_unlock(&listener->mutex);
+		return;
+	}
+	batch = &listener->batches[listener->filling];
+	if(listener->full || !listener->ops->store(listener, batch, message)) {
+		listener->full = 1;
+		listener->dropped++;
+	} else {
+		batch->count++;
+		if(batch->count == 1)
+			icsneobinding_deadlineAfter(&listener->deadline, listener->maxDelayMicroseconds);
+		if(batch->count >= listener->batchSize)
+			listener->full = 1;
+		/* Wake the delivery thread to wait for the deadline, or to deliver a full batch */
+		if(batch->count == 1 || listener->full)
+			icsneobinding_signal(&listener->cond);
+	}
+	icsneobinding_unlock(&listener->mutex);
+}
+
+#define ICSNEOBINDING_TRAMPOLINE(n) \
+	static void icsneobinding_trampoline##n(neomessage_t message) { \
+		struct icsneobinding_listener_t* listener = icsneobinding_listeners[n]; \
+		if(listener != NULL) \
+			icsneobinding_collect(listener, &message); \
+	}
+
+ICSNEOBINDING_TRAMPOLINE(0)
+ICSNEOBINDING_TRAMPOLINE(1)
+ICSNEOBINDING_TRAMPOLINE(2)
+ICSNEOBINDING_TRAMPOLINE(3)
+ICSNEOBINDING_TRAMPOLINE(4)
+ICSNEOBINDING_TRAMPOLINE(5)
+ICSNEOBINDING_TRAMPOLINE(6)
+ICSNEOBINDING_TRAMPOLINE(7)
+
+static void (* const icsneobinding_trampolines[ICSNEOBINDING_MAX_LISTENERS])(neomessage_t) = {
+	icsneobinding_trampoline0, icsneobinding_trampoline1, icsneobinding_trampoline2, icsneobinding_trampoline3,
+	icsneobinding_trampoline4, icsneobinding_trampoline5, icsneobinding_trampoline6, icsneobinding_trampoline7
+};
+
+static void icsneobinding_deliver(struct icsneobinding_listener_t* listener) {
+	bool attached = listener->ops->attach == NULL || listener->ops->attach(listener);
+	icsneobinding_deadline_t deadline;
+
+	icsneobinding_lock(&listener->mutex);
+	listener->state = attached ? 1 : -1;
+	icsneobinding_signal(&listener->cond);
+	if(!attached) {
+		icsneobinding_unlock(&listener->mutex);
+		return;
+	}
+
+	for(;;) {
+		icsneobinding_batch_t* batch;
+
+		while(!listener->stopping && listener->batches[listener->filling].count == 0)
+			icsneobinding_wait(&listener->cond, &listener->mutex);
+		if(listener->batches[listener->filling].count == 0)
+			break; /* Stopping, and everything has been delivered */
+
+		/* The delay runs from the first message's arrival, not from when the last batch came back from managed code */
+		deadline = listener->deadline;
+		while(!listener->stopping && !listener->full && icsneobinding_waitUntil(&listener->cond, &listener->mutex, &deadline)) {}
+
+		batch = &listener->batches[listener->filling];
+		listener->filling ^= 1;
+		listener->full = 0;
+		icsneobinding_unlock(&listener->mutex);
+
+		listener->ops->deliver(listener, batch);
+
+		icsneobinding_lock(&listener->mutex);
+		batch->used = 0;
+		batch->count = 0;
+	}
+	icsneobinding_unlock(&listener->mutex);
+
+	if(listener->ops->detach != NULL)
+		listener->ops->detach(listener);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI icsneobinding_deliveryThread(LPVOID listener) {
+	icsneobinding_deliver((struct icsneobinding_listener_t*) listener);
+	return 0;
+}
+
+static int icsneobinding_startThread(struct icsneobinding_listener_t* listener) {
+	listener->thread = CreateThread(NULL, 0, icsneobinding_deliveryThread, listener, 0, NULL);
+	return listener->thread != NULL;
+}
+
+static void icsneobinding_joinThread(struct icsneobinding_listener_t* listener) {
+	WaitForSingleObject(listener->thread, INFINITE);
+	CloseHandle(listener->thread);
+}
+#else
+static void* icsneobinding_deliveryThread(void* listener) {
+	icsneobinding_deliver((struct icsneobinding_listener_t*) listener);
+	return NULL;
+}
+
+static int icsneobinding_startThread(struct icsneobinding_listener_t* listener) {
+	return pthread_create(&listener->thread, NULL, icsneobinding_deliveryThread, listener) == 0;
+}
+
+static void icsneobinding_joinThread(struct icsneobinding_listener_t* listener) {
+	pthread_join(listener->thread, NULL);
+}
+#endif
+
+/* Frees the listener and its batch data, after icsneobinding_stopListener and once the binding has released its own state */
+static void icsneobinding_freeListener(struct icsneobinding_listener_t* listener) {
+	int i;
+
+	for(i = 0; i < 2; i++)
+		free(listener->batches[i].data);
+	icsneobinding_freeFilter(listener->filter);
+	icsneobinding_condDestroy(&listener->cond);
+	icsneobinding_mutexDestroy(&listener->mutex);
+
+	if(listener->slot >= 0) {
+		icsneobinding_lock(&icsneobinding_listenersMutex);
+		icsneobinding_slotsUsed[listener->slot] = 0;
+		icsneobinding_unlock(&icsneobinding_listenersMutex);
+	}
+	free(listener);
+}
+
+/*
+ * Creates a listener which is not started yet, with two batches of capacity bytes, at least ICSNEOBINDING_LISTENER_MIN_BATCH_BYTES.
+ * filter is copied, NULL passes everything. The binding sets up each batch's context before icsneobinding_startListener.
+ * Returns NULL on failure.
+ */
+static struct icsneobinding_listener_t* icsneobinding_newListener(const neodevice_t* device, const icsneobinding_listenerOps_t* ops, void* context,
+	size_t batchSize, size_t capacity, uint64_t maxDelayMicroseconds, const struct icsneobinding_filter_t* filter) {
+	struct icsneobinding_listener_t* listener;
+	int i;
+
+	if(device == NULL || batchSize == 0)
+		return NULL;
+
+	listener = (struct icsneobinding_listener_t*) calloc(1, sizeof(struct icsneobinding_listener_t));
+	if(listener == NULL)
+		return NULL;
+	listener->slot = -1;
+	listener->device = *device;
+	listener->ops = ops;
+	listener->context = context;
+	listener->batchSize = batchSize;
+	listener->maxDelayMicroseconds = maxDelayMicroseconds;
+	listener->capacity = capacity < ICSNEOBINDING_LISTENER_MIN_BATCH_BYTES ? ICSNEOBINDING_LISTENER_MIN_BATCH_BYTES : capacity;
+	icsneobinding_mutexInit(&listener->mutex);
+	icsneobinding_condInit(&listener->cond);
+
+	listener->filter = filter == NULL ? NULL : icsneobinding_duplicateFilter(filter);
+	if(filter != NULL && listener->filter == NULL) {
+		icsneobinding_freeListener(listener);
+		return NULL;
+	}
+
+	for(i = 0; i < 2; i++) {
+		listener->batches[i].data = (unsigned char*) malloc(listener->capacity);
+		if(listener->batches[i].data == NULL) {
+			icsneobinding_freeListener(listener);
+			return NULL;
+		}
+	}
+	return listener;
+}
+
+/* Stops the delivery thread, once it has delivered what is left. Does nothing if it is not running. */
+static void icsneobinding_stopListener(struct icsneobinding_listener_t* listener) {
+	if(!listener->started)
+		return;
+	icsneobinding_lock(&listener->mutex);
+	listener->stopping = 1;
+	icsneobinding_signal(&listener->cond);
+	icsneobinding_unlock(&listener->mutex);
+	icsneobinding_joinThread(listener);
+	listener->started = 0;
+}
+
+/*
+ * Takes a slot, starts the delivery thread and, once it can call managed code, registers the callback.
+ * Returns false on failure, including when all ICSNEOBINDING_MAX_LISTENERS listeners are in use, with the thread stopped again.
+ */
+static bool icsneobinding_startListener(struct icsneobinding_listener_t* listener) {
+	int i;
+
+	icsneobinding_lock(&icsneobinding_listenersMutex);
+	for(i = 0; i < ICSNEOBINDING_MAX_LISTENERS; i++) {
+		if(!icsneobinding_slotsUsed[i]) {
+			icsneobinding_slotsUsed[i] = 1;
+			listener->slot = i;
+			break;
+		}
+	}
+	icsneobinding_unlock(&icsneobinding_listenersMutex);
+	if(listener->slot < 0 || !icsneobinding_startThread(listener))
+		return false;
+	listener->started = 1;
+
+	/* Only register the callback once the delivery thread can deliver */
+	icsneobinding_lock(&listener->mutex);
+	while(listener->state == 0)
+		icsneobinding_wait(&listener->cond, &listener->mutex);
+	icsneobinding_unlock(&listener->mutex);
+	if(listener->state < 0) {
+		icsneobinding_stopListener(listener);
+		return false;
+	}
+
+	icsneobinding_listeners[listener->slot] = listener;
+	listener->callbackId = icsneo_addMessageCallback(&listener->device, icsneobinding_trampolines[listener->slot], NULL);
+	if(listener->callbackId < 0) {
+		icsneobinding_listeners[listener->slot] = NULL;
+		icsneobinding_stopListener(listener);
+		return false;
+	}
+	return true;
+}
+
+/*
+ * Stops the callbacks and delivers the messages already collected, for the binding to free the listener after.
+ * Must not be called from the delivery thread. Returns false, keeping the listener running, if the callback could not be removed.
+ */
+static bool icsneobinding_removeListener(struct icsneobinding_listener_t* listener) {
+	if(!icsneo_removeMessageCallback(&listener->device, listener->callbackId))
+		return false;
+	icsneobinding_listeners[listener->slot] = NULL;
+	icsneobinding_stopListener(listener);
+	return true;
+}
+
+/* The number of messages dropped because the listener could not keep up */
+static uint64_t icsneobinding_getMessageListenerDropped(struct icsneobinding_listener_t* listener) {
+	uint64_t dropped;
+	if(listener == NULL)
+		return 0;
+	icsneobinding_lock(&listener->mutex);
+	dropped = listener->dropped;
+	icsneobinding_unlock(&listener->mutex);
+	return dropped;
+}
+
+#endif
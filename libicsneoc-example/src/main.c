@@ -9,11 +9,15 @@
 
 // Include icsneo/icsneoc.h to access library functions
 #include "icsneo/icsneoc.h"
+#include "neoarena.h"
+#include "neoregistry.h"
 
 size_t msgLimit = 50000;
-size_t numDevices = 0;
-neodevice_t devices[99];
+// Every device found so far, by serial number, updated by each scan
+neoregistry_t registry;
 const neodevice_t* selectedDevice = NULL;
+// Polled into by 'F', and reused every time rather than allocated per poll
+neoarena_t messageArena;
 
 /**
  * \brief Prints all current known devices to output in the following format:
@@ -23,27 +27,27 @@ const neodevice_t* selectedDevice = NULL;
  * Description for device num not available!
  */
 void printAllDevices() {
-	if(numDevices == 0) {
+	if(registry.count == 0) {
 		printf("No devices found! Please scan for new devices.\n");
 	}
-	for(int i = 0; i < numDevices; i++) {
+	for(int i = 0; i < registry.count; i++) {
 		char productDescription[ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION];
 		size_t descriptionLength = ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION;
 
 		// Updates productDescription and descriptionLength for each device
-		if(icsneo_describeDevice(devices + i, productDescription, &descriptionLength)) {
+		if(icsneo_describeDevice(registry.devices + i, productDescription, &descriptionLength)) {
 			printf("[%d] %s\tConnected: ", i + 1, productDescription);
-			if(icsneo_isOpen(devices + i)) {
+			if(icsneo_isOpen(registry.devices + i)) {
 				printf("Yes\t");
 			} else printf("No\t");
 
 			printf("Online: ");
-			if(icsneo_isOnline(devices + i)) {
+			if(icsneo_isOnline(registry.devices + i)) {
 				printf("Yes\t");
 			} else printf("No\t");
 
 			printf("Msg Polling: ");
-			if(icsneo_isMessagePollingEnabled(devices + i)) {
+			if(icsneo_isMessagePollingEnabled(registry.devices + i)) {
 				printf("On\n");
 			} else printf("Off\n");
 
@@ -53,20 +57,26 @@ void printAllDevices() {
 	}
 }
 
+void printAddedDevice(const neodevice_t* device, void* user) {
+	printf("Found %s\n", device->serial);
+}
+
+void printRemovedDevice(const neodevice_t* device, void* user) {
+	printf("Lost %s\n", device->serial);
+}
+
 /**
- * \brief Scans for any new devices, adding them to devices and updating numDevices accordingly
- * A total of 99 devices may be stored at once
+ * \brief Scans for devices, adding new ones to the registry and removing ones which have gone
+ * \param[out] removed the number of devices removed
+ * \returns the number of new devices
+ *
+ * Devices already known keep their place, and open devices are kept even if they are not found
  */
-size_t scanNewDevices() {
-	neodevice_t newDevices[99];
-	size_t numNewDevices = 99;
-	icsneo_findAllDevices(newDevices, &numNewDevices);
-
-	for(int i = 0; i < numNewDevices; ++i) {
-		devices[numDevices + i] = newDevices[i];
-	}
-	numDevices += numNewDevices;
-	return numNewDevices;
+size_t scanNewDevices(size_t* removed) {
+	size_t added = 0;
+	if(!neoregistry_rescan(&registry, printAddedDevice, printRemovedDevice, NULL, &added, removed))
+		printf("Could not allocate memory for the devices!\n");
+	return added;
 }
 
 // Prints the main menu options to output
@@ -182,27 +192,34 @@ char getCharInput(int numArgs, ...) {
 
 /**
  * \brief Prompts the user to select a device from the list of currently known devices
- * \returns a pointer to the device in devices[] selected by the user
- * Requires an input from 1-9, so a maximum of 9 devices are supported
+ * \returns a pointer to the device in registry.devices selected by the user
+ * Requires a number from 1 to the number of devices
  */
 const neodevice_t* selectDevice() {
 	printf("Please select a device:\n");
 	printAllDevices();
 	printf("\n");
 
-	int selectedDeviceNum = 10;
-
-	while(selectedDeviceNum > numDevices) {
-		char deviceSelection = getCharInput(9, '1', '2', '3', '4', '5', '6', '7', '8', '9');
-		selectedDeviceNum = deviceSelection - '0';
-		if(selectedDeviceNum > numDevices) {
+	char input[99];
+	unsigned long selectedDeviceNum = 0;
+
+	while(selectedDeviceNum == 0) {
+		if(fgets(input, 99, stdin) == NULL)
+			continue;
+		char* end;
+		selectedDeviceNum = strtoul(input, &end, 10);
+		if(end == input || (*end != '\n' && *end != '\0')) {
+			printf("Input did not match expected options. Please try again.\n");
+			selectedDeviceNum = 0;
+		} else if(selectedDeviceNum == 0 || selectedDeviceNum > registry.count) {
 			printf("Selected device out of range!\n");
+			selectedDeviceNum = 0;
 		}
 	}
 
 	printf("\n");
 
-	return devices + selectedDeviceNum - 1;
+	return registry.devices + selectedDeviceNum - 1;
 }
 
 int main() {
@@ -228,6 +245,14 @@ int main() {
 	neoversion_t ver = icsneo_getVersion();
 	printf("ICS icsneoc.dll version %u.%u.%u\n\n", ver.major, ver.minor, ver.patch);
 
+	neoregistry_init(&registry);
+
+	if(!neoarena_init(&messageArena, msgLimit, 0)) {
+		printf("Could not allocate memory for messages!\n");
+		icsneo_close();
+		return 4;
+	}
+
 	while(true) {
 		printMainMenu();
 		printf("\n");
@@ -244,12 +269,18 @@ int main() {
 		case 'B':
 		case 'b':
 		{
-			size_t numNewDevices = scanNewDevices();
+			size_t numRemovedDevices = 0;
+			size_t numNewDevices = scanNewDevices(&numRemovedDevices);
 			if(numNewDevices == 1) {
 				printf("1 new device found!\n");
 			} else {
 				printf("%d new devices found!\n", (int) numNewDevices);
 			}
+			if(numRemovedDevices == 1) {
+				printf("1 device removed!\n");
+			} else if(numRemovedDevices != 0) {
+				printf("%d devices removed!\n", (int) numRemovedDevices);
+			}
 			printAllDevices();
 			printf("\n");
 			break;
@@ -259,7 +290,7 @@ int main() {
 		case 'c':
 		{
 			// Select a device and get its description
-			if(numDevices == 0) {
+			if(registry.count == 0) {
 				printf("No devices found! Please scan for new devices.\n\n");
 				break;
 			}
@@ -290,18 +321,10 @@ int main() {
 			case '2':
 				// Attempt to close the device
 				if(icsneo_closeDevice(selectedDevice)) {
-					numDevices--;
 					printf("Successfully closed %s!\n\n", productDescription);
 
-					// Shifts everything after the removed device 1 index to the left
-					bool startResizing = false;
-					for(int i = 0; i < numDevices; ++i) {
-						if(selectedDevice == devices + i)
-							startResizing = true;
-						if(startResizing)
-							devices[i] = devices[i + 1];
-					}
-
+					// The device will be found again by the next scan
+					neoregistry_remove(&registry, selectedDevice);
 					selectedDevice = NULL;
 				} else {
 					printf("Failed to close %s!\n\n", productDescription);
@@ -320,7 +343,7 @@ int main() {
 		case 'd':
 		{
 			// Select a device and get its description
-			if(numDevices == 0) {
+			if(registry.count == 0) {
 				printf("No devices found! Please scan for new devices.\n\n");
 				break;
 			}
@@ -368,7 +391,7 @@ int main() {
 		case 'e':
 		{
 			// Select a device and get its description
-			if(numDevices == 0) {
+			if(registry.count == 0) {
 				printf("No devices found! Please scan for new devices.\n\n");
 				break;
 			}
@@ -427,7 +450,7 @@ int main() {
 		case 'f':
 		{
 			// Select a device and get its description
-			if(numDevices == 0) {
+			if(registry.count == 0) {
 				printf("No devices found! Please scan for new devices.\n\n");
 				break;
 			}
@@ -438,20 +461,18 @@ int main() {
 			size_t descriptionLength = ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION;
 			icsneo_describeDevice(selectedDevice, productDescription, &descriptionLength);
 
-			// Prepare the array of neomessage_t ptrs for reading in the messages
-			neomessage_t* msgs = (neomessage_t*) malloc(msgLimit * sizeof(neomessage_t*));
+			// Empty the arena from the last poll, keeping its memory
+			neoarena_reset(&messageArena);
 
-			// Get messages
-			size_t msgCount = msgLimit;
-
-			// Attempt to get messages
-			if(!icsneo_getMessages(selectedDevice, msgs, &msgCount, (uint64_t) 0)) {
+			// Attempt to get messages, their payloads are copied into the arena and stay valid until it is reset
+			size_t msgCount = 0;
+			if(!neoarena_getMessages(&messageArena, selectedDevice, (uint64_t) 0, &msgCount)) {
 				printf("Failed to get messages for %s!\n\n", productDescription);
 				printLastError();
-				free(msgs);
 				printf("\n");
 				break;
 			}
+			neomessage_t* msgs = messageArena.messages;
 
 			if(msgCount == 1) {
 				printf("1 message received from %s!\n", productDescription);
@@ -480,8 +501,6 @@ int main() {
 				}
 			}
 			printf("\n");
-
-			free(msgs);
 		}
 
 		break;
@@ -490,7 +509,7 @@ int main() {
 		case 'g':
 		{
 			// Select a device and get its description
-			if(numDevices == 0) {
+			if(registry.count == 0) {
 				printf("No devices found! Please scan for new devices.\n\n");
 				break;
 			}
@@ -544,7 +563,7 @@ int main() {
 		case 'i':
 		{
 			// Select a device and get its description
-			if(numDevices == 0) {
+			if(registry.count == 0) {
 				printf("No devices found! Please scan for new devices.\n\n");
 				break;
 			}
@@ -570,7 +589,7 @@ int main() {
 		case 'j':
 		{
 			// Select a device and get its description
-			if(numDevices == 0) {
+			if(registry.count == 0) {
 				printf("No devices found! Please scan for new devices.\n\n");
 				break;
 			}
@@ -595,6 +614,8 @@ int main() {
 		case 'X':
 		case 'x':
 			printf("Exiting program\n");
+			neoarena_free(&messageArena);
+			neoregistry_free(&registry);
 			return !icsneo_close();
 		default:
 			printf("Unexpected input, exiting!\n");
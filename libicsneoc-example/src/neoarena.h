@@ -0,0 +1,165 @@
+#ifndef NEOARENA_H
+#define NEOARENA_H
+
+/**
+ * A caller-owned arena for polling messages with icsneo_getMessages.
+ *
+ * The arena owns an array of neomessage_t, sized once when it is initialized, and a chain of blocks for the payloads.
+ * neoarena_getMessages polls into the free end of the array and copies each payload into the blocks, repointing the
+ * message at the copy. Messages and their payloads then stay valid until neoarena_reset, rather than until the next poll
+ * of the device, and belong to the arena rather than to icsneoc.
+ *
+ * neoarena_reset empties the arena but keeps its memory, so once it has grown to the largest batch polled,
+ * polling allocates nothing. Blocks are never moved or freed before neoarena_free, so earlier payloads are never invalidated
+ * by later ones. An arena may be used by one thread at a time.
+ *
+ * Include icsneo/icsneoc.h, with ICSNEOC_DYNAMICLOAD defined if it is used, before this header.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "icsneo/icsneoc.h"
+
+// Payload blocks are at least this big, unless a different size is passed to neoarena_init
+#define NEOARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+typedef struct neoarena_block_t {
+	struct neoarena_block_t* next;
+	size_t capacity;
+	size_t used;
+	uint8_t data[];
+} neoarena_block_t;
+
+typedef struct {
+	neomessage_t* messages; // The messages polled since the last reset, messages[0] to messages[count - 1]
+	size_t count;
+	size_t capacity;
+	size_t blockSize;
+	neoarena_block_t* blocks; // Every block, in the order they are filled
+	neoarena_block_t* current; // The block payloads are being copied to, the ones after it are empty
+} neoarena_t;
+
+/**
+ * \brief Frees the arena's messages and payload blocks, leaving it empty. It can be initialized again afterwards.
+ */
+static inline void neoarena_free(neoarena_t* arena) {
+	neoarena_block_t* block = arena->blocks;
+	while(block != NULL) {
+		neoarena_block_t* next = block->next;
+		free(block);
+		block = next;
+	}
+	free(arena->messages);
+	memset(arena, 0, sizeof(*arena));
+}
+
+/**
+ * \brief Prepares an arena for use
+ * \param[in] messageCapacity the most messages the arena holds between resets
+ * \param[in] blockSize the size of each payload block, or 0 for NEOARENA_DEFAULT_BLOCK_SIZE. Payloads larger than this get a block of their own.
+ * \returns false if memory for the messages could not be allocated
+ *
+ * No payload block is allocated until the first payload is copied.
+ */
+static inline bool neoarena_init(neoarena_t* arena, size_t messageCapacity, size_t blockSize) {
+	memset(arena, 0, sizeof(*arena));
+	if(messageCapacity == 0)
+		return false;
+	arena->messages = (neomessage_t*) malloc(messageCapacity * sizeof(neomessage_t));
+	if(arena->messages == NULL)
+		return false;
+	arena->capacity = messageCapacity;
+	arena->blockSize = blockSize == 0 ? NEOARENA_DEFAULT_BLOCK_SIZE : blockSize;
+	return true;
+}
+
+/**
+ * \brief Empties the arena, invalidating every message and payload in it, but keeps its memory to be reused
+ */
+static inline void neoarena_reset(neoarena_t* arena) {
+	for(neoarena_block_t* block = arena->blocks; block != NULL; block = block->next)
+		block->used = 0;
+	arena->current = arena->blocks;
+	arena->count = 0;
+}
+
+/**
+ * \brief Reserves size bytes in the payload blocks, allocating a block only if none of the remaining ones has room
+ * \returns NULL if a block could not be allocated
+ */
+static inline uint8_t* neoarena_allocate(neoarena_t* arena, size_t size) {
+	neoarena_block_t* block = arena->current;
+	neoarena_block_t* last = NULL;
+
+	// The blocks after current are empty, skip any too small for this payload
+	while(block != NULL && block->capacity - block->used < size) {
+		last = block;
+		block = block->next;
+	}
+
+	if(block == NULL) {
+		size_t capacity = size > arena->blockSize ? size : arena->blockSize;
+		block = (neoarena_block_t*) malloc(sizeof(neoarena_block_t) + capacity);
+		if(block == NULL)
+			return NULL;
+		block->next = NULL;
+		block->capacity = capacity;
+		block->used = 0;
+		if(last != NULL)
+			last->next = block;
+		else
+			arena->blocks = block;
+	}
+
+	arena->current = block;
+	block->used += size;
+	return block->data + block->used - size;
+}
+
+/**
+ * \brief Polls messages from a device into the free end of the arena, copying their payloads into it
+ * \param[in] device the device to poll
+ * \param[in] timeout how long to wait for messages, in milliseconds, as for icsneo_getMessages
+ * \param[out] received if not NULL, the number of messages added
+ * \returns false if icsneo_getMessages failed, or a payload could not be copied. In the latter case the messages
+ * before it are kept, and the rest are lost.
+ *
+ * Polls at most as many messages as the arena has room left for, reset it to make room.
+ * If it is already full, no messages are polled and true is returned.
+ */
+static inline bool neoarena_getMessages(neoarena_t* arena, const neodevice_t* device, uint64_t timeout, size_t* received) {
+	neomessage_t* start = arena->messages + arena->count;
+	size_t count = arena->capacity - arena->count;
+
+	if(received != NULL)
+		*received = 0;
+	if(count == 0)
+		return true;
+	if(!icsneo_getMessages(device, start, &count, timeout))
+		return false;
+
+	for(size_t i = 0; i < count; i++) {
+		if(start[i].length == 0 || start[i].data == NULL)
+			continue;
+		uint8_t* copy = neoarena_allocate(arena, start[i].length);
+		if(copy == NULL) {
+			count = i;
+			arena->count += count;
+			if(received != NULL)
+				*received = count;
+			return false;
+		}
+		memcpy(copy, start[i].data, start[i].length);
+		start[i].data = copy;
+	}
+
+	arena->count += count;
+	if(received != NULL)
+		*received = count;
+	return true;
+}
+
+#endif
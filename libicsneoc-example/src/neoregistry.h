@@ -0,0 +1,255 @@
+#ifndef NEOREGISTRY_H
+#define NEOREGISTRY_H
+
+/**
+ * A registry of the devices icsneo_findAllDevices has found, keyed by serial number.
+ *
+ * neoregistry_rescan finds every device again and compares the result with the devices already known, through a hash
+ * table of their serial numbers, so a rescan costs O(n) however many devices there are. Devices found again keep their
+ * place, new ones are added at the end and ones which have gone are removed, and each is reported once. A device which is
+ * open keeps its neodevice_t, and its place, even if a rescan does not return it.
+ *
+ * The devices are kept in one array, devices[0] to devices[count - 1]. Pointers into it are valid until the next
+ * neoregistry_rescan or neoregistry_remove. A registry may be used by one thread at a time.
+ *
+ * Include icsneo/icsneoc.h, with ICSNEOC_DYNAMICLOAD defined if it is used, before this header.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "icsneo/icsneoc.h"
+
+// The length of neodevice_t.serial
+#define NEOREGISTRY_SERIAL_LENGTH 7
+// The most devices a rescan will look for
+#define NEOREGISTRY_MAX_DEVICES 65536
+
+// Called for each device added or removed by a rescan. The device is only valid for the duration of the call.
+typedef void (*neoregistry_callback_t)(const neodevice_t* device, void* user);
+
+typedef struct {
+	neodevice_t* devices; // The known devices, in the order they were found
+	size_t count;
+	size_t capacity;
+	bool* seen; // Whether each device was found by the rescan in progress
+	int32_t* table; // Indices into devices by serial number, open addressed, -1 where empty
+	size_t tableSize; // A power of two, at least twice count
+	neodevice_t* found; // Where icsneo_findAllDevices writes, kept between rescans
+	size_t foundCapacity;
+} neoregistry_t;
+
+/**
+ * \brief Prepares an empty registry. It allocates nothing until the first rescan.
+ */
+static inline void neoregistry_init(neoregistry_t* registry) {
+	memset(registry, 0, sizeof(*registry));
+}
+
+/**
+ * \brief Frees everything the registry holds, leaving it empty. The devices themselves are not closed.
+ */
+static inline void neoregistry_free(neoregistry_t* registry) {
+	free(registry->devices);
+	free(registry->seen);
+	free(registry->table);
+	free(registry->found);
+	memset(registry, 0, sizeof(*registry));
+}
+
+// FNV-1a over the serial number, up to its terminator
+static inline uint32_t neoregistry_hash(const char* serial) {
+	uint32_t hash = 2166136261u;
+	for(size_t i = 0; i < NEOREGISTRY_SERIAL_LENGTH && serial[i] != '\0'; i++) {
+		hash ^= (uint8_t) serial[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+// The index in devices of the device with this serial number, or -1
+static inline int32_t neoregistry_lookup(const neoregistry_t* registry, const char* serial) {
+	if(registry->tableSize == 0)
+		return -1;
+	size_t mask = registry->tableSize - 1;
+	for(size_t slot = neoregistry_hash(serial) & mask; registry->table[slot] != -1; slot = (slot + 1) & mask) {
+		if(strncmp(registry->devices[registry->table[slot]].serial, serial, NEOREGISTRY_SERIAL_LENGTH) == 0)
+			return registry->table[slot];
+	}
+	return -1;
+}
+
+static inline void neoregistry_insert(neoregistry_t* registry, int32_t index) {
+	size_t mask = registry->tableSize - 1;
+	size_t slot = neoregistry_hash(registry->devices[index].serial) & mask;
+	while(registry->table[slot] != -1)
+		slot = (slot + 1) & mask;
+	registry->table[slot] = index;
+}
+
+// Rebuilds the hash table from devices, growing it to keep it at most half full
+static inline bool neoregistry_rebuild(neoregistry_t* registry) {
+	size_t size = registry->tableSize == 0 ? 16 : registry->tableSize;
+	while(size < registry->count * 2)
+		size *= 2;
+	if(size != registry->tableSize) {
+		int32_t* table = (int32_t*) realloc(registry->table, size * sizeof(int32_t));
+		if(table == NULL)
+			return false;
+		registry->table = table;
+		registry->tableSize = size;
+	}
+	memset(registry->table, 0xFF, registry->tableSize * sizeof(int32_t));
+	for(size_t i = 0; i < registry->count; i++)
+		neoregistry_insert(registry, (int32_t) i);
+	return true;
+}
+
+// Makes room in devices and seen for one more device
+static inline bool neoregistry_reserve(neoregistry_t* registry) {
+	if(registry->count < registry->capacity)
+		return true;
+	size_t capacity = registry->capacity == 0 ? 16 : registry->capacity * 2;
+	neodevice_t* devices = (neodevice_t*) realloc(registry->devices, capacity * sizeof(neodevice_t));
+	if(devices == NULL)
+		return false;
+	registry->devices = devices;
+	bool* seen = (bool*) realloc(registry->seen, capacity * sizeof(bool));
+	if(seen == NULL)
+		return false;
+	registry->seen = seen;
+	registry->capacity = capacity;
+	return true;
+}
+
+/**
+ * \brief Finds a known device by its serial number
+ * \returns the device, or NULL if it is not in the registry
+ */
+static inline const neodevice_t* neoregistry_find(const neoregistry_t* registry, const char* serial) {
+	int32_t index = neoregistry_lookup(registry, serial);
+	return index < 0 ? NULL : registry->devices + index;
+}
+
+/**
+ * \brief Removes a device from the registry, such as once it has been closed. The devices after it move down one place.
+ * \param[in] device a pointer into registry->devices
+ * \returns false if the device is not in the registry
+ */
+static inline bool neoregistry_remove(neoregistry_t* registry, const neodevice_t* device) {
+	if(device < registry->devices || device >= registry->devices + registry->count)
+		return false;
+	size_t index = (size_t) (device - registry->devices);
+	memmove(registry->devices + index, registry->devices + index + 1, (registry->count - index - 1) * sizeof(neodevice_t));
+	registry->count--;
+	return neoregistry_rebuild(registry);
+}
+
+/**
+ * \brief Finds every device again, and updates the registry with the devices which were added or removed since the last rescan
+ * \param[in] onAdded if not NULL, called for each new device, once it is in the registry
+ * \param[in] onRemoved if not NULL, called for each device which has gone, before it is removed
+ * \param[in] user passed to the callbacks
+ * \param[out] added if not NULL, the number of new devices
+ * \param[out] removed if not NULL, the number of devices removed
+ * \returns false if memory could not be allocated, in which case the registry holds the devices known before the rescan,
+ * and any it had added by then
+ *
+ * A device which is open is kept, with its neodevice_t, even if icsneo_findAllDevices does not return it.
+ * A device found again which is not open takes the neodevice_t from this rescan.
+ */
+static inline bool neoregistry_rescan(neoregistry_t* registry, neoregistry_callback_t onAdded, neoregistry_callback_t onRemoved,
+	void* user, size_t* added, size_t* removed) {
+	size_t numFound;
+	size_t numAdded = 0;
+	size_t numRemoved = 0;
+	size_t previousCount = registry->count;
+
+	if(added != NULL)
+		*added = 0;
+	if(removed != NULL)
+		*removed = 0;
+
+	// Find every device, growing the buffer while it comes back full
+	if(registry->foundCapacity == 0) {
+		registry->found = (neodevice_t*) malloc(64 * sizeof(neodevice_t));
+		if(registry->found == NULL)
+			return false;
+		registry->foundCapacity = 64;
+	}
+	while(true) {
+		numFound = registry->foundCapacity;
+		icsneo_findAllDevices(registry->found, &numFound);
+		if(numFound < registry->foundCapacity || registry->foundCapacity >= NEOREGISTRY_MAX_DEVICES)
+			break;
+		neodevice_t* found = (neodevice_t*) realloc(registry->found, registry->foundCapacity * 2 * sizeof(neodevice_t));
+		if(found == NULL)
+			return false;
+		registry->found = found;
+		registry->foundCapacity *= 2;
+	}
+
+	if(registry->tableSize == 0 && !neoregistry_rebuild(registry))
+		return false;
+	if(registry->count != 0)
+		memset(registry->seen, 0, registry->count * sizeof(bool));
+
+	// Match what was found against the known devices, adding the new ones at the end
+	for(size_t i = 0; i < numFound; i++) {
+		const neodevice_t* device = registry->found + i;
+		int32_t index = neoregistry_lookup(registry, device->serial);
+		if(index >= 0) {
+			if(registry->seen[index])
+				continue;
+			registry->seen[index] = true;
+			if(!icsneo_isOpen(registry->devices + index))
+				registry->devices[index] = *device;
+			continue;
+		}
+
+		if(!neoregistry_reserve(registry))
+			return false;
+		index = (int32_t) registry->count++;
+		registry->devices[index] = *device;
+		registry->seen[index] = true;
+		numAdded++;
+		if(registry->count * 2 > registry->tableSize) {
+			if(!neoregistry_rebuild(registry))
+				return false;
+		} else {
+			neoregistry_insert(registry, index);
+		}
+	}
+
+	// Drop the devices which were not found, keeping the ones which are open, and keeping the order
+	size_t kept = 0;
+	for(size_t i = 0; i < registry->count; i++) {
+		if(i < previousCount && !registry->seen[i] && !icsneo_isOpen(registry->devices + i)) {
+			if(onRemoved != NULL)
+				onRemoved(registry->devices + i, user);
+			numRemoved++;
+			continue;
+		}
+		if(kept != i)
+			registry->devices[kept] = registry->devices[i];
+		kept++;
+	}
+	registry->count = kept;
+	if(numRemoved != 0 && !neoregistry_rebuild(registry))
+		return false;
+
+	if(onAdded != NULL) {
+		for(size_t i = registry->count - numAdded; i < registry->count; i++)
+			onAdded(registry->devices + i, user);
+	}
+
+	if(added != NULL)
+		*added = numAdded;
+	if(removed != NULL)
+		*removed = numRemoved;
+	return true;
+}
+
+#endif
@@ -0,0 +1,358 @@
+#ifndef __DEVICEBRINGUP_H_
+#define __DEVICEBRINGUP_H_
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "icsneo/icsneocpp.h"
+
+/**
+ * \brief Brings a set of devices up concurrently: opens them, configures them and takes them online
+ *
+ * Devices are taken from a shared queue by a bounded pool of worker threads, each device going through its phases on one
+ * worker. Each phase is timed, and each device has a timeout which runs from when a worker picks it up.
+ *
+ * A device which has used up its timeout between phases is closed and reported as timed out. A device stuck inside a phase,
+ * such as an open() which does not return, cannot be interrupted, so it is reported as timed out and abandoned instead.
+ * A new worker takes the stuck one's place, so the devices still queued are not held up, and the stuck worker closes the
+ * device and exits once the call returns. run() returns once every device is online, has failed or has timed out.
+ *
+ * An abandoned worker may still be inside libicsneo after run() returns, so the workers are joined rather than detached.
+ * waitForWorkers() waits for them for a bounded time, and the destructor waits for as long as they take, so nothing
+ * outlives the object and libicsneo is not torn down under a worker at exit.
+ */
+class DeviceBringUp {
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	enum class Phase { Open, Configure, Online };
+	static const size_t phaseCount = 3;
+
+	enum class Outcome { NotStarted, Online, Failed, TimedOut };
+
+	/**
+	 * Configures an open device, returning false if it failed. It runs on a worker thread, concurrently with the callback
+	 * for other devices. Settings applied here should be applied with apply(true) unless they are meant to be written
+	 * to every device's EEPROM.
+	 */
+	typedef std::function<bool(icsneo::Device& device)> Configurator;
+
+	struct Result {
+		std::shared_ptr<icsneo::Device> device;
+		Outcome outcome = Outcome::NotStarted;
+		Phase phase = Phase::Open; // The last phase started, the one which failed or timed out if the device is not online
+		std::string error;
+		std::array<Clock::duration, phaseCount> phaseTime{}; // Only the phases which finished are set
+		Clock::duration total{};
+	};
+
+	/**
+	 * \param[in] threads the most devices brought up at once, not counting any abandoned in a phase which did not return
+	 * \param[in] deviceTimeout how long each device may take from being picked up until it is online
+	 * \param[in] configure called between opening the device and taking it online, may be empty
+	 */
+	DeviceBringUp(size_t threads, std::chrono::milliseconds deviceTimeout, Configurator configure)
+		: threads(std::max<size_t>(threads, 1)), deviceTimeout(deviceTimeout), configure(std::move(configure)) {}
+
+	DeviceBringUp(const DeviceBringUp&) = delete;
+	DeviceBringUp& operator=(const DeviceBringUp&) = delete;
+
+	~DeviceBringUp() {
+		waitForWorkers();
+	}
+
+	/**
+	 * \brief Waits for every worker from every run() to exit, including those abandoned in a phase which has not returned
+	 * \param[in] timeout the longest to wait
+	 * \returns false if a worker was still running when the timeout passed, the workers are only joined once they have all exited
+	 */
+	bool waitForWorkers(std::chrono::milliseconds timeout) {
+		const Clock::time_point deadline = Clock::now() + timeout;
+		return waitForWorkers(&deadline);
+	}
+
+	// Waits for as long as the workers take
+	void waitForWorkers() {
+		waitForWorkers(nullptr);
+	}
+
+	/**
+	 * \brief Brings up every device, blocking until each one is online, has failed or has timed out
+	 * \returns the result for each device, in the order they were given
+	 */
+	std::vector<Result> run(const std::vector<std::shared_ptr<icsneo::Device>>& devices) {
+		auto shared = std::make_shared<Shared>();
+		shared->deviceTimeout = deviceTimeout;
+		shared->configure = configure;
+		shared->results.resize(devices.size());
+		shared->states.resize(devices.size(), State::Queued);
+		shared->started.resize(devices.size());
+		for(size_t i = 0; i < devices.size(); i++)
+			shared->results[i].device = devices[i];
+
+		// The shared state lives until the last worker exits, which may be after run() returns
+		runs.push_back(shared);
+		std::unique_lock<std::mutex> lock(shared->mutex);
+		for(size_t i = 0; i < std::min(threads, devices.size()); i++)
+			Spawn(shared);
+
+		while(true) {
+			const Clock::time_point now = Clock::now();
+			Clock::time_point nextDeadline = Clock::time_point::max();
+			bool pending = false;
+			for(size_t i = 0; i < devices.size(); i++) {
+				if(shared->states[i] == State::Queued) {
+					pending = true;
+				} else if(shared->states[i] == State::Running) {
+					const Clock::time_point deadline = shared->started[i] + deviceTimeout;
+					if(now >= deadline) {
+						Abandon(shared, i, now);
+						if(shared->next < shared->results.size())
+							Spawn(shared); // Takes the stuck worker's place
+					} else {
+						pending = true;
+						nextDeadline = std::min(nextDeadline, deadline);
+					}
+				}
+			}
+			if(!pending)
+				break;
+			if(nextDeadline == Clock::time_point::max())
+				shared->changed.wait(lock);
+			else
+				shared->changed.wait_until(lock, nextDeadline);
+		}
+		return shared->results;
+	}
+
+	static const char* PhaseName(Phase phase) {
+		switch(phase) {
+			case Phase::Open: return "open";
+			case Phase::Configure: return "configure";
+			case Phase::Online: return "online";
+		}
+		return "unknown";
+	}
+
+	static const char* OutcomeName(Outcome outcome) {
+		switch(outcome) {
+			case Outcome::NotStarted: return "not started";
+			case Outcome::Online: return "online";
+			case Outcome::Failed: return "failed";
+			case Outcome::TimedOut: return "timed out";
+		}
+		return "unknown";
+	}
+
+	/**
+	 * \brief Prints each device's outcome and phase times, then the minimum, mean and maximum time of each phase
+	 * \param[in] os the stream to print to
+	 * \param[in] results from run()
+	 * \param[in] wallTime how long run() took, which is compared with how long the devices would have taken one at a time
+	 */
+	static void PrintReport(std::ostream& os, const std::vector<Result>& results, Clock::duration wallTime) {
+		os << std::left << std::setw(10) << "Serial" << std::setw(13) << "Outcome";
+		for(size_t p = 0; p < phaseCount; p++)
+			os << std::right << std::setw(12) << PhaseName(Phase(p));
+		os << std::setw(12) << "total" << "  (ms)\n";
+
+		Clock::duration serialTime{};
+		for(const auto& result : results) {
+			os << std::left << std::setw(10) << result.device->getSerial() << std::setw(13) << OutcomeName(result.outcome) << std::right;
+			for(size_t p = 0; p < phaseCount; p++) {
+				if(PhaseFinished(result, Phase(p)))
+					os << std::setw(12) << Milliseconds(result.phaseTime[p]);
+				else
+					os << std::setw(12) << "-";
+			}
+			os << std::setw(12) << Milliseconds(result.total);
+			if(result.outcome != Outcome::Online)
+				os << "  " << PhaseName(result.phase) << ": " << result.error;
+			os << "\n";
+			serialTime += result.total;
+		}
+
+		os << "\n" << std::left << std::setw(12) << "Phase" << std::right << std::setw(8) << "devices"
+			<< std::setw(12) << "min" << std::setw(12) << "mean" << std::setw(12) << "max" << "  (ms)\n";
+		for(size_t p = 0; p < phaseCount; p++) {
+			size_t count = 0;
+			Clock::duration min = Clock::duration::max(), max{}, sum{};
+			for(const auto& result : results) {
+				if(!PhaseFinished(result, Phase(p)))
+					continue;
+				count++;
+				min = std::min(min, result.phaseTime[p]);
+				max = std::max(max, result.phaseTime[p]);
+				sum += result.phaseTime[p];
+			}
+			os << std::left << std::setw(12) << PhaseName(Phase(p)) << std::right << std::setw(8) << count;
+			if(count == 0)
+				os << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(12) << "-" << "\n";
+			else
+				os << std::setw(12) << Milliseconds(min) << std::setw(12) << Milliseconds(sum / count) << std::setw(12) << Milliseconds(max) << "\n";
+		}
+
+		os << "\nBrought up in " << Milliseconds(wallTime) << "ms, " << Milliseconds(serialTime) << "ms of device time\n";
+		os.unsetf(std::ios_base::floatfield);
+	}
+
+private:
+	enum class State { Queued, Running, Finished, Abandoned };
+
+	struct Shared {
+		std::mutex mutex;
+		std::condition_variable changed;
+		std::chrono::milliseconds deviceTimeout;
+		Configurator configure;
+		std::vector<Result> results;
+		std::vector<State> states;
+		std::vector<Clock::time_point> started;
+		size_t next = 0; // The first device still queued
+		size_t workers = 0; // Worker threads which have not exited, including abandoned ones
+	};
+
+	size_t threads;
+	std::chrono::milliseconds deviceTimeout;
+	Configurator configure;
+	std::vector<std::thread> workers; // Every worker started, joined by waitForWorkers()
+	std::vector<std::shared_ptr<Shared>> runs; // The state of each run() with workers not yet joined
+
+	static std::string Milliseconds(Clock::duration duration) {
+		std::ostringstream ss;
+		ss << std::fixed << std::setprecision(1) << std::chrono::duration<double, std::milli>(duration).count();
+		return ss.str();
+	}
+
+	static bool PhaseFinished(const Result& result, Phase phase) {
+		return result.outcome == Outcome::Online || (result.outcome != Outcome::NotStarted && phase < result.phase);
+	}
+
+	static std::string LastError() {
+		std::ostringstream ss;
+		ss << icsneo::GetLastError();
+		return ss.str();
+	}
+
+	static bool RunPhase(icsneo::Device& device, Phase phase, const Configurator& configure) {
+		switch(phase) {
+			case Phase::Open: return device.open();
+			case Phase::Configure: return !configure || configure(device);
+			case Phase::Online: return device.goOnline();
+		}
+		return false;
+	}
+
+	bool waitForWorkers(const Clock::time_point* deadline) {
+		for(const auto& shared : runs) {
+			std::unique_lock<std::mutex> lock(shared->mutex);
+			while(shared->workers != 0) {
+				if(deadline == nullptr)
+					shared->changed.wait(lock);
+				else if(shared->changed.wait_until(lock, *deadline) == std::cv_status::timeout && shared->workers != 0)
+					return false;
+			}
+		}
+		for(auto& worker : workers)
+			worker.join();
+		workers.clear();
+		runs.clear();
+		return true;
+	}
+
+	// Called with the lock held
+	void Spawn(const std::shared_ptr<Shared>& shared) {
+		shared->workers++;
+		workers.emplace_back(Work, shared);
+	}
+
+	// Called with the lock held, gives up on a device stuck in a phase
+	static void Abandon(const std::shared_ptr<Shared>& shared, size_t index, Clock::time_point now) {
+		Result& result = shared->results[index];
+		shared->states[index] = State::Abandoned;
+		result.outcome = Outcome::TimedOut;
+		result.error = "Did not return within the timeout";
+		result.total = now - shared->started[index];
+	}
+
+	static void Work(std::shared_ptr<Shared> shared) {
+		BringUpDevices(shared);
+		std::lock_guard<std::mutex> lock(shared->mutex);
+		shared->workers--;
+		shared->changed.notify_all();
+	}
+
+	// Brings up queued devices until there are none left, or until this worker is abandoned
+	static void BringUpDevices(const std::shared_ptr<Shared>& shared) {
+		std::unique_lock<std::mutex> lock(shared->mutex);
+		while(shared->next < shared->results.size()) {
+			const size_t index = shared->next++;
+			Result& result = shared->results[index];
+			const std::shared_ptr<icsneo::Device> device = result.device;
+			const Clock::time_point start = Clock::now();
+			shared->started[index] = start;
+			shared->states[index] = State::Running;
+			shared->changed.notify_all();
+
+			Outcome outcome = Outcome::Online;
+			std::string error;
+			for(size_t p = 0; p < phaseCount; p++) {
+				result.phase = Phase(p);
+				lock.unlock();
+				const Clock::time_point phaseStart = Clock::now();
+				const bool ok = RunPhase(*device, Phase(p), shared->configure);
+				const Clock::time_point phaseEnd = Clock::now();
+				if(!ok)
+					error = LastError(); // Errors are kept per thread, so this is the error from this device
+				lock.lock();
+
+				if(shared->states[index] == State::Abandoned)
+					break;
+				result.phaseTime[p] = phaseEnd - phaseStart;
+				if(!ok) {
+					outcome = Outcome::Failed;
+					break;
+				}
+				if(p + 1 < phaseCount && phaseEnd - start >= shared->deviceTimeout) {
+					outcome = Outcome::TimedOut;
+					result.phase = Phase(p + 1);
+					error = "Used up the timeout before this phase";
+					break;
+				}
+			}
+
+			if(shared->states[index] == State::Abandoned) {
+				// Another worker has already taken this one's place
+				lock.unlock();
+				if(device->isOpen())
+					device->close();
+				return;
+			}
+
+			if(outcome != Outcome::Online && device->isOpen()) {
+				lock.unlock();
+				device->close();
+				lock.lock();
+				if(shared->states[index] == State::Abandoned)
+					return; // Closing took long enough that another worker has taken this one's place
+			}
+			result.outcome = outcome;
+			result.error = error;
+			result.total = Clock::now() - start;
+			shared->states[index] = State::Finished;
+			shared->changed.notify_all();
+		}
+	}
+};
+
+#endif
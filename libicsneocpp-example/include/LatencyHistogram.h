@@ -0,0 +1,184 @@
+#ifndef __LATENCYHISTOGRAM_H_
+#define __LATENCYHISTOGRAM_H_
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * \brief A fixed size log-linear histogram of nanosecond latencies, in the style of HdrHistogram
+ *
+ * Values are bucketed with 64 sub-buckets per power of two, which keeps every recorded value within
+ * 1.6% of its true value from 1ns up to about 36 minutes. Larger values are clamped into the last bucket.
+ *
+ * Recording is lock-free and safe from any number of threads, and reading percentiles while other
+ * threads record is safe as well (the result is a near-instant snapshot, not an atomic one).
+ * Nothing is allocated after construction, so it is safe to record from a message callback.
+ */
+class LatencyHistogram {
+public:
+	static const unsigned int linearBuckets = 128; // Values below this are counted exactly
+	static const unsigned int subBuckets = 64; // Sub-buckets per power of two above that
+	static const unsigned int maxMagnitude = 41; // Highest trackable value is 2^41 - 1 ns
+	static const size_t bucketCount = linearBuckets + (maxMagnitude - 7) * subBuckets;
+
+	LatencyHistogram() { reset(); }
+	LatencyHistogram(const LatencyHistogram&) = delete;
+	LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+	void record(uint64_t valueNs) {
+		buckets[indexFor(valueNs)].fetch_add(1, std::memory_order_relaxed);
+		totalCount.fetch_add(1, std::memory_order_relaxed);
+		totalSum.fetch_add(valueNs, std::memory_order_relaxed);
+
+		uint64_t current = minValue.load(std::memory_order_relaxed);
+		while(valueNs < current && !minValue.compare_exchange_weak(current, valueNs, std::memory_order_relaxed)) {}
+		current = maxValue.load(std::memory_order_relaxed);
+		while(valueNs > current && !maxValue.compare_exchange_weak(current, valueNs, std::memory_order_relaxed)) {}
+	}
+
+	// Adds every value recorded in other to this histogram
+	void add(const LatencyHistogram& other) {
+		for(size_t i = 0; i < bucketCount; i++) {
+			uint64_t count = other.buckets[i].load(std::memory_order_relaxed);
+			if(count != 0)
+				buckets[i].fetch_add(count, std::memory_order_relaxed);
+		}
+		totalCount.fetch_add(other.getCount(), std::memory_order_relaxed);
+		totalSum.fetch_add(other.totalSum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+		uint64_t otherMin = other.minValue.load(std::memory_order_relaxed);
+		uint64_t current = minValue.load(std::memory_order_relaxed);
+		while(otherMin < current && !minValue.compare_exchange_weak(current, otherMin, std::memory_order_relaxed)) {}
+		uint64_t otherMax = other.maxValue.load(std::memory_order_relaxed);
+		current = maxValue.load(std::memory_order_relaxed);
+		while(otherMax > current && !maxValue.compare_exchange_weak(current, otherMax, std::memory_order_relaxed)) {}
+	}
+
+	// Not safe to call while other threads are recording
+	void reset() {
+		for(auto& bucket : buckets)
+			bucket.store(0, std::memory_order_relaxed);
+		totalCount.store(0, std::memory_order_relaxed);
+		totalSum.store(0, std::memory_order_relaxed);
+		minValue.store(UINT64_MAX, std::memory_order_relaxed);
+		maxValue.store(0, std::memory_order_relaxed);
+	}
+
+	uint64_t getCount() const { return totalCount.load(std::memory_order_relaxed); }
+	uint64_t getMin() const { return getCount() == 0 ? 0 : minValue.load(std::memory_order_relaxed); }
+	uint64_t getMax() const { return maxValue.load(std::memory_order_relaxed); }
+	double getMean() const {
+		uint64_t count = getCount();
+		return count == 0 ? 0.0 : static_cast<double>(totalSum.load(std::memory_order_relaxed)) / count;
+	}
+
+	/**
+	 * \brief Gets the value at or below which the given percentage of recorded values fall
+	 * \param[in] percentile from 0 to 100
+	 * \returns the highest value equivalent to the bucket the percentile lands in, in nanoseconds
+	 */
+	uint64_t getValueAtPercentile(double percentile) const {
+		uint64_t count = getCount();
+		if(count == 0)
+			return 0;
+		percentile = std::min(std::max(percentile, 0.0), 100.0);
+		uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(percentile / 100.0 * count + 0.5));
+		uint64_t seen = 0;
+		for(size_t i = 0; i < bucketCount; i++) {
+			seen += buckets[i].load(std::memory_order_relaxed);
+			if(seen >= target)
+				return std::min(highestEquivalentValue(i), getMax());
+		}
+		return getMax();
+	}
+
+	/**
+	 * \brief Prints the percentile distribution in the HdrHistogram text format
+	 * \param[in] os the stream to print to
+	 * \param[in] scale values are divided by this before printing, 1000.0 prints microseconds
+	 * \param[in] ticksPerHalfDistance how many rows to print each time the distance to 100% halves
+	 *
+	 * The output can be loaded into the HdrHistogram plotter (http://hdrhistogram.github.io/HdrHistogram/plotFiles.html).
+	 */
+	void printPercentileDistribution(std::ostream& os, double scale = 1000.0, unsigned int ticksPerHalfDistance = 5) const {
+		const uint64_t count = getCount();
+		os << std::setw(12) << "Value" << std::setw(15) << "Percentile" << std::setw(11) << "TotalCount" << " 1/(1-Percentile)" << "\n\n";
+		if(count == 0)
+			return;
+
+		double percentile = 0.0;
+		while(true) {
+			uint64_t value = getValueAtPercentile(percentile);
+			uint64_t below = countAtOrBelow(value);
+			bool last = below >= count;
+			os << std::fixed << std::setprecision(3) << std::setw(12) << value / scale;
+			os << std::setprecision(12) << std::setw(15) << (last ? 1.0 : percentile / 100.0);
+			os << std::setw(11) << below;
+			if(!last)
+				os << std::setprecision(2) << std::setw(15) << 100.0 / (100.0 - percentile);
+			os << "\n";
+			if(last)
+				break;
+
+			// Each time the distance to 100% halves, the step halves too, so the tail gets ever finer rows
+			double halvings = std::floor(std::log2(100.0 / (100.0 - percentile))) + 1.0;
+			percentile += 100.0 / (ticksPerHalfDistance * std::pow(2.0, halvings));
+		}
+
+		os << std::fixed << std::setprecision(3);
+		os << "#[Mean    = " << std::setw(12) << getMean() / scale << ", Max          = " << std::setw(12) << getMax() / scale << "]\n";
+		os << "#[Min     = " << std::setw(12) << getMin() / scale << ", Total count  = " << std::setw(12) << count << "]\n";
+		os.unsetf(std::ios_base::floatfield);
+	}
+
+private:
+	static unsigned int floorLog2(uint64_t value) {
+		unsigned int log = 0;
+		while(value >>= 1)
+			log++;
+		return log;
+	}
+
+	static size_t indexFor(uint64_t value) {
+		if(value < linearBuckets)
+			return static_cast<size_t>(value);
+		unsigned int magnitude = floorLog2(value);
+		if(magnitude >= maxMagnitude)
+			return bucketCount - 1;
+		unsigned int shift = magnitude - 6; // Leaves the top 7 bits, which fall in [64, 128)
+		return linearBuckets + (magnitude - 7) * subBuckets + static_cast<size_t>((value >> shift) - subBuckets);
+	}
+
+	static uint64_t lowestEquivalentValue(size_t index) {
+		if(index < linearBuckets)
+			return index;
+		size_t magnitudeIndex = (index - linearBuckets) / subBuckets;
+		uint64_t subBucket = (index - linearBuckets) % subBuckets + subBuckets;
+		return subBucket << (magnitudeIndex + 1);
+	}
+
+	static uint64_t highestEquivalentValue(size_t index) {
+		return index + 1 >= bucketCount ? UINT64_MAX : lowestEquivalentValue(index + 1) - 1;
+	}
+
+	uint64_t countAtOrBelow(uint64_t value) const {
+		size_t last = indexFor(value);
+		uint64_t seen = 0;
+		for(size_t i = 0; i <= last; i++)
+			seen += buckets[i].load(std::memory_order_relaxed);
+		return seen;
+	}
+
+	std::array<std::atomic<uint64_t>, bucketCount> buckets;
+	std::atomic<uint64_t> totalCount;
+	std::atomic<uint64_t> totalSum;
+	std::atomic<uint64_t> minValue;
+	std::atomic<uint64_t> maxValue;
+};
+
+#endif
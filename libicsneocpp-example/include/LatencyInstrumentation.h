@@ -0,0 +1,258 @@
+#ifndef __LATENCYINSTRUMENTATION_H_
+#define __LATENCYINSTRUMENTATION_H_
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+
+#include "icsneo/icsneocpp.h"
+#include "LatencyHistogram.h"
+
+/**
+ * \brief Measures where the time goes between a frame being timestamped by the device and the application being done with it
+ *
+ * For each sampled message three points in time are taken:
+ *  - the hardware timestamp the device put on the frame
+ *  - the host monotonic time at which the library delivered it (entry to the message callback, or return from getMessages when polling)
+ *  - the host monotonic time at which the application's handler finished with it
+ *
+ * From these, three latencies are recorded per network:
+ *  - Transport: hardware timestamp to delivery. This covers the device, the USB or network transfer, the driver and the library's decode.
+ *    The device and host clocks have unrelated epochs, so this is measured relative to the fastest delivery seen so far on the same thread,
+ *    i.e. it is the time spent above the best case. Clock drift between the device and the host slowly skews it on long runs.
+ *  - Handler: delivery to handler finished
+ *  - Total: the sum of the two
+ *
+ * Recording is lock-free. Every delivering thread (libicsneo uses one per device) gets its own set of histograms, registered the first
+ * time that thread records. Exporting merges the per-thread histograms and may run while recording continues.
+ *
+ * With sampleEvery set above 1 only one in that many messages is timed, the rest are passed straight to the handler,
+ * which keeps the overhead negligible at high bus loads.
+ */
+class LatencyInstrumentation {
+public:
+	enum class Stage : size_t {
+		Transport = 0,
+		Handler = 1,
+		Total = 2
+	};
+	static const size_t stageCount = 3;
+
+	// NetIDs at or above this are all counted together
+	static const size_t maxNetIDs = 1024;
+
+	typedef std::function<void(std::shared_ptr<icsneo::Message>)> Handler;
+
+	/**
+	 * \param[in] sampleEvery time one in this many messages, rounded up to a power of two
+	 */
+	explicit LatencyInstrumentation(uint32_t sampleEvery = 1) : generation(nextGeneration().fetch_add(1) + 1) {
+		uint32_t rounded = 1;
+		while(rounded < sampleEvery && rounded < 0x80000000)
+			rounded <<= 1;
+		sampleMask = rounded - 1;
+	}
+
+	LatencyInstrumentation(const LatencyInstrumentation&) = delete;
+	LatencyInstrumentation& operator=(const LatencyInstrumentation&) = delete;
+
+	// How many messages there are for each one timed, the sampleEvery given rounded up to a power of two
+	uint32_t getSampleEvery() const { return sampleMask + 1; }
+
+	/**
+	 * \brief Wraps a message handler so that it is timed
+	 * \param[in] handler the application's handler
+	 * \returns a callback to register with Device::addMessageCallback
+	 *
+	 * The instrumentation must outlive the callback's registration.
+	 */
+	icsneo::MessageCallback instrument(Handler handler) {
+		return icsneo::MessageCallback([this, handler](std::shared_ptr<icsneo::Message> message) {
+			if(!sampleNext()) {
+				handler(message);
+				return;
+			}
+
+			const auto delivered = std::chrono::steady_clock::now();
+			handler(message);
+			record(*message, delivered, std::chrono::steady_clock::now());
+		});
+	}
+
+	/**
+	 * \brief Decides whether the next message delivered on this thread should be timed
+	 *
+	 * Only needed when using record() directly, for instance with message polling.
+	 */
+	bool sampleNext() {
+		ThreadState& state = getThreadState();
+		return (state.sampleCounter++ & sampleMask) == 0;
+	}
+
+	/**
+	 * \brief Records the latencies for one message
+	 * \param[in] message the message, its hardware timestamp is used
+	 * \param[in] delivered when the library handed the message over
+	 * \param[in] handled when the application finished with the message
+	 */
+	void record(const icsneo::Message& message, std::chrono::steady_clock::time_point delivered, std::chrono::steady_clock::time_point handled) {
+		ThreadState& state = getThreadState();
+		size_t netid = std::min<size_t>(static_cast<size_t>(message.network.getNetID()), maxNetIDs - 1);
+
+		StageHistograms* histograms = state.netids[netid].load(std::memory_order_acquire);
+		if(histograms == nullptr) {
+			// The first message on each network allocates its histograms, publishing them for export
+			histograms = new StageHistograms();
+			state.netids[netid].store(histograms, std::memory_order_release);
+		}
+
+		int64_t deliveredNs = std::chrono::duration_cast<std::chrono::nanoseconds>(delivered.time_since_epoch()).count();
+		int64_t offset = deliveredNs - static_cast<int64_t>(message.timestamp);
+		if(!state.hasBaseline || offset < state.baselineOffset) {
+			state.baselineOffset = offset;
+			state.hasBaseline = true;
+		}
+
+		uint64_t transport = static_cast<uint64_t>(offset - state.baselineOffset);
+		uint64_t handler = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(handled - delivered).count());
+		histograms->stages[static_cast<size_t>(Stage::Transport)].record(transport);
+		histograms->stages[static_cast<size_t>(Stage::Handler)].record(handler);
+		histograms->stages[static_cast<size_t>(Stage::Total)].record(transport + handler);
+	}
+
+	/**
+	 * \brief Writes the percentiles for each network and stage as CSV, in microseconds
+	 * \param[in] os the stream to write to
+	 */
+	void exportCsv(std::ostream& os) const {
+		os << "netid,stage,count,min_us,p50_us,p90_us,p99_us,p99.9_us,max_us\n";
+		forEachMerged([&os](size_t netid, Stage stage, const LatencyHistogram& histogram) {
+			os << netid << ',' << GetStageName(stage) << ',' << histogram.getCount() << std::fixed << std::setprecision(3);
+			os << ',' << histogram.getMin() / 1000.0;
+			for(double percentile : {50.0, 90.0, 99.0, 99.9})
+				os << ',' << histogram.getValueAtPercentile(percentile) / 1000.0;
+			os << ',' << histogram.getMax() / 1000.0 << '\n';
+			os.unsetf(std::ios_base::floatfield);
+		});
+	}
+
+	// Prints the percentiles for each network and stage as a table, in microseconds
+	void printReport(std::ostream& os) const {
+		os << "\t" << std::left << std::setw(16) << "Network" << std::setw(11) << "Stage" << std::right << std::setw(10) << "Samples";
+		os << std::setw(10) << "p50(us)" << std::setw(10) << "p90(us)" << std::setw(10) << "p99(us)" << std::setw(11) << "p99.9(us)" << std::setw(10) << "Max(us)" << "\n";
+		forEachMerged([&os](size_t netid, Stage stage, const LatencyHistogram& histogram) {
+			const char* name = netid == maxNetIDs - 1 ? "Other" : icsneo::Network::GetNetIDString(static_cast<icsneo::Network::NetID>(netid));
+			os << "\t" << std::left << std::setw(16) << (stage == Stage::Transport ? name : "") << std::setw(11) << GetStageName(stage) << std::right;
+			os << std::setw(10) << histogram.getCount() << std::fixed << std::setprecision(1);
+			os << std::setw(10) << histogram.getValueAtPercentile(50) / 1000.0;
+			os << std::setw(10) << histogram.getValueAtPercentile(90) / 1000.0;
+			os << std::setw(10) << histogram.getValueAtPercentile(99) / 1000.0;
+			os << std::setw(11) << histogram.getValueAtPercentile(99.9) / 1000.0;
+			os << std::setw(10) << histogram.getMax() / 1000.0 << "\n";
+			os.unsetf(std::ios_base::floatfield);
+		});
+	}
+
+	static const char* GetStageName(Stage stage) {
+		switch(stage) {
+			case Stage::Transport:
+				return "Transport";
+			case Stage::Handler:
+				return "Handler";
+			case Stage::Total:
+				return "Total";
+		}
+		return "";
+	}
+
+private:
+	struct StageHistograms {
+		LatencyHistogram stages[stageCount];
+	};
+
+	// Everything a delivering thread records into, only ever written by that thread
+	struct ThreadState {
+		std::thread::id owner;
+		std::array<std::atomic<StageHistograms*>, maxNetIDs> netids;
+		uint64_t sampleCounter = 0;
+		int64_t baselineOffset = 0;
+		bool hasBaseline = false;
+
+		ThreadState() : owner(std::this_thread::get_id()) {
+			for(auto& netid : netids)
+				netid.store(nullptr, std::memory_order_relaxed);
+		}
+		~ThreadState() {
+			for(auto& netid : netids)
+				delete netid.load(std::memory_order_relaxed);
+		}
+	};
+
+	static std::atomic<uint64_t>& nextGeneration() {
+		static std::atomic<uint64_t> counter(0);
+		return counter;
+	}
+
+	/**
+	 * The calling thread's state. After the first call on a thread this is a thread local comparison,
+	 * the registry lock is only taken the first time a thread records into this instance.
+	 */
+	ThreadState& getThreadState() {
+		thread_local uint64_t cachedGeneration = 0;
+		thread_local ThreadState* cachedState = nullptr;
+		if(cachedGeneration == generation)
+			return *cachedState;
+
+		std::lock_guard<std::mutex> lk(registryMutex);
+		ThreadState* state = nullptr;
+		for(auto& existing : threads) {
+			if(existing->owner == std::this_thread::get_id())
+				state = existing.get();
+		}
+		if(state == nullptr) {
+			threads.emplace_back(new ThreadState());
+			state = threads.back().get();
+		}
+		cachedGeneration = generation;
+		cachedState = state;
+		return *state;
+	}
+
+	// Merges the per-thread histograms for each network and calls fn for each stage with data
+	void forEachMerged(const std::function<void(size_t, Stage, const LatencyHistogram&)>& fn) const {
+		std::lock_guard<std::mutex> lk(registryMutex);
+		std::unique_ptr<StageHistograms> merged(new StageHistograms());
+		for(size_t netid = 0; netid < maxNetIDs; netid++) {
+			bool found = false;
+			for(auto& stage : merged->stages)
+				stage.reset();
+			for(auto& thread : threads) {
+				const StageHistograms* histograms = thread->netids[netid].load(std::memory_order_acquire);
+				if(histograms == nullptr)
+					continue;
+				found = true;
+				for(size_t stage = 0; stage < stageCount; stage++)
+					merged->stages[stage].add(histograms->stages[stage]);
+			}
+			if(!found)
+				continue;
+			for(size_t stage = 0; stage < stageCount; stage++)
+				fn(netid, static_cast<Stage>(stage), merged->stages[stage]);
+		}
+	}
+
+	const uint64_t generation; // Tells this instance's thread local cache entries apart from those of an earlier instance
+	uint32_t sampleMask;
+	mutable std::mutex registryMutex;
+	std::vector<std::unique_ptr<ThreadState>> threads;
+};
+
+#endif
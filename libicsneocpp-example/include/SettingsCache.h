@@ -0,0 +1,188 @@
+#ifndef __SETTINGSCACHE_H_
+#define __SETTINGSCACHE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "icsneo/icsneocpp.h"
+#include "icsneo/communication/message/resetstatusmessage.h"
+#include "SettingsTransaction.h"
+
+/**
+ * \brief A read-side cache of a device's baudrates, for code which checks them far more often than they change
+ *
+ * The baudrates and FD baudrates of the networks given are read into an immutable snapshot, which the getters answer from.
+ * The snapshot is only replaced by refresh(), by an apply or commit made through the cache, or after the device reports
+ * that it has reset. The version number goes up each time a new snapshot differs from the last, so a health check
+ * can compare getVersion() with the version it last saw rather than comparing every rate.
+ *
+ * Reading is safe from any number of threads while another refreshes. A caller which checks many rates at once should take
+ * snapshot() once and read from that, it stays valid and unchanged for as long as it is held.
+ */
+class SettingsCache {
+public:
+	class Snapshot {
+	public:
+		// The baudrate the device was operating on, or -1 if the network is not cached or could not be read
+		int64_t getBaudrateFor(icsneo::Network::NetID netid) const {
+			const Entry* entry = find(netid);
+			return entry == nullptr ? -1 : entry->baudrate;
+		}
+
+		// The FD baudrate the device was operating on, or -1 if the network is not cached or could not be read
+		int64_t getFDBaudrateFor(icsneo::Network::NetID netid) const {
+			const Entry* entry = find(netid);
+			return entry == nullptr ? -1 : entry->fdBaudrate;
+		}
+
+		uint64_t getVersion() const { return version; }
+
+	private:
+		friend class SettingsCache;
+
+		struct Entry {
+			icsneo::Network::NetID netid;
+			int64_t baudrate;
+			int64_t fdBaudrate;
+		};
+
+		std::vector<Entry> entries; // In the order the networks were given, there are only ever a handful
+		uint64_t version = 0;
+
+		const Entry* find(icsneo::Network::NetID netid) const {
+			for(const auto& entry : entries) {
+				if(entry.netid == netid)
+					return &entry;
+			}
+			return nullptr;
+		}
+	};
+
+	/**
+	 * \param[in] device an open device
+	 * \param[in] networks the networks to cache the baudrates of
+	 *
+	 * The first snapshot is taken from the settings libicsneo read when the device was opened, without contacting the device.
+	 */
+	SettingsCache(std::shared_ptr<icsneo::Device> device, std::vector<icsneo::Network::NetID> networks)
+		: device(std::move(device)), networks(std::move(networks)) {
+		update(false);
+	}
+
+	SettingsCache(const SettingsCache&) = delete;
+	SettingsCache& operator=(const SettingsCache&) = delete;
+
+	~SettingsCache() {
+		if(callbackID != -1)
+			device->removeMessageCallback(callbackID);
+	}
+
+	/**
+	 * \brief Refreshes the cache once the device reports that it has reset, which returns it to the settings in its EEPROM
+	 * \returns false if the callback could not be added
+	 *
+	 * The refresh is made by the next read after the reset rather than on libicsneo's thread, so that read takes a round trip.
+	 */
+	bool watchForResets() {
+		if(callbackID != -1)
+			return true;
+		// Reset_Status is an internal network, which the default filter leaves out, so it has to be asked for by NetID
+		callbackID = device->addMessageCallback(icsneo::MessageCallback([this](std::shared_ptr<icsneo::Message> message) {
+			if(message->network.getNetID() != icsneo::Network::NetID::Reset_Status)
+				return;
+			if(std::static_pointer_cast<icsneo::ResetStatusMessage>(message)->justReset)
+				resetDetected.store(true, std::memory_order_release);
+		}, icsneo::MessageFilter(icsneo::Network::NetID::Reset_Status)));
+		return callbackID != -1;
+	}
+
+	/**
+	 * \brief Reads the settings from the device again and replaces the snapshot
+	 * \returns false if the settings could not be read, in which case the snapshot is kept
+	 */
+	bool refresh() {
+		return update(true);
+	}
+
+	/**
+	 * \brief Applies the device's settings, then replaces the snapshot with what the device is now operating on
+	 */
+	bool apply(bool temporary = false) {
+		const bool ok = device->settings->apply(temporary);
+		update(false);
+		return ok;
+	}
+
+	/**
+	 * \brief Commits a transaction for this cache's device, replacing the snapshot only if an apply was sent
+	 */
+	bool commit(SettingsTransaction& transaction, bool temporary = true, SettingsTransaction::Report* report = nullptr) {
+		SettingsTransaction::Report result;
+		const bool ok = transaction.commit(temporary, &result);
+		if(result.applies != 0)
+			update(false);
+		if(report != nullptr)
+			*report = result;
+		return ok;
+	}
+
+	/**
+	 * \brief The current snapshot, which does not change while it is held
+	 */
+	std::shared_ptr<const Snapshot> snapshot() {
+		// If the refresh fails the reset is remembered, so the next read tries again rather than serving stale rates
+		if(resetDetected.load(std::memory_order_acquire) && resetDetected.exchange(false) && !update(true))
+			resetDetected.store(true, std::memory_order_release);
+		return std::atomic_load(&current);
+	}
+
+	int64_t getBaudrateFor(icsneo::Network::NetID netid) { return snapshot()->getBaudrateFor(netid); }
+	int64_t getFDBaudrateFor(icsneo::Network::NetID netid) { return snapshot()->getFDBaudrateFor(netid); }
+
+	/**
+	 * \brief The version of the newest snapshot, which only goes up when a baudrate has changed
+	 *
+	 * This does not check for a reset, call snapshot() or a getter for that.
+	 */
+	uint64_t getVersion() const { return version.load(std::memory_order_acquire); }
+
+	const std::shared_ptr<icsneo::Device>& getDevice() const { return device; }
+
+private:
+	std::shared_ptr<icsneo::Device> device;
+	std::vector<icsneo::Network::NetID> networks;
+	std::shared_ptr<const Snapshot> current; // Only accessed with std::atomic_load and std::atomic_store
+	std::atomic<uint64_t> version{0};
+	std::atomic<bool> resetDetected{false};
+	std::mutex updateMutex; // Held while a new snapshot is made, so updates do not race each other
+	int callbackID = -1;
+
+	// Makes a new snapshot, only publishing it and moving the version on if a baudrate changed
+	bool update(bool fromDevice) {
+		std::lock_guard<std::mutex> lock(updateMutex);
+		if(fromDevice && !device->settings->refresh())
+			return false;
+
+		std::shared_ptr<Snapshot> next = std::make_shared<Snapshot>();
+		next->entries.reserve(networks.size());
+		for(const auto netid : networks)
+			next->entries.push_back({netid, device->settings->getBaudrateFor(netid), device->settings->getFDBaudrateFor(netid)});
+
+		std::shared_ptr<const Snapshot> previous = std::atomic_load(&current);
+		if(previous && std::equal(previous->entries.begin(), previous->entries.end(), next->entries.begin(),
+			[](const Snapshot::Entry& a, const Snapshot::Entry& b) { return a.baudrate == b.baudrate && a.fdBaudrate == b.fdBaudrate; }))
+			return true;
+
+		const uint64_t nextVersion = version.load(std::memory_order_relaxed) + 1;
+		next->version = nextVersion;
+		std::atomic_store(&current, std::shared_ptr<const Snapshot>(std::move(next)));
+		version.store(nextVersion, std::memory_order_release);
+		return true;
+	}
+};
+
+#endif
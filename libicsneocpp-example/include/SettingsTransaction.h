@@ -0,0 +1,133 @@
+#ifndef __SETTINGSTRANSACTION_H_
+#define __SETTINGSTRANSACTION_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "icsneo/icsneocpp.h"
+
+/**
+ * \brief Records settings changes for a device and applies them together, in a single apply
+ *
+ * Setting a baudrate and applying it straight away, as the interactive example does, costs an apply for every change,
+ * and a permanent apply writes the device's EEPROM each time. A transaction only records the changes, keeping the last
+ * value given for each network. commit() compares them with the values the device is operating on, drops any which would
+ * not change anything, and makes the rest in one apply.
+ *
+ * A temporary commit where nothing would change does not contact the device at all. A permanent commit of any recorded
+ * change always applies, since values which were only applied temporarily match what the device is running but not
+ * what is in its EEPROM, and libicsneo has no view of the EEPROM to compare against.
+ *
+ * A transaction may be used by one thread at a time, and should not be interleaved with other changes to the same device's settings.
+ */
+class SettingsTransaction {
+public:
+	struct Report {
+		size_t recorded = 0; // Changes recorded since the last commit, counting each one even if it was replaced by a later one
+		size_t changed = 0; // Changes which were different from the values the device was operating on
+		size_t applies = 0; // Applies sent to the device, 0 or 1, always 1 for a permanent commit of any change
+
+		// Applies saved compared with applying after every change
+		size_t appliesSaved() const { return recorded - applies; }
+	};
+
+	explicit SettingsTransaction(icsneo::Device& device) : device(device) {}
+
+	SettingsTransaction& setBaudrateFor(icsneo::Network::NetID netid, int64_t baudrate) {
+		record(netid, false, baudrate);
+		return *this;
+	}
+
+	SettingsTransaction& setFDBaudrateFor(icsneo::Network::NetID netid, int64_t baudrate) {
+		record(netid, true, baudrate);
+		return *this;
+	}
+
+	// The number of distinct changes waiting to be committed
+	size_t size() const { return changes.size(); }
+
+	// Forgets the changes recorded since the last commit
+	void clear() {
+		changes.clear();
+		recorded = 0;
+	}
+
+	/**
+	 * \brief Applies the recorded changes which differ from what the device is operating on, in a single apply
+	 * \param[in] temporary passed to settings->apply(), true keeps the changes until the device is power cycled rather than writing EEPROM
+	 * \param[out] report if not nullptr, what was recorded and what was sent
+	 * \returns false if a change was rejected or the apply failed, in which case the local settings are put back as they were.
+	 * The transaction is emptied either way.
+	 */
+	bool commit(bool temporary = true, Report* report = nullptr) {
+		Report result;
+		result.recorded = recorded;
+
+		// A permanent commit sets every change, so the EEPROM gets exactly what was recorded
+		std::vector<Change> made; // Each change made to the local settings, holding the value it replaced
+		bool ok = true;
+		for(const auto& change : changes) {
+			const int64_t current = get(change);
+			if(current != change.baudrate)
+				result.changed++;
+			else if(temporary)
+				continue;
+			if(!set(change, change.baudrate)) {
+				ok = false;
+				break;
+			}
+			made.push_back(change);
+			made.back().baudrate = current;
+		}
+
+		if(ok && !made.empty()) {
+			result.applies = 1;
+			ok = device.settings->apply(temporary);
+		}
+		if(!ok) {
+			// Put the local settings back, in reverse so the earliest value wins
+			for(auto it = made.rbegin(); it != made.rend(); ++it) {
+				if(it->baudrate >= 0)
+					set(*it, it->baudrate);
+			}
+		}
+
+		clear();
+		if(report != nullptr)
+			*report = result;
+		return ok;
+	}
+
+private:
+	struct Change {
+		icsneo::Network::NetID netid;
+		bool fd;
+		int64_t baudrate;
+	};
+
+	icsneo::Device& device;
+	std::vector<Change> changes; // In the order they were first recorded, there are only ever a handful
+	size_t recorded = 0;
+
+	void record(icsneo::Network::NetID netid, bool fd, int64_t baudrate) {
+		recorded++;
+		for(auto& change : changes) {
+			if(change.netid == netid && change.fd == fd) {
+				change.baudrate = baudrate;
+				return;
+			}
+		}
+		changes.push_back({netid, fd, baudrate});
+	}
+
+	int64_t get(const Change& change) const {
+		return change.fd ? device.settings->getFDBaudrateFor(change.netid) : device.settings->getBaudrateFor(change.netid);
+	}
+
+	bool set(const Change& change, int64_t baudrate) {
+		return change.fd ? device.settings->setFDBaudrateFor(change.netid, baudrate) : device.settings->setBaudrateFor(change.netid, baudrate);
+	}
+};
+
+#endif
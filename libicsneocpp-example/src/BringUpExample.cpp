@@ -0,0 +1,99 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "icsneo/icsneocpp.h"
+#include "DeviceBringUp.h"
+#include "SettingsTransaction.h"
+#include "SettingsCache.h"
+
+int main(int argc, char** argv) {
+	// The number of devices brought up at once, and how long each may take, can be passed as arguments
+	size_t threads = 4;
+	if(argc > 1)
+		threads = static_cast<size_t>(strtoul(argv[1], nullptr, 10));
+	unsigned long timeoutSeconds = 10;
+	if(argc > 2)
+		timeoutSeconds = strtoul(argv[2], nullptr, 10);
+	if(threads == 0 || timeoutSeconds == 0) {
+		std::cout << "Usage: " << argv[0] << " [threads, default 4] [timeout per device in seconds, default 10]" << std::endl;
+		return 1;
+	}
+
+	std::cout << "Running libicsneo " << icsneo::GetVersion() << std::endl;
+
+	std::cout << "\nFinding devices... " << std::flush;
+	auto devices = icsneo::FindAllDevices();
+	std::cout << "OK, " << devices.size() << " device" << (devices.size() == 1 ? "" : "s") << " found" << std::endl;
+	if(devices.empty())
+		return 1;
+	for(auto& device : devices)
+		std::cout << '\t' << device->getType() << " - " << device->getSerial() << std::endl;
+
+	// The same settings as the simple example, applied temporarily so bringing a rack up does not rewrite every EEPROM
+	// Devices already running these settings are not sent an apply at all
+	DeviceBringUp bringUp(threads, std::chrono::seconds(timeoutSeconds), [](icsneo::Device& device) {
+		SettingsTransaction transaction(device);
+		transaction.setBaudrateFor(icsneo::Network::NetID::HSCAN, 125000).setFDBaudrateFor(icsneo::Network::NetID::HSCAN, 8000000);
+		return transaction.commit(true);
+	});
+
+	std::cout << "\nBringing up " << devices.size() << " device" << (devices.size() == 1 ? "" : "s") << ", "
+		<< threads << " at a time, " << timeoutSeconds << "s each... " << std::flush;
+	const auto start = DeviceBringUp::Clock::now();
+	const auto results = bringUp.run(devices);
+	const auto wallTime = DeviceBringUp::Clock::now() - start;
+
+	size_t online = 0;
+	for(const auto& result : results) {
+		if(result.outcome == DeviceBringUp::Outcome::Online)
+			online++;
+	}
+	std::cout << online << " online" << std::endl << std::endl;
+	DeviceBringUp::PrintReport(std::cout, results, wallTime);
+
+	// A device which timed out may still have a worker inside libicsneo, which has to return before the program can exit
+	if(!bringUp.waitForWorkers(std::chrono::seconds(timeoutSeconds))) {
+		std::cout << "\nWaiting for devices which timed out to return... " << std::flush;
+		bringUp.waitForWorkers();
+		std::cout << "OK" << std::endl;
+	}
+
+	// A health check reads every device's baudrates each cycle. The caches answer from memory, and the version only
+	// moves when a rate has changed, so the rates are only printed again when they are different.
+	std::vector<std::unique_ptr<SettingsCache>> caches;
+	for(const auto& result : results) {
+		if(result.outcome != DeviceBringUp::Outcome::Online)
+			continue;
+		caches.emplace_back(new SettingsCache(result.device, {icsneo::Network::NetID::HSCAN}));
+		caches.back()->watchForResets();
+	}
+	std::vector<uint64_t> seen(caches.size(), 0);
+	std::cout << "\nChecking baudrates for 5 seconds..." << std::endl;
+	for(int cycle = 0; cycle < 50; cycle++) {
+		for(size_t i = 0; i < caches.size(); i++) {
+			const auto snapshot = caches[i]->snapshot();
+			if(snapshot->getVersion() == seen[i])
+				continue;
+			seen[i] = snapshot->getVersion();
+			std::cout << '\t' << caches[i]->getDevice()->getSerial() << " HSCAN " << snapshot->getBaudrateFor(icsneo::Network::NetID::HSCAN) / 1000
+				<< "kbit/s, FD " << snapshot->getFDBaudrateFor(icsneo::Network::NetID::HSCAN) / 1000 << "kbit/s (version " << seen[i] << ")" << std::endl;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+	caches.clear(); // Removes the reset callbacks before the devices are closed
+
+	std::cout << "\nClosing devices... " << std::flush;
+	for(const auto& result : results) {
+		if(result.outcome == DeviceBringUp::Outcome::Online) {
+			result.device->goOffline();
+			result.device->close();
+		}
+	}
+	std::cout << "OK" << std::endl;
+
+	return online == results.size() ? 0 : 1;
+}
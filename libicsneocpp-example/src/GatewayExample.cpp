@@ -0,0 +1,316 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstdlib>
+
+#include "icsneo/icsneocpp.h"
+#include "LatencyHistogram.h"
+
+// Used in place of an arbitration ID to match every frame on the source network which has no more specific rule
+const int64_t anyArbid = -1;
+
+enum class GatewayAction {
+	Drop, // Discard the frame
+	Forward // Transmit the frame, after applying any rewrites
+};
+
+// data[index] = (data[index] & ~mask) | (value & mask)
+struct ByteRewrite {
+	uint8_t index;
+	uint8_t mask;
+	uint8_t value;
+};
+
+/**
+ * A gateway rule matches frames from one network on one device, and either drops them or forwards them
+ * to a network on the same or another device. Forwarded frames can have their arbitration ID remapped
+ * and individual bytes rewritten on the way through.
+ */
+struct GatewayRule {
+	std::string name;
+
+	// Match
+	size_t sourceDevice;
+	icsneo::Network::NetID sourceNetwork;
+	int64_t arbid; // anyArbid to match everything without a more specific rule
+	bool extended; // Whether arbid is a 29-bit extended ID, extended IDs from 0x000 to 0x7FF are distinct from the standard ones
+
+	// Action
+	GatewayAction action;
+	size_t destinationDevice;
+	icsneo::Network::NetID destinationNetwork;
+	int64_t newArbid; // anyArbid keeps the original arbitration ID
+	std::vector<ByteRewrite> rewrites;
+
+	// Set up by CompileRules()
+	std::shared_ptr<icsneo::Device> destination;
+	std::shared_ptr<icsneo::CANMessage> forwarded; // Preallocated, only used by the source device's receive thread
+
+	// Statistics
+	std::atomic<uint64_t> hits;
+	std::atomic<uint64_t> failedTransmits;
+	LatencyHistogram latency; // Receive callback entry until transmit returns, in nanoseconds
+
+	GatewayRule() : extended(false), hits(0), failedTransmits(0) {}
+};
+
+/**
+ * The dispatch table for one network on one device. Standard IDs are looked up directly by index, extended
+ * IDs through a hash table, chosen by the frame's extended flag rather than the value of its ID, so finding
+ * the rule for a frame does not depend on how many rules there are.
+ * The tables are read-only once compiled, so the receive callbacks can use them without locking.
+ */
+struct NetworkDispatch {
+	std::array<GatewayRule*, 0x800> standard;
+	std::unordered_map<uint32_t, GatewayRule*> extended;
+	GatewayRule* any = nullptr;
+
+	NetworkDispatch() { standard.fill(nullptr); }
+};
+
+struct DeviceDispatch {
+	std::unordered_map<uint16_t, NetworkDispatch> networks;
+	std::atomic<uint64_t> unmatched;
+
+	DeviceDispatch() : unmatched(0) {}
+};
+
+/**
+ * \brief Creates a rule which forwards frames, optionally remapping the arbitration ID
+ * \param[in] name the name shown in the report
+ * \param[in] sourceDevice the index of the device the frames are received on
+ * \param[in] sourceNetwork the network the frames are received on
+ * \param[in] arbid the arbitration ID to match, or anyArbid
+ * \param[in] destinationDevice the index of the device to transmit on
+ * \param[in] destinationNetwork the network to transmit on
+ * \param[in] newArbid the arbitration ID to transmit with, or anyArbid to keep it
+ * \param[in] extended whether arbid is an extended ID, IDs above 0x7FF are always extended
+ */
+std::unique_ptr<GatewayRule> ForwardRule(std::string name, size_t sourceDevice, icsneo::Network::NetID sourceNetwork, int64_t arbid,
+	size_t destinationDevice, icsneo::Network::NetID destinationNetwork, int64_t newArbid = anyArbid, bool extended = false) {
+	std::unique_ptr<GatewayRule> rule(new GatewayRule());
+	rule->name = std::move(name);
+	rule->sourceDevice = sourceDevice;
+	rule->sourceNetwork = sourceNetwork;
+	rule->arbid = arbid;
+	rule->extended = extended || arbid > 0x7FF;
+	rule->action = GatewayAction::Forward;
+	rule->destinationDevice = destinationDevice;
+	rule->destinationNetwork = destinationNetwork;
+	rule->newArbid = newArbid;
+	return rule;
+}
+
+// Creates a rule which drops matching frames
+std::unique_ptr<GatewayRule> DropRule(std::string name, size_t sourceDevice, icsneo::Network::NetID sourceNetwork, int64_t arbid, bool extended = false) {
+	std::unique_ptr<GatewayRule> rule = ForwardRule(std::move(name), sourceDevice, sourceNetwork, arbid, sourceDevice, sourceNetwork, anyArbid, extended);
+	rule->action = GatewayAction::Drop;
+	return rule;
+}
+
+/**
+ * \brief Builds the per-device dispatch tables and preallocates a forwarding message for each rule
+ * \param[in] rules the rules to compile, rules referring to missing devices are skipped
+ * \param[in] devices the open devices, indexed by the rules
+ * \returns one dispatch table per device
+ */
+std::vector<std::unique_ptr<DeviceDispatch>> CompileRules(std::vector<std::unique_ptr<GatewayRule>>& rules, const std::vector<std::shared_ptr<icsneo::Device>>& devices) {
+	std::vector<std::unique_ptr<DeviceDispatch>> dispatch;
+	for(size_t i = 0; i < devices.size(); i++)
+		dispatch.emplace_back(new DeviceDispatch());
+
+	for(auto& rule : rules) {
+		if(rule->sourceDevice >= devices.size() || rule->destinationDevice >= devices.size()) {
+			std::cout << "\tSkipping rule \"" << rule->name << "\", it refers to a device which was not found" << std::endl;
+			continue;
+		}
+
+		rule->destination = devices[rule->destinationDevice];
+		rule->forwarded = std::make_shared<icsneo::CANMessage>();
+		rule->forwarded->network = rule->destinationNetwork;
+		rule->forwarded->data.reserve(64); // The largest CAN FD payload, so forwarding never reallocates
+
+		NetworkDispatch& network = dispatch[rule->sourceDevice]->networks[static_cast<uint16_t>(rule->sourceNetwork)];
+		GatewayRule** slot;
+		if(rule->arbid == anyArbid)
+			slot = &network.any;
+		else if(!rule->extended)
+			slot = &network.standard[static_cast<size_t>(rule->arbid)];
+		else
+			slot = &network.extended[static_cast<uint32_t>(rule->arbid)];
+
+		if(*slot != nullptr)
+			std::cout << "\tRule \"" << rule->name << "\" replaces rule \"" << (*slot)->name << "\"" << std::endl;
+		*slot = rule.get();
+	}
+
+	return dispatch;
+}
+
+/**
+ * \brief Applies the gateway rules to a received frame, called from the source device's receive callback
+ * \param[in] dispatch the dispatch table for the device the frame was received on
+ * \param[in] message the received frame
+ *
+ * Forwarded frames are transmitted right here on the receive thread using the rule's preallocated message,
+ * rather than being queued to another thread, which keeps the receive to transmit latency as low as possible.
+ */
+void RouteMessage(DeviceDispatch& dispatch, const std::shared_ptr<icsneo::Message>& message) {
+	const auto received = std::chrono::steady_clock::now();
+
+	// Frames we transmitted come back to us as receipts, they must not be forwarded again
+	if(message->transmitted || message->network.getType() != icsneo::Network::Type::CAN)
+		return;
+
+	// A message of type CAN is guaranteed to be a CANMessage, so we can static cast safely
+	auto canMessage = std::static_pointer_cast<icsneo::CANMessage>(message);
+
+	auto network = dispatch.networks.find(static_cast<uint16_t>(canMessage->network.getNetID()));
+	if(network == dispatch.networks.end()) {
+		dispatch.unmatched.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	GatewayRule* rule = nullptr;
+	if(!canMessage->isExtended) {
+		if(canMessage->arbid < 0x800)
+			rule = network->second.standard[canMessage->arbid];
+	} else {
+		auto extended = network->second.extended.find(canMessage->arbid);
+		if(extended != network->second.extended.end())
+			rule = extended->second;
+	}
+	if(rule == nullptr)
+		rule = network->second.any;
+	if(rule == nullptr) {
+		dispatch.unmatched.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	rule->hits.fetch_add(1, std::memory_order_relaxed);
+	if(rule->action == GatewayAction::Drop)
+		return;
+
+	icsneo::CANMessage& forwarded = *rule->forwarded;
+	forwarded.arbid = rule->newArbid == anyArbid ? canMessage->arbid : static_cast<uint32_t>(rule->newArbid);
+	forwarded.isExtended = canMessage->isExtended || forwarded.arbid > 0x7FF;
+	forwarded.isRemote = canMessage->isRemote;
+	forwarded.isCANFD = canMessage->isCANFD;
+	forwarded.baudrateSwitch = canMessage->baudrateSwitch;
+	forwarded.data.assign(canMessage->data.begin(), canMessage->data.end());
+	for(const auto& rewrite : rule->rewrites) {
+		if(rewrite.index < forwarded.data.size())
+			forwarded.data[rewrite.index] = static_cast<uint8_t>((forwarded.data[rewrite.index] & ~rewrite.mask) | (rewrite.value & rewrite.mask));
+	}
+
+	if(!rule->destination->transmit(rule->forwarded))
+		rule->failedTransmits.fetch_add(1, std::memory_order_relaxed);
+
+	rule->latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - received).count());
+}
+
+// Prints the hit count and receive to transmit latency percentiles for each rule
+void PrintReport(const std::vector<std::unique_ptr<GatewayRule>>& rules, const std::vector<std::unique_ptr<DeviceDispatch>>& dispatch) {
+	std::cout << "\t" << std::left << std::setw(28) << "Rule" << std::right << std::setw(10) << "Hits" << std::setw(8) << "Failed";
+	std::cout << std::setw(10) << "p50(us)" << std::setw(10) << "p90(us)" << std::setw(10) << "p99(us)" << std::setw(11) << "p99.9(us)" << std::setw(10) << "Max(us)" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	for(const auto& rule : rules) {
+		std::cout << "\t" << std::left << std::setw(28) << rule->name << std::right;
+		std::cout << std::setw(10) << rule->hits.load() << std::setw(8) << rule->failedTransmits.load();
+		if(rule->action == GatewayAction::Drop || rule->latency.getCount() == 0) {
+			std::cout << std::setw(10) << "-" << std::setw(10) << "-" << std::setw(10) << "-" << std::setw(11) << "-" << std::setw(10) << "-" << std::endl;
+			continue;
+		}
+		std::cout << std::setw(10) << rule->latency.getValueAtPercentile(50) / 1000.0;
+		std::cout << std::setw(10) << rule->latency.getValueAtPercentile(90) / 1000.0;
+		std::cout << std::setw(10) << rule->latency.getValueAtPercentile(99) / 1000.0;
+		std::cout << std::setw(11) << rule->latency.getValueAtPercentile(99.9) / 1000.0;
+		std::cout << std::setw(10) << rule->latency.getMax() / 1000.0 << std::endl;
+	}
+	std::cout.unsetf(std::ios_base::floatfield);
+
+	for(size_t i = 0; i < dispatch.size(); i++)
+		std::cout << "\tDevice " << i << ": " << dispatch[i]->unmatched.load() << " frames matched no rule" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	// The run length in seconds may be given as the first argument
+	std::chrono::seconds duration(30);
+	if(argc > 1)
+		duration = std::chrono::seconds(std::max(1, atoi(argv[1])));
+
+	std::cout << "Running libicsneo " << icsneo::GetVersion() << std::endl;
+
+	std::cout << "\nFinding devices... " << std::flush;
+	auto found = icsneo::FindAllDevices();
+	std::cout << "OK, " << found.size() << " device" << (found.size() == 1 ? "" : "s") << " found" << std::endl;
+
+	// The first two devices are used, rules refer to them as device 0 and device 1
+	std::vector<std::shared_ptr<icsneo::Device>> devices;
+	for(auto& device : found) {
+		if(devices.size() == 2)
+			break;
+
+		std::cout << "Connecting to " << device->getType() << ' ' << device->getSerial() << "... ";
+		if(!device->open()) {
+			std::cout << "FAIL" << std::endl;
+			std::cout << icsneo::GetLastError() << std::endl;
+			continue;
+		}
+		if(!device->goOnline()) {
+			std::cout << "FAIL" << std::endl;
+			std::cout << icsneo::GetLastError() << std::endl;
+			device->close();
+			continue;
+		}
+		std::cout << "OK, device " << devices.size() << std::endl;
+		devices.push_back(device);
+	}
+	if(devices.empty())
+		return 1;
+
+	// The gateway configuration, edit these to suit your setup
+	std::vector<std::unique_ptr<GatewayRule>> rules;
+	rules.push_back(ForwardRule("HSCAN 0x100 to MSCAN", 0, icsneo::Network::NetID::HSCAN, 0x100, 0, icsneo::Network::NetID::MSCAN));
+	rules.push_back(ForwardRule("HSCAN 0x200 to MSCAN 0x210", 0, icsneo::Network::NetID::HSCAN, 0x200, 0, icsneo::Network::NetID::MSCAN, 0x210));
+	rules.push_back(DropRule("Drop HSCAN 0x300", 0, icsneo::Network::NetID::HSCAN, 0x300));
+	rules.push_back(DropRule("Drop HSCAN extended 0x300", 0, icsneo::Network::NetID::HSCAN, 0x300, true)); // Extended IDs are matched separately from standard ones
+	rules.push_back(ForwardRule("MSCAN 0x400 to HSCAN", 0, icsneo::Network::NetID::MSCAN, 0x400, 0, icsneo::Network::NetID::HSCAN));
+	rules.back()->rewrites.push_back({0, 0xFF, 0x55}); // Replace byte 0
+	rules.back()->rewrites.push_back({1, 0x0F, 0x00}); // Clear the low nibble of byte 1
+	rules.push_back(ForwardRule("Other HSCAN to device 1", 0, icsneo::Network::NetID::HSCAN, anyArbid, 1, icsneo::Network::NetID::HSCAN));
+	rules.push_back(ForwardRule("Device 1 HSCAN to device 0", 1, icsneo::Network::NetID::HSCAN, anyArbid, 0, icsneo::Network::NetID::HSCAN));
+
+	auto dispatch = CompileRules(rules, devices);
+
+	std::vector<int> callbacks;
+	for(size_t i = 0; i < devices.size(); i++) {
+		DeviceDispatch* deviceDispatch = dispatch[i].get();
+		callbacks.push_back(devices[i]->addMessageCallback(icsneo::MessageCallback([deviceDispatch](std::shared_ptr<icsneo::Message> message) {
+			RouteMessage(*deviceDispatch, message);
+		})));
+	}
+
+	std::cout << "\tGatewaying traffic for " << duration.count() << " seconds... " << std::endl;
+	std::this_thread::sleep_for(duration);
+
+	for(size_t i = 0; i < devices.size(); i++)
+		devices[i]->removeMessageCallback(callbacks[i]);
+
+	PrintReport(rules, dispatch);
+
+	for(auto& device : devices) {
+		std::cout << "\tDisconnecting from " << device->getType() << ' ' << device->getSerial() << "... ";
+		device->goOffline();
+		std::cout << (device->close() ? "OK" : "FAIL") << std::endl;
+	}
+	std::cout << std::endl;
+	return 0;
+}
@@ -1,17 +1,98 @@
 #include <iostream>
+#include <iomanip>
 #include <string>
+#include <sstream>
+#include <cstring>
 #include <ctype.h>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#endif
 
 // Include icsneo/icsneocpp.h to access library functions
 #include "icsneo/icsneocpp.h"
+#include "SettingsTransaction.h"
 
 size_t msgLimit = 50000;
 std::vector<std::shared_ptr<icsneo::Device>> devices;
 std::map<std::shared_ptr<icsneo::Device>, std::vector<int>> callbacks;
 std::shared_ptr<icsneo::Device> selectedDevice;
 
+// Bus monitor settings, the table holds at most this many (netid, arbid) rows
+const size_t monitorMaxRows = 512;
+const std::chrono::milliseconds monitorRefreshInterval(100);
+const std::chrono::milliseconds monitorPlainRefreshInterval(1000); // Plain output scrolls, so it is printed less often
+const size_t monitorPrintedBytes = 16; // CAN FD payloads are truncated on screen, change tracking covers all 64 bytes
+
+/**
+ * \brief One row of the bus monitor table, the latest state for a single (netid, arbid)
+ *
+ * The receive callback is the only writer. The render thread only reads, using the sequence counter
+ * as a seqlock (odd while a write is in progress) so that neither side ever waits on the other.
+ */
+struct MonitorRow {
+	// Set once before the row is published through MonitorSession::rowCount
+	uint16_t netid = 0;
+	uint32_t arbid = 0;
+	bool isExtended = false;
+
+	std::atomic<uint32_t> sequence;
+	std::atomic<uint64_t> count;
+	std::atomic<uint8_t> length;
+	std::atomic<uint64_t> changedMask; // Bit n set if byte n differed from the previous frame
+	std::array<std::atomic<uint64_t>, 8> payload; // Up to 64 bytes, packed 8 per word
+	std::atomic<bool> dirty;
+
+	MonitorRow() : sequence(0), count(0), length(0), changedMask(0), dirty(false) {
+		for(auto& word : payload)
+			word.store(0, std::memory_order_relaxed);
+	}
+};
+
+// A consistent copy of a MonitorRow, taken by the render thread
+struct MonitorSnapshot {
+	uint64_t count;
+	uint8_t length;
+	uint64_t changedMask;
+	uint8_t payload[64];
+};
+
+// Render-side bookkeeping for a row, only touched by the render thread
+struct MonitorRowView {
+	uint64_t countAtLastRate = 0;
+	uint64_t rate = 0;
+	bool drawn = false;
+};
+
+struct MonitorSession {
+	std::unique_ptr<MonitorRow[]> rows;
+	std::atomic<size_t> rowCount;
+	std::unordered_map<uint64_t, size_t> index; // Only touched by the receive callback
+	std::atomic<uint64_t> totalCount;
+	std::atomic<uint64_t> otherCount; // Non-CAN traffic, counted but not tabulated
+	std::atomic<uint64_t> overflowCount; // Frames for new IDs once the table is full
+
+	MonitorSession() : rows(new MonitorRow[monitorMaxRows]), rowCount(0), totalCount(0), otherCount(0), overflowCount(0) {
+		// Reserving up front means an insert never rehashes on the receive path
+		index.reserve(monitorMaxRows);
+	}
+};
+
 /**
  * \brief Prints all current known devices to output in the following format:
  * [num] DeviceType SerialNum    Connected: Yes/No    Online: Yes/No    Msg Polling: On/Off
@@ -47,6 +128,7 @@ void printMainMenu() {
 	std::cout << "I - Set HS CAN to 250K" << std::endl;
 	std::cout << "J - Set LSFT CAN to 250K" << std::endl;
 	std::cout << "K - Add/Remove a message callback" << std::endl;
+	std::cout << "L - Monitor bus" << std::endl;
 	std::cout << "X - Exit" << std::endl;
 }
 
@@ -185,13 +267,317 @@ std::shared_ptr<icsneo::Device> selectDevice() {
 	return devices.at(selectedDeviceNum - 1);
 }
 
+/**
+ * \brief Records a received message into the bus monitor table
+ * \param[in] session the monitor session to update
+ * \param[in] msg the message that was received
+ *
+ * Called from the receive callback. This does a single hash lookup and a fixed amount of copying,
+ * and never waits on the render thread, so the redraw rate has no effect on how fast messages are taken in.
+ */
+void monitorIngest(MonitorSession& session, const std::shared_ptr<icsneo::Message>& msg) {
+	session.totalCount.fetch_add(1, std::memory_order_relaxed);
+
+	if(msg->network.getType() != icsneo::Network::Type::CAN) {
+		session.otherCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	// A message of type CAN is guaranteed to be a CANMessage, so we can static cast safely
+	auto canMsg = std::static_pointer_cast<icsneo::CANMessage>(msg);
+	uint16_t netid = static_cast<uint16_t>(canMsg->network.getNetID());
+	uint64_t key = (static_cast<uint64_t>(netid) << 32) | (canMsg->isExtended ? 0x80000000 : 0) | canMsg->arbid;
+
+	MonitorRow* row;
+	auto found = session.index.find(key);
+	if(found == session.index.end()) {
+		size_t rowIndex = session.rowCount.load(std::memory_order_relaxed);
+		if(rowIndex >= monitorMaxRows) {
+			session.overflowCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		row = &session.rows[rowIndex];
+		row->netid = netid;
+		row->arbid = canMsg->arbid;
+		row->isExtended = canMsg->isExtended;
+		session.index.emplace(key, rowIndex);
+		// Publishes the identity fields above to the render thread
+		session.rowCount.store(rowIndex + 1, std::memory_order_release);
+	} else {
+		row = &session.rows[found->second];
+	}
+
+	uint64_t words[8] = {};
+	size_t length = std::min<size_t>(canMsg->data.size(), 64);
+	memcpy(words, canMsg->data.data(), length);
+
+	bool firstFrame = row->count.load(std::memory_order_relaxed) == 0;
+	uint64_t changedMask = 0;
+
+	uint32_t sequence = row->sequence.load(std::memory_order_relaxed);
+	row->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for(size_t word = 0; word < 8; word++) {
+		uint64_t diff = row->payload[word].load(std::memory_order_relaxed) ^ words[word];
+		for(size_t byte = 0; diff != 0; byte++, diff >>= 8) {
+			if(diff & 0xFF)
+				changedMask |= 1ull << (word * 8 + byte);
+		}
+		row->payload[word].store(words[word], std::memory_order_relaxed);
+	}
+
+	// Bytes past the end of the previous frame count as changed
+	uint8_t previousLength = row->length.load(std::memory_order_relaxed);
+	for(size_t byte = previousLength; byte < length; byte++)
+		changedMask |= 1ull << byte;
+
+	row->length.store(static_cast<uint8_t>(length), std::memory_order_relaxed);
+	row->changedMask.store(firstFrame ? 0 : changedMask, std::memory_order_relaxed);
+	row->count.store(row->count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	row->sequence.store(sequence + 2, std::memory_order_release);
+	row->dirty.store(true, std::memory_order_release);
+}
+
+/**
+ * \brief Takes a consistent copy of a monitor row without blocking the writer
+ * \param[in] row the row to read
+ * \param[out] snapshot the copy of the row
+ *
+ * If the receive callback updates the row while we are reading, the copy is simply retried.
+ */
+void monitorReadRow(const MonitorRow& row, MonitorSnapshot& snapshot) {
+	while(true) {
+		uint32_t before = row.sequence.load(std::memory_order_acquire);
+		if(before & 1) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		snapshot.count = row.count.load(std::memory_order_relaxed);
+		snapshot.length = row.length.load(std::memory_order_relaxed);
+		snapshot.changedMask = row.changedMask.load(std::memory_order_relaxed);
+		for(size_t word = 0; word < 8; word++) {
+			uint64_t value = row.payload[word].load(std::memory_order_relaxed);
+			memcpy(snapshot.payload + word * 8, &value, sizeof(value));
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if(row.sequence.load(std::memory_order_relaxed) == before)
+			return;
+	}
+}
+
+/**
+ * \brief Whether the console can draw the bus monitor, and what to put back once it is done
+ */
+struct MonitorConsole {
+	bool ansi = true; // False if ANSI escape sequences would be printed as text, the monitor then prints plain lines
+#ifdef _WIN32
+	HANDLE handle = INVALID_HANDLE_VALUE;
+	DWORD previousMode = 0;
+#endif
+};
+
+/**
+ * \brief Prepares the console for the ANSI escape sequences the bus monitor draws with
+ * \returns the state to pass to monitorCloseConsole()
+ *
+ * The Windows console only interprets them once ENABLE_VIRTUAL_TERMINAL_PROCESSING is set, which needs Windows 10.
+ * On older versions, or when the output is not a console, the monitor falls back to plain output.
+ */
+MonitorConsole monitorOpenConsole() {
+	MonitorConsole console;
+#ifdef _WIN32
+	console.handle = GetStdHandle(STD_OUTPUT_HANDLE);
+	console.ansi = console.handle != INVALID_HANDLE_VALUE && GetConsoleMode(console.handle, &console.previousMode)
+		&& SetConsoleMode(console.handle, console.previousMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+	return console;
+}
+
+/**
+ * \brief Puts the console back the way monitorOpenConsole() found it
+ */
+void monitorCloseConsole(const MonitorConsole& console) {
+#ifdef _WIN32
+	if(console.ansi)
+		SetConsoleMode(console.handle, console.previousMode);
+#else
+	(void)console;
+#endif
+}
+
+/**
+ * \brief Appends the ANSI escape sequence which moves the cursor to the start of the given line
+ * \param[out] out the buffer to append to
+ * \param[in] line the 1-based terminal line
+ * \param[in] ansi false to start a new line instead, for consoles without ANSI support
+ */
+void monitorMoveTo(std::string& out, size_t line, bool ansi) {
+	if(ansi)
+		out += "\x1b[" + std::to_string(line) + ";1H";
+	else
+		out += '\n';
+}
+
+/**
+ * \brief Redraws every row of the bus monitor table which changed since the last call
+ * \param[in] session the monitor session to draw
+ * \param[in,out] views the render-side state for each row
+ * \param[in] updateRates true if the per-row rates should be recalculated on this refresh
+ * \param[in] rateWindow the time elapsed since the rates were last recalculated
+ * \param[in] ansi false to print the status line and the changed rows as plain lines, without escape sequences
+ *
+ * Rows keep a fixed screen line in the order their ID was first seen, so a row can be redrawn in place
+ * by positioning the cursor rather than repainting the whole screen.
+ */
+void monitorRender(MonitorSession& session, std::vector<MonitorRowView>& views, bool updateRates, std::chrono::steady_clock::duration rateWindow, bool ansi) {
+	static const char* hexDigits = "0123456789abcdef";
+	const size_t firstRowLine = 3;
+	std::string out;
+	MonitorSnapshot snapshot;
+
+	// Status line
+	monitorMoveTo(out, 2, ansi);
+	out += "Frames: " + std::to_string(session.totalCount.load(std::memory_order_relaxed));
+	out += "  IDs: " + std::to_string(session.rowCount.load(std::memory_order_acquire));
+	out += "  Non-CAN: " + std::to_string(session.otherCount.load(std::memory_order_relaxed));
+	out += "  Table full: " + std::to_string(session.overflowCount.load(std::memory_order_relaxed));
+	if(ansi)
+		out += "\x1b[K";
+
+	size_t rowCount = session.rowCount.load(std::memory_order_acquire);
+	for(size_t i = 0; i < rowCount; i++) {
+		MonitorRow& row = session.rows[i];
+		MonitorRowView& view = views[i];
+		bool redraw = row.dirty.exchange(false, std::memory_order_acquire) || !view.drawn;
+
+		if(updateRates) {
+			uint64_t count = row.count.load(std::memory_order_relaxed);
+			auto windowMs = std::chrono::duration_cast<std::chrono::milliseconds>(rateWindow).count();
+			uint64_t rate = windowMs > 0 ? (count - view.countAtLastRate) * 1000 / windowMs : 0;
+			view.countAtLastRate = count;
+			if(rate != view.rate) {
+				view.rate = rate;
+				redraw = true;
+			}
+		}
+
+		if(!redraw)
+			continue;
+		view.drawn = true;
+
+		monitorReadRow(row, snapshot);
+
+		std::ostringstream line;
+		line << std::left << std::setw(10) << icsneo::Network::GetNetIDString(static_cast<icsneo::Network::NetID>(row.netid)) << std::right;
+		line << "0x" << std::hex << std::setfill('0') << std::setw(row.isExtended ? 8 : 3) << row.arbid << std::setfill(' ') << std::dec;
+		line << (row.isExtended ? " " : "      ") << "[" << std::setw(2) << (int) snapshot.length << "] ";
+		monitorMoveTo(out, firstRowLine + i, ansi);
+		out += line.str();
+
+		for(size_t byte = 0; byte < monitorPrintedBytes; byte++) {
+			if(byte >= snapshot.length) {
+				out += "   ";
+				continue;
+			}
+			bool changed = ansi && ((snapshot.changedMask >> byte) & 1);
+			if(changed)
+				out += "\x1b[7m"; // Reverse video for bytes which changed in the latest frame
+			out += hexDigits[snapshot.payload[byte] >> 4];
+			out += hexDigits[snapshot.payload[byte] & 0xF];
+			if(changed)
+				out += "\x1b[0m";
+			out += ' ';
+		}
+		out += snapshot.length > monitorPrintedBytes ? ".. " : "   ";
+
+		line.str("");
+		line << std::setw(10) << snapshot.count << std::setw(8) << view.rate << "/s";
+		out += line.str();
+		if(ansi)
+			out += "\x1b[K";
+	}
+
+	// Park the cursor below the table
+	monitorMoveTo(out, firstRowLine + rowCount, ansi);
+	std::cout.write(out.data(), out.size());
+	std::cout.flush();
+}
+
+/**
+ * \brief Shows a live table of the traffic on a device until the user presses Enter
+ * \param[in] device the device to monitor, it should already be online
+ *
+ * Each (netid, arbid) gets one row holding the latest payload, a frame count, a rate and the bytes
+ * which changed in the latest frame. Receiving and drawing happen on separate threads, and only rows
+ * which changed are redrawn, at a fixed refresh rate no matter how busy the bus is.
+ */
+void runBusMonitor(std::shared_ptr<icsneo::Device> device) {
+	MonitorSession session;
+	std::vector<MonitorRowView> views(monitorMaxRows);
+	std::atomic<bool> stop(false);
+
+	int callbackID = device->addMessageCallback(icsneo::MessageCallback([&session](std::shared_ptr<icsneo::Message> msg) {
+		monitorIngest(session, msg);
+	}));
+
+	if(callbackID == -1) {
+		std::cout << "Failed to add message callback to " << device->describe() << "!" << std::endl << std::endl;
+		std::cout << icsneo::GetLastError() << std::endl << std::endl;
+		return;
+	}
+
+	// Clear the screen, hide the cursor and draw the headers
+	const MonitorConsole console = monitorOpenConsole();
+	if(console.ansi)
+		std::cout << "\x1b[2J\x1b[?25l\x1b[1;1HMonitoring " << device->describe() << ", press Enter to stop" << std::flush;
+	else
+		std::cout << "Monitoring " << device->describe() << ", press Enter to stop. Changed rows are printed every second." << std::endl;
+	const auto refreshInterval = console.ansi ? monitorRefreshInterval : monitorPlainRefreshInterval;
+
+	std::thread renderThread([&]() {
+		auto nextRefresh = std::chrono::steady_clock::now();
+		auto lastRateUpdate = nextRefresh;
+		while(!stop.load()) {
+			nextRefresh += refreshInterval;
+			std::this_thread::sleep_until(nextRefresh);
+
+			auto now = std::chrono::steady_clock::now();
+			bool updateRates = now - lastRateUpdate >= std::chrono::seconds(1);
+			monitorRender(session, views, updateRates, now - lastRateUpdate, console.ansi);
+			if(updateRates)
+				lastRateUpdate = now;
+		}
+	});
+
+	// Discard the rest of the menu selection line, then wait for Enter
+	std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+	std::cin.get();
+
+	// Stop the writer before the reader so the final draw is complete
+	device->removeMessageCallback(callbackID);
+	stop.store(true);
+	renderThread.join();
+	monitorRender(session, views, false, std::chrono::steady_clock::duration::zero(), console.ansi);
+
+	if(console.ansi)
+		std::cout << "\x1b[?25h";
+	std::cout << std::endl;
+	monitorCloseConsole(console);
+	std::cout << session.totalCount.load() << " frames on " << session.rowCount.load() << " IDs monitored" << std::endl << std::endl;
+}
+
 int main() {
 	std::cout << "Running libicsneo " << icsneo::GetVersion() << std::endl << std::endl;
 
 	while(true) {
 		printMainMenu();
 		std::cout << std::endl;
-		char input = getCharInput(std::vector<char> {'A', 'a', 'B', 'b', 'C', 'c', 'D', 'd', 'E', 'e', 'F', 'f', 'G', 'g', 'H', 'h', 'I', 'i', 'J', 'j', 'K', 'k', 'X', 'x'});
+		char input = getCharInput(std::vector<char> {'A', 'a', 'B', 'b', 'C', 'c', 'D', 'd', 'E', 'e', 'F', 'f', 'G', 'g', 'H', 'h', 'I', 'i', 'J', 'j', 'K', 'k', 'L', 'l', 'X', 'x'});
 		std::cout << std::endl;
 
 		switch(input) {
@@ -486,9 +872,14 @@ int main() {
 			}
 			selectedDevice = selectDevice();
 
-			// Attempt to set baudrate and apply settings
-			if(selectedDevice->settings->setBaudrateFor(icsneo::Network::NetID::HSCAN, 250000) && selectedDevice->settings->apply()) {
+			// Attempt to set baudrate and apply settings, a permanent commit always writes EEPROM, even if the device is already running at 250k
+			SettingsTransaction transaction(*selectedDevice);
+			transaction.setBaudrateFor(icsneo::Network::NetID::HSCAN, 250000);
+			SettingsTransaction::Report report;
+			if(transaction.commit(false, &report)) {
 				std::cout << "Successfully set HS CAN baudrate for " << selectedDevice->describe() << " to 250k!" << std::endl;
+				std::cout << report.changed << " of " << report.recorded << " changed, " << report.applies << " applied, "
+					<< report.appliesSaved() << " applies saved" << std::endl;
 			} else {
 				std::cout << "Failed to set HS CAN baudrate for " << selectedDevice->describe() << " to 250k!" << std::endl << std::endl;
 				std::cout << icsneo::GetLastError() << std::endl;;
@@ -507,9 +898,14 @@ int main() {
 			}
 			selectedDevice = selectDevice();
 
-			// Attempt to set baudrate and apply settings
-			if(selectedDevice->settings->setBaudrateFor(icsneo::Network::NetID::LSFTCAN, 250000) && selectedDevice->settings->apply()) {
+			// Attempt to set baudrate and apply settings, a permanent commit always writes EEPROM, even if the device is already running at 250k
+			SettingsTransaction transaction(*selectedDevice);
+			transaction.setBaudrateFor(icsneo::Network::NetID::LSFTCAN, 250000);
+			SettingsTransaction::Report report;
+			if(transaction.commit(false, &report)) {
 				std::cout << "Successfully set LSFT CAN baudrate for " << selectedDevice->describe() << " to 250k!" << std::endl;
+				std::cout << report.changed << " of " << report.recorded << " changed, " << report.applies << " applied, "
+					<< report.appliesSaved() << " applies saved" << std::endl;
 			} else {
 				std::cout << "Failed to set LSFT CAN baudrate for " << selectedDevice->describe() << " to 250k!" << std::endl << std::endl;
 				std::cout << icsneo::GetLastError() << std::endl;;
@@ -603,6 +999,25 @@ int main() {
 			}
 		}
 		break;
+		// Monitor bus
+		case 'L':
+		case 'l':
+		{
+			// Select a device and get its description
+			if(devices.size() == 0) {
+				std::cout << "No devices found! Please scan for new devices." << std::endl << std::endl;
+				break;
+			}
+			selectedDevice = selectDevice();
+
+			if(!selectedDevice->isOnline()) {
+				std::cout << selectedDevice->describe() << " must be online to monitor the bus!" << std::endl << std::endl;
+				break;
+			}
+
+			runBusMonitor(selectedDevice);
+		}
+		break;
 		// Exit
 		case 'X':
 		case 'x':
@@ -0,0 +1,88 @@
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+
+#include "icsneo/icsneocpp.h"
+#include "LatencyInstrumentation.h"
+
+int main(int argc, char** argv) {
+	// Arguments: [run length in seconds] [time one in this many messages] [CSV file to export to]
+	std::chrono::seconds duration(10);
+	uint32_t sampleEvery = 1;
+	std::string csvPath = "latency.csv";
+	if(argc > 1)
+		duration = std::chrono::seconds(std::max(1, atoi(argv[1])));
+	if(argc > 2)
+		sampleEvery = static_cast<uint32_t>(std::max(1, atoi(argv[2])));
+	if(argc > 3)
+		csvPath = argv[3];
+
+	std::cout << "Running libicsneo " << icsneo::GetVersion() << std::endl;
+
+	std::cout << "\nFinding devices... " << std::flush;
+	auto devices = icsneo::FindAllDevices();
+	std::cout << "OK, " << devices.size() << " device" << (devices.size() == 1 ? "" : "s") << " found" << std::endl;
+	if(devices.empty())
+		return 1;
+
+	auto device = devices.front();
+	std::cout << "Connecting to " << device->getType() << ' ' << device->getSerial() << "... ";
+	if(!device->open()) {
+		std::cout << "FAIL" << std::endl;
+		std::cout << icsneo::GetLastError() << std::endl;
+		return 1;
+	}
+	std::cout << "OK" << std::endl;
+
+	std::cout << "\tGoing online... ";
+	if(!device->goOnline()) {
+		std::cout << "FAIL" << std::endl;
+		std::cout << icsneo::GetLastError() << std::endl;
+		device->close();
+		return 1;
+	}
+	std::cout << "OK" << std::endl;
+
+	LatencyInstrumentation instrumentation(sampleEvery);
+
+	// Stands in for the application's processing, replace it with your own handler
+	std::atomic<uint64_t> received(0);
+	std::atomic<uint64_t> checksum(0);
+	auto handler = [&received, &checksum](std::shared_ptr<icsneo::Message> message) {
+		uint64_t sum = 0;
+		for(auto byte : message->data)
+			sum += byte;
+		checksum.fetch_add(sum, std::memory_order_relaxed);
+		received.fetch_add(1, std::memory_order_relaxed);
+	};
+
+	int callbackID = device->addMessageCallback(instrumentation.instrument(handler));
+
+	std::cout << "\tMeasuring latency for " << duration.count() << " seconds, timing one in every " << instrumentation.getSampleEvery() << " messages... " << std::endl;
+	std::this_thread::sleep_for(duration);
+	device->removeMessageCallback(callbackID);
+
+	std::cout << "\tReceived " << received.load() << " messages" << std::endl;
+	instrumentation.printReport(std::cout);
+
+	std::cout << "\tExporting percentiles to " << csvPath << "... ";
+	std::ofstream csv(csvPath);
+	if(csv) {
+		instrumentation.exportCsv(csv);
+		std::cout << "OK" << std::endl;
+	} else {
+		std::cout << "FAIL" << std::endl;
+	}
+
+	std::cout << "\tDisconnecting... ";
+	device->goOffline();
+	std::cout << (device->close() ? "OK" : "FAIL") << std::endl;
+	std::cout << std::endl;
+	return 0;
+}
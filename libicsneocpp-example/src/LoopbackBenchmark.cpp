@@ -0,0 +1,644 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <random>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#include "icsneo/icsneocpp.h"
+#include "LatencyHistogram.h"
+
+// Identifies our frames in the payload, so other traffic on the bus is never mistaken for an echo
+const uint32_t tagMagic = 0x1C5E0000;
+
+// Local experimental EtherType (IEEE 802), used for the Ethernet frames
+const uint16_t benchmarkEtherType = 0x88B5;
+
+enum class BenchmarkBus {
+	CAN,
+	CANFD,
+	Ethernet
+};
+
+enum class ReceiveMode {
+	Callback, // Echoes are matched in the message callback
+	Poll // Echoes are matched by a thread calling getMessages
+};
+
+struct BenchmarkOptions {
+	BenchmarkBus bus = BenchmarkBus::CAN;
+	icsneo::Network::NetID netid = icsneo::Network::NetID::HSCAN;
+	bool netidGiven = false;
+	uint32_t rate = 1000; // Frames per second, 0 sends as fast as transmit() returns
+	size_t size = 0; // Payload bytes, 0 picks the largest frame for the bus
+	uint32_t count = 10000;
+	ReceiveMode mode = ReceiveMode::Callback;
+	std::chrono::milliseconds drainTimeout = std::chrono::milliseconds(1000);
+	double maxLossPercent = 100.0;
+	bool simulated = false;
+	uint64_t seed = 1;
+	uint32_t dropEvery = 0; // Simulated only, drops every Nth frame
+};
+
+/**
+ * What the benchmark transmits on and receives echoes from. This is either a real device,
+ * or a simulated one which echoes frames back with a deterministic, modelled latency.
+ */
+class LoopbackTarget {
+public:
+	typedef std::function<void(std::shared_ptr<icsneo::Message>)> Receiver;
+
+	virtual ~LoopbackTarget() = default;
+	virtual std::string describe() const = 0;
+	virtual bool transmit(const std::shared_ptr<icsneo::Message>& message) = 0;
+
+	// Callback mode, a null receiver stops delivery. Returns once any call to the previous receiver has finished.
+	virtual void setReceiver(Receiver receiver) = 0;
+
+	// Poll mode
+	virtual bool enablePolling() = 0;
+	virtual bool poll(std::vector<std::shared_ptr<icsneo::Message>>& messages, std::chrono::milliseconds timeout) = 0;
+};
+
+class DeviceTarget : public LoopbackTarget {
+public:
+	DeviceTarget(std::shared_ptr<icsneo::Device> device) : device(device) {}
+	~DeviceTarget() { setReceiver(nullptr); }
+
+	std::string describe() const override { return device->describe(); }
+	bool transmit(const std::shared_ptr<icsneo::Message>& message) override { return device->transmit(message); }
+
+	void setReceiver(Receiver receiver) override {
+		if(callbackID != -1) {
+			device->removeMessageCallback(callbackID);
+			callbackID = -1;
+		}
+		if(receiver)
+			callbackID = device->addMessageCallback(icsneo::MessageCallback(receiver));
+	}
+
+	bool enablePolling() override {
+		if(!device->enableMessagePolling())
+			return false;
+		device->setPollingMessageLimit(100000);
+		return true;
+	}
+	bool poll(std::vector<std::shared_ptr<icsneo::Message>>& messages, std::chrono::milliseconds timeout) override {
+		return device->getMessages(messages, 0, timeout);
+	}
+
+private:
+	std::shared_ptr<icsneo::Device> device;
+	int callbackID = -1;
+};
+
+/**
+ * Echoes every transmitted frame back as a transmit receipt after a modelled delay: the time on the wire
+ * at typical bitrates, queueing behind earlier frames when the bus is saturated, a fixed host path cost and
+ * pseudo-random jitter with the occasional long stall. Everything is derived from the seed, so the echo
+ * schedule, and any frames dropped with dropEvery, are identical from run to run.
+ */
+class SimulatedTarget : public LoopbackTarget {
+public:
+	SimulatedTarget(uint64_t seed, uint32_t dropEvery) : random(seed), dropEvery(dropEvery) {
+		delivery = std::thread(&SimulatedTarget::deliveryThread, this);
+	}
+	~SimulatedTarget() {
+		{
+			std::lock_guard<std::mutex> lk(mutex);
+			stopping = true;
+		}
+		pendingCV.notify_all();
+		delivery.join();
+	}
+
+	std::string describe() const override { return "Simulated Device"; }
+
+	bool transmit(const std::shared_ptr<icsneo::Message>& message) override {
+		const auto now = std::chrono::steady_clock::now();
+		std::shared_ptr<icsneo::Message> echo = copyAsReceipt(*message);
+
+		std::lock_guard<std::mutex> lk(mutex);
+		if(dropEvery != 0 && ++transmitted % dropEvery == 0)
+			return true; // Lost on the bus, as far as the host can tell
+
+		// The frame waits for the bus to be free, then spends its wire time on it
+		const auto start = std::max(now, busFreeAt);
+		busFreeAt = start + wireTime(*message);
+
+		// 120us fixed host path cost, up to 60us of jitter, and a 1ms stall one time in a thousand
+		uint64_t draw = random();
+		std::chrono::nanoseconds hostPath(120000 + static_cast<int64_t>(draw % 60000));
+		if((draw >> 32) % 1000 == 0)
+			hostPath += std::chrono::milliseconds(1);
+
+		// The host path delivers in order, so a stall holds up every frame behind it as well
+		lastDue = std::max(lastDue, busFreeAt + hostPath);
+		pending.push_back(Pending{lastDue, echo});
+		pendingCV.notify_all();
+		return true;
+	}
+
+	void setReceiver(Receiver newReceiver) override {
+		std::unique_lock<std::mutex> lk(mutex);
+		receiver = newReceiver;
+		// The delivery thread may still be inside the old receiver, which can call this itself
+		if(std::this_thread::get_id() != delivery.get_id())
+			idleCV.wait(lk, [this]() { return !delivering; });
+	}
+
+	bool enablePolling() override {
+		std::lock_guard<std::mutex> lk(mutex);
+		polling = true;
+		return true;
+	}
+	bool poll(std::vector<std::shared_ptr<icsneo::Message>>& messages, std::chrono::milliseconds timeout) override {
+		std::unique_lock<std::mutex> lk(mutex);
+		pollCV.wait_for(lk, timeout, [this]() { return !pollQueue.empty(); });
+		messages.assign(pollQueue.begin(), pollQueue.end());
+		pollQueue.clear();
+		return true;
+	}
+
+private:
+	struct Pending {
+		std::chrono::steady_clock::time_point due;
+		std::shared_ptr<icsneo::Message> message;
+	};
+
+	static std::shared_ptr<icsneo::Message> copyAsReceipt(const icsneo::Message& message) {
+		std::shared_ptr<icsneo::Message> copy;
+		switch(message.network.getType()) {
+			case icsneo::Network::Type::CAN:
+				copy = std::make_shared<icsneo::CANMessage>(static_cast<const icsneo::CANMessage&>(message));
+				break;
+			case icsneo::Network::Type::Ethernet:
+				copy = std::make_shared<icsneo::EthernetMessage>(static_cast<const icsneo::EthernetMessage&>(message));
+				break;
+			default:
+				copy = std::make_shared<icsneo::Message>(message);
+				break;
+		}
+		copy->transmitted = true;
+		return copy;
+	}
+
+	// 500kbit/s CAN, 2Mbit/s CAN FD data phase and 100Mbit/s Ethernet, with a worst case 20% for bit stuffing on CAN
+	static std::chrono::nanoseconds wireTime(const icsneo::Message& message) {
+		const int64_t payloadBits = static_cast<int64_t>(message.data.size()) * 8;
+		if(message.network.getType() == icsneo::Network::Type::Ethernet)
+			return std::chrono::nanoseconds((payloadBits + (8 + 4 + 12) * 8) * 10); // Preamble, FCS and inter-frame gap
+		const auto& can = static_cast<const icsneo::CANMessage&>(message);
+		if(can.isCANFD)
+			return std::chrono::nanoseconds(30 * 2000 + (payloadBits + 28) * 600);
+		return std::chrono::nanoseconds((payloadBits + 47) * 2400);
+	}
+
+	void deliveryThread() {
+		std::unique_lock<std::mutex> lk(mutex);
+		while(!stopping) {
+			if(pending.empty()) {
+				pendingCV.wait(lk);
+				continue;
+			}
+			const auto due = pending.front().due;
+			if(std::chrono::steady_clock::now() < due) {
+				pendingCV.wait_until(lk, due);
+				continue;
+			}
+
+			std::shared_ptr<icsneo::Message> message = pending.front().message;
+			message->timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(due.time_since_epoch()).count());
+			pending.pop_front();
+			if(polling) {
+				pollQueue.push_back(message);
+				pollCV.notify_all();
+			} else if(receiver) {
+				// Deliver outside the lock, as the library does, so the receiver may transmit
+				Receiver deliverTo = receiver;
+				delivering = true;
+				lk.unlock();
+				deliverTo(message);
+				lk.lock();
+				delivering = false;
+				idleCV.notify_all();
+			}
+		}
+	}
+
+	std::mt19937_64 random; // The raw output of mt19937_64 is the same on every standard library
+	const uint32_t dropEvery;
+	uint64_t transmitted = 0;
+	std::chrono::steady_clock::time_point busFreeAt;
+	std::chrono::steady_clock::time_point lastDue;
+
+	std::mutex mutex;
+	std::condition_variable pendingCV;
+	std::condition_variable pollCV;
+	std::condition_variable idleCV; // Notified when a call to the receiver returns
+	std::deque<Pending> pending; // Always in due order
+	std::vector<std::shared_ptr<icsneo::Message>> pollQueue;
+	Receiver receiver;
+	bool polling = false;
+	bool delivering = false;
+	bool stopping = false;
+	std::thread delivery;
+};
+
+/**
+ * Matches echoes to the frames which were sent. Send times are kept in a flat array indexed by sequence number,
+ * stamped right before transmit() is called since the echo may arrive before it returns.
+ */
+class EchoMatcher {
+public:
+	EchoMatcher(uint32_t count, uint32_t runTag, icsneo::Network::NetID netid, size_t tagOffset)
+		: count(count), runTag(runTag), netid(netid), tagOffset(tagOffset), sendTimes(new std::atomic<int64_t>[count]) {
+		for(uint32_t i = 0; i < count; i++)
+			sendTimes[i].store(0, std::memory_order_relaxed);
+	}
+
+	void stampSend(uint32_t sequence) { sendTimes[sequence].store(NowNs(), std::memory_order_release); }
+
+	void onMessage(const std::shared_ptr<icsneo::Message>& message) {
+		if(!message->transmitted || message->network.getNetID() != netid)
+			return;
+
+		const int64_t now = NowNs();
+		if(message->data.size() < tagOffset + 8 || ReadU32(message->data, tagOffset) != runTag) {
+			unmatched++;
+			return;
+		}
+		const uint32_t sequence = ReadU32(message->data, tagOffset + 4);
+		if(sequence >= count) {
+			unmatched++;
+			return;
+		}
+
+		const int64_t sent = sendTimes[sequence].exchange(-1, std::memory_order_acq_rel);
+		if(sent == -1) {
+			duplicates++;
+			return;
+		}
+		if(sent == 0) { // Not sent yet, so it can not be ours
+			sendTimes[sequence].store(0, std::memory_order_relaxed);
+			unmatched++;
+			return;
+		}
+
+		latency.record(static_cast<uint64_t>(now - sent));
+		if(echoed.load(std::memory_order_relaxed) != 0 && sequence < lastSequence)
+			outOfOrder++;
+		lastSequence = sequence;
+		lastEchoNs.store(now, std::memory_order_relaxed);
+		echoed.fetch_add(1, std::memory_order_release);
+	}
+
+	static int64_t NowNs() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	static uint32_t ReadU32(const std::vector<uint8_t>& data, size_t offset) {
+		return static_cast<uint32_t>(data[offset]) | (static_cast<uint32_t>(data[offset + 1]) << 8) |
+			(static_cast<uint32_t>(data[offset + 2]) << 16) | (static_cast<uint32_t>(data[offset + 3]) << 24);
+	}
+
+	const uint32_t count;
+	const uint32_t runTag;
+	const icsneo::Network::NetID netid;
+	const size_t tagOffset;
+
+	LatencyHistogram latency; // transmit() called until the echo was received, in nanoseconds
+	std::atomic<uint64_t> echoed{0};
+	std::atomic<int64_t> lastEchoNs{0};
+
+	// Only touched by the receiving thread
+	uint64_t unmatched = 0;
+	uint64_t duplicates = 0;
+	uint64_t outOfOrder = 0;
+	uint32_t lastSequence = 0;
+
+private:
+	std::unique_ptr<std::atomic<int64_t>[]> sendTimes;
+};
+
+// Writes a little endian 32-bit value into the payload
+void WriteU32(std::vector<uint8_t>& data, size_t offset, uint32_t value) {
+	for(size_t i = 0; i < 4; i++)
+		data[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+}
+
+// CAN FD only allows certain payload lengths above 8 bytes, round up to the next one
+size_t RoundUpToCANFDLength(size_t size) {
+	for(size_t length : {8, 12, 16, 20, 24, 32, 48, 64}) {
+		if(size <= length)
+			return length;
+	}
+	return 64;
+}
+
+/**
+ * \brief Creates the frame the benchmark sends, which is reused for every transmit
+ * \param[in] options the benchmark options, the size is adjusted to what the bus allows
+ * \param[out] tagOffset where the tag starts in the message's data
+ * \returns the message, or nullptr if the payload size can not hold the tag
+ */
+std::shared_ptr<icsneo::Message> MakeBenchmarkFrame(BenchmarkOptions& options, size_t& tagOffset) {
+	std::shared_ptr<icsneo::Message> message;
+	switch(options.bus) {
+		case BenchmarkBus::CAN:
+		case BenchmarkBus::CANFD: {
+			const bool fd = options.bus == BenchmarkBus::CANFD;
+			if(options.size == 0)
+				options.size = fd ? 64 : 8;
+			if(options.size < 8 || options.size > (fd ? 64 : 8))
+				return nullptr;
+			if(fd)
+				options.size = RoundUpToCANFDLength(options.size);
+
+			auto canMessage = std::make_shared<icsneo::CANMessage>();
+			canMessage->arbid = 0x7A5;
+			canMessage->isCANFD = fd;
+			canMessage->baudrateSwitch = fd;
+			tagOffset = 0;
+			message = canMessage;
+			break;
+		}
+		case BenchmarkBus::Ethernet: {
+			if(options.size == 0)
+				options.size = 1500;
+			if(options.size < 46 || options.size > 1500)
+				return nullptr;
+
+			auto ethMessage = std::make_shared<icsneo::EthernetMessage>();
+			ethMessage->data.insert(ethMessage->data.end(), {
+				0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, /* Destination MAC */
+				0x00, 0xFC, 0x70, 0x00, 0x01, 0x01, /* Source MAC */
+				static_cast<uint8_t>(benchmarkEtherType >> 8), static_cast<uint8_t>(benchmarkEtherType & 0xFF) /* EtherType */
+			});
+			tagOffset = ethMessage->data.size();
+			message = ethMessage;
+			break;
+		}
+	}
+
+	message->network = options.netid;
+	message->data.resize(tagOffset + options.size);
+	for(size_t i = tagOffset + 8; i < message->data.size(); i++)
+		message->data[i] = static_cast<uint8_t>(i);
+	return message;
+}
+
+/**
+ * \brief Sends the tagged frames at the configured rate and waits for the echoes
+ * \param[in] target what to send on
+ * \param[in] options the benchmark options
+ * \param[in] frame the frame to send, its tag is updated before each transmit
+ * \param[in] matcher matches the echoes
+ * \param[out] transmitFailures how many transmit() calls returned false
+ * \returns the time the first frame was sent, in nanoseconds
+ */
+int64_t RunBenchmark(LoopbackTarget& target, const BenchmarkOptions& options, std::shared_ptr<icsneo::Message> frame, EchoMatcher& matcher, uint64_t& transmitFailures) {
+	std::atomic<bool> receiving(true);
+	std::thread poller;
+	if(options.mode == ReceiveMode::Callback) {
+		target.setReceiver([&matcher](std::shared_ptr<icsneo::Message> message) { matcher.onMessage(message); });
+	} else {
+		poller = std::thread([&target, &matcher, &receiving]() {
+			std::vector<std::shared_ptr<icsneo::Message>> messages;
+			while(receiving.load()) {
+				if(!target.poll(messages, std::chrono::milliseconds(10)))
+					continue;
+				for(const auto& message : messages)
+					matcher.onMessage(message);
+			}
+		});
+	}
+
+	// Frames are sent on an absolute schedule, so a late frame is followed by an early one rather than slowing the rate
+	const auto start = std::chrono::steady_clock::now();
+	const int64_t firstSend = EchoMatcher::NowNs();
+	for(uint32_t sequence = 0; sequence < options.count; sequence++) {
+		if(options.rate != 0)
+			std::this_thread::sleep_until(start + std::chrono::nanoseconds(static_cast<int64_t>(sequence) * 1000000000 / options.rate));
+
+		WriteU32(frame->data, matcher.tagOffset, matcher.runTag);
+		WriteU32(frame->data, matcher.tagOffset + 4, sequence);
+		matcher.stampSend(sequence);
+		if(!target.transmit(frame))
+			transmitFailures++;
+	}
+
+	// Wait for the outstanding echoes, giving up once none have arrived for the drain timeout
+	uint64_t lastEchoed = matcher.echoed.load();
+	auto lastProgress = std::chrono::steady_clock::now();
+	while(lastEchoed + transmitFailures < options.count && std::chrono::steady_clock::now() - lastProgress < options.drainTimeout) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		uint64_t echoed = matcher.echoed.load();
+		if(echoed != lastEchoed) {
+			lastEchoed = echoed;
+			lastProgress = std::chrono::steady_clock::now();
+		}
+	}
+
+	if(options.mode == ReceiveMode::Callback) {
+		target.setReceiver(nullptr);
+	} else {
+		receiving.store(false);
+		poller.join();
+	}
+	return firstSend;
+}
+
+// Prints the counts, throughput, latency percentiles and the full HDR distribution
+void PrintReport(const BenchmarkOptions& options, const EchoMatcher& matcher, int64_t firstSend, uint64_t transmitFailures, double lossPercent) {
+	const uint64_t echoed = matcher.echoed.load();
+	const double seconds = echoed == 0 ? 0.0 : (matcher.lastEchoNs.load() - firstSend) / 1e9;
+
+	std::cout << "\tSent:        " << options.count - transmitFailures << " (" << transmitFailures << " transmit failures)" << std::endl;
+	std::cout << "\tEchoed:      " << echoed << std::endl;
+	std::cout << "\tLost:        " << options.count - transmitFailures - echoed << std::fixed << std::setprecision(3) << " (" << lossPercent << "%)" << std::endl;
+	std::cout << "\tDuplicates:  " << matcher.duplicates << ", out of order: " << matcher.outOfOrder << ", unmatched: " << matcher.unmatched << std::endl;
+	if(seconds > 0) {
+		std::cout << std::setprecision(1);
+		std::cout << "\tThroughput:  " << echoed / seconds << " frames/s, " << echoed * options.size * 8 / seconds / 1e6 << " Mbit/s of payload" << std::endl;
+	}
+	std::cout << std::setprecision(1);
+	std::cout << "\tLatency(us): p50 " << matcher.latency.getValueAtPercentile(50) / 1000.0;
+	std::cout << ", p90 " << matcher.latency.getValueAtPercentile(90) / 1000.0;
+	std::cout << ", p99 " << matcher.latency.getValueAtPercentile(99) / 1000.0;
+	std::cout << ", p99.9 " << matcher.latency.getValueAtPercentile(99.9) / 1000.0;
+	std::cout << ", max " << matcher.latency.getMax() / 1000.0 << std::endl;
+	std::cout.unsetf(std::ios_base::floatfield);
+
+	std::cout << "\nTransmit to echo latency distribution (us):\n" << std::endl;
+	matcher.latency.printPercentileDistribution(std::cout);
+}
+
+void PrintUsage(const char* name) {
+	std::cout << "Usage: " << name << " [options]\n"
+		<< "\t--bus can|canfd|ethernet   The kind of frames to send (default can)\n"
+		<< "\t--netid <id>               The network to send on (default HSCAN for CAN, Ethernet for Ethernet)\n"
+		<< "\t--rate <frames/s>          The send rate, 0 sends as fast as possible (default 1000)\n"
+		<< "\t--size <bytes>             The payload size, at least 8, or 46 for Ethernet (default the largest frame)\n"
+		<< "\t--count <frames>           How many frames to send (default 10000)\n"
+		<< "\t--mode callback|poll       How echoes are received (default callback)\n"
+		<< "\t--drain-timeout <ms>       How long to wait for outstanding echoes (default 1000)\n"
+		<< "\t--max-loss <percent>       Exit with a failure if more frames than this are lost (default 100)\n"
+		<< "\t--simulated                Use a simulated device, no hardware is needed\n"
+		<< "\t--seed <n>                 The seed for the simulated device (default 1)\n"
+		<< "\t--drop-every <n>           Have the simulated device lose every nth frame (default 0, none)\n";
+}
+
+/**
+ * \brief Parses the command line
+ * \returns false if the arguments were not understood
+ */
+bool ParseOptions(int argc, char** argv, BenchmarkOptions& options) {
+	for(int i = 1; i < argc; i++) {
+		const std::string arg = argv[i];
+		if(arg == "--help")
+			return false;
+		if(arg == "--simulated") {
+			options.simulated = true;
+			continue;
+		}
+		if(i + 1 >= argc)
+			return false;
+		const std::string value = argv[++i];
+
+		if(arg == "--bus") {
+			if(value == "can")
+				options.bus = BenchmarkBus::CAN;
+			else if(value == "canfd")
+				options.bus = BenchmarkBus::CANFD;
+			else if(value == "ethernet")
+				options.bus = BenchmarkBus::Ethernet;
+			else
+				return false;
+		} else if(arg == "--netid") {
+			options.netid = static_cast<icsneo::Network::NetID>(strtoul(value.c_str(), nullptr, 0));
+			options.netidGiven = true;
+		} else if(arg == "--rate") {
+			options.rate = static_cast<uint32_t>(strtoul(value.c_str(), nullptr, 0));
+		} else if(arg == "--size") {
+			options.size = static_cast<size_t>(strtoul(value.c_str(), nullptr, 0));
+		} else if(arg == "--count") {
+			options.count = static_cast<uint32_t>(strtoul(value.c_str(), nullptr, 0));
+		} else if(arg == "--mode") {
+			if(value == "callback")
+				options.mode = ReceiveMode::Callback;
+			else if(value == "poll")
+				options.mode = ReceiveMode::Poll;
+			else
+				return false;
+		} else if(arg == "--drain-timeout") {
+			options.drainTimeout = std::chrono::milliseconds(strtoul(value.c_str(), nullptr, 0));
+		} else if(arg == "--max-loss") {
+			options.maxLossPercent = atof(value.c_str());
+		} else if(arg == "--seed") {
+			options.seed = strtoull(value.c_str(), nullptr, 0);
+		} else if(arg == "--drop-every") {
+			options.dropEvery = static_cast<uint32_t>(strtoul(value.c_str(), nullptr, 0));
+		} else {
+			return false;
+		}
+	}
+
+	if(!options.netidGiven && options.bus == BenchmarkBus::Ethernet)
+		options.netid = icsneo::Network::NetID::Ethernet;
+	return options.count != 0;
+}
+
+int main(int argc, char** argv) {
+	BenchmarkOptions options;
+	if(!ParseOptions(argc, argv, options)) {
+		PrintUsage(argv[0]);
+		return 1;
+	}
+
+	size_t tagOffset = 0;
+	std::shared_ptr<icsneo::Message> frame = MakeBenchmarkFrame(options, tagOffset);
+	if(!frame) {
+		std::cout << "The payload size " << options.size << " is not valid for this bus" << std::endl;
+		PrintUsage(argv[0]);
+		return 1;
+	}
+
+	std::shared_ptr<icsneo::Device> device;
+	std::unique_ptr<LoopbackTarget> target;
+	uint32_t runTag = tagMagic | static_cast<uint32_t>(options.seed & 0xFFFF);
+	if(options.simulated) {
+		target.reset(new SimulatedTarget(options.seed, options.dropEvery));
+	} else {
+		std::cout << "Running libicsneo " << icsneo::GetVersion() << std::endl;
+
+		std::cout << "\nFinding devices... " << std::flush;
+		auto devices = icsneo::FindAllDevices();
+		std::cout << "OK, " << devices.size() << " device" << (devices.size() == 1 ? "" : "s") << " found" << std::endl;
+		if(devices.empty())
+			return 1;
+
+		// We'll use the first device found
+		device = devices.front();
+		std::cout << "Connecting to " << device->getType() << ' ' << device->getSerial() << "... ";
+		if(!device->open()) {
+			std::cout << "FAIL" << std::endl;
+			std::cout << icsneo::GetLastError() << std::endl;
+			return 1;
+		}
+		std::cout << "OK" << std::endl;
+
+		std::cout << "\tGoing online... ";
+		if(!device->goOnline()) {
+			std::cout << "FAIL" << std::endl;
+			std::cout << icsneo::GetLastError() << std::endl;
+			device->close();
+			return 1;
+		}
+		std::cout << "OK" << std::endl;
+
+		// A fresh tag for each run, so echoes of an earlier run still in flight are not matched
+		runTag = tagMagic | (std::random_device()() & 0xFFFF);
+		target.reset(new DeviceTarget(device));
+	}
+
+	if(options.mode == ReceiveMode::Poll && !target->enablePolling()) {
+		std::cout << "Could not enable message polling" << std::endl;
+		return 1;
+	}
+
+	std::cout << "\tSending " << options.count << ' ' << options.size << " byte frames on " << icsneo::Network::GetNetIDString(options.netid);
+	std::cout << " of " << target->describe() << " at " << options.rate << " frames/s, receiving by " << (options.mode == ReceiveMode::Callback ? "callback" : "polling") << "... " << std::endl;
+
+	EchoMatcher matcher(options.count, runTag, options.netid, tagOffset);
+	uint64_t transmitFailures = 0;
+	const int64_t firstSend = RunBenchmark(*target, options, frame, matcher, transmitFailures);
+
+	const uint64_t sent = options.count - transmitFailures;
+	const double lossPercent = sent == 0 ? 100.0 : 100.0 * (sent - matcher.echoed.load()) / sent;
+	PrintReport(options, matcher, firstSend, transmitFailures, lossPercent);
+
+	target.reset();
+	if(device) {
+		std::cout << "\tDisconnecting... ";
+		device->goOffline();
+		std::cout << (device->close() ? "OK" : "FAIL") << std::endl;
+	}
+	std::cout << std::endl;
+
+	if(sent == 0 || lossPercent > options.maxLossPercent) {
+		std::cout << "FAIL, " << lossPercent << "% of frames were lost, the limit is " << options.maxLossPercent << "%" << std::endl;
+		return 1;
+	}
+	return 0;
+}
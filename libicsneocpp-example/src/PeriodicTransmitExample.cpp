@@ -0,0 +1,353 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <array>
+#include <functional>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+
+#include "icsneo/icsneocpp.h"
+
+// The scheduler runs on a 1ms tick, which is the shortest supported period
+const std::chrono::milliseconds tickLength(1);
+
+/**
+ * A mutator modifies a message's payload in place right before each transmit.
+ * They run in the order they were added, so checksums should be added after counters.
+ */
+typedef std::function<void(std::vector<uint8_t>& data)> PayloadMutator;
+
+/**
+ * \brief Creates a mutator which increments a rolling counter held in the low bits of a byte
+ * \param[in] byte the index of the byte holding the counter
+ * \param[in] bits the width of the counter, 4 gives the common 0-15 alive counter
+ */
+PayloadMutator RollingCounter(size_t byte, unsigned int bits) {
+	uint8_t mask = static_cast<uint8_t>((1u << bits) - 1);
+	return [byte, mask](std::vector<uint8_t>& data) {
+		if(byte >= data.size())
+			return;
+		uint8_t counter = (data[byte] + 1) & mask;
+		data[byte] = static_cast<uint8_t>((data[byte] & ~mask) | counter);
+	};
+}
+
+/**
+ * \brief Creates a mutator which stores the XOR of every other byte in the payload
+ * \param[in] byte the index of the byte holding the checksum
+ */
+PayloadMutator XorChecksum(size_t byte) {
+	return [byte](std::vector<uint8_t>& data) {
+		if(byte >= data.size())
+			return;
+		uint8_t checksum = 0;
+		for(size_t i = 0; i < data.size(); i++) {
+			if(i != byte)
+				checksum ^= data[i];
+		}
+		data[byte] = checksum;
+	};
+}
+
+/**
+ * \brief Creates a mutator which stores the SAE J1850 CRC8 (polynomial 0x1D) of every other byte in the payload
+ * \param[in] byte the index of the byte holding the CRC
+ */
+PayloadMutator Crc8SaeJ1850(size_t byte) {
+	return [byte](std::vector<uint8_t>& data) {
+		if(byte >= data.size())
+			return;
+		uint8_t crc = 0xFF;
+		for(size_t i = 0; i < data.size(); i++) {
+			if(i == byte)
+				continue;
+			crc ^= data[i];
+			for(int bit = 0; bit < 8; bit++)
+				crc = static_cast<uint8_t>((crc & 0x80) ? (crc << 1) ^ 0x1D : (crc << 1));
+		}
+		data[byte] = static_cast<uint8_t>(crc ^ 0xFF);
+	};
+}
+
+/**
+ * A message which is sent periodically, along with the bookkeeping the timer wheel and the jitter report need.
+ * The message itself is allocated once and reused for every transmit.
+ */
+struct PeriodicMessage {
+	std::shared_ptr<icsneo::CANMessage> message;
+	uint64_t periodTicks = 0;
+	std::vector<PayloadMutator> mutators;
+
+	// Timer wheel state
+	uint64_t dueTick = 0;
+	int next = -1; // Index of the next message in the same wheel slot, -1 for the end of the list
+
+	// Jitter statistics, the difference between each measured interval and the period
+	std::chrono::steady_clock::time_point lastSent;
+	uint64_t sent = 0;
+	uint64_t skipped = 0; // Periods missed entirely because the scheduler fell behind
+	int64_t minJitterUs = 0;
+	int64_t maxJitterUs = 0;
+	double sumAbsJitterUs = 0;
+	double sumSquaredJitterUs = 0;
+};
+
+/**
+ * \brief A two level hierarchical timer wheel holding indexes into a vector of PeriodicMessages
+ *
+ * The first level has one slot per tick for the next 256 ticks. The second level has one slot per 256 ticks,
+ * covering about 16 seconds at a 1ms tick. Messages due further out than the first level are placed in the
+ * second level and cascaded down when their slot comes around. Inserting and expiring a message are both O(1),
+ * and each tick only touches the slot that is due, no matter how many messages are scheduled.
+ */
+class TimerWheel {
+public:
+	static const uint64_t level0Slots = 256;
+	static const uint64_t level1Slots = 64;
+
+	TimerWheel(std::vector<PeriodicMessage>& messages) : messages(messages) {
+		level0.fill(-1);
+		level1.fill(-1);
+	}
+
+	uint64_t getCurrentTick() const { return currentTick; }
+
+	void schedule(int index) {
+		PeriodicMessage& entry = messages[index];
+		uint64_t delta = entry.dueTick > currentTick ? entry.dueTick - currentTick : 0;
+		int* slot;
+		if(delta < level0Slots) {
+			slot = &level0[entry.dueTick % level0Slots];
+		} else {
+			// Anything past the end of the wheel waits in the furthest slot and is rescheduled when it cascades
+			uint64_t cascadeTick = std::min(entry.dueTick, currentTick + level0Slots * (level1Slots - 1));
+			slot = &level1[(cascadeTick / level0Slots) % level1Slots];
+		}
+		entry.next = *slot;
+		*slot = index;
+	}
+
+	/**
+	 * \brief Advances the wheel by one tick
+	 * \param[out] due the indexes of the messages which are due on the new tick are appended here
+	 *
+	 * Due messages are not rescheduled, the caller must do so once it has sent them.
+	 */
+	void advance(std::vector<int>& due) {
+		currentTick++;
+
+		if(currentTick % level0Slots == 0) {
+			int index = takeSlot(level1[(currentTick / level0Slots) % level1Slots]);
+			while(index != -1) {
+				int next = messages[index].next;
+				schedule(index);
+				index = next;
+			}
+		}
+
+		int index = takeSlot(level0[currentTick % level0Slots]);
+		while(index != -1) {
+			int next = messages[index].next;
+			if(messages[index].dueTick <= currentTick)
+				due.push_back(index);
+			else
+				schedule(index);
+			index = next;
+		}
+	}
+
+private:
+	static int takeSlot(int& slot) {
+		int head = slot;
+		slot = -1;
+		return head;
+	}
+
+	std::vector<PeriodicMessage>& messages;
+	std::array<int, level0Slots> level0;
+	std::array<int, level1Slots> level1;
+	uint64_t currentTick = 0;
+};
+
+/**
+ * \brief Creates a periodic CAN message
+ * \param[in] netid the network to transmit on
+ * \param[in] arbid the arbitration ID
+ * \param[in] data the initial payload, mutators update it in place from here on
+ * \param[in] period how often the message should be sent, rounded down to whole ticks
+ */
+PeriodicMessage MakePeriodicMessage(icsneo::Network::NetID netid, uint32_t arbid, std::vector<uint8_t> data, std::chrono::milliseconds period) {
+	PeriodicMessage periodic;
+	periodic.message = std::make_shared<icsneo::CANMessage>();
+	periodic.message->network = netid;
+	periodic.message->arbid = arbid;
+	periodic.message->data = std::move(data);
+	periodic.message->isExtended = arbid > 0x7FF;
+	periodic.periodTicks = std::max<uint64_t>(1, period / tickLength);
+	return periodic;
+}
+
+/**
+ * \brief Sends every message on its period until the duration has elapsed
+ * \param[in] device the device to transmit on, it should already be online
+ * \param[in,out] messages the messages to send, their jitter statistics are updated
+ * \param[in] duration how long to run for
+ *
+ * Due times are kept as absolute tick numbers counted from the start, so sleeping late on one tick never
+ * pushes back the ticks after it. All messages due on the same tick are mutated and then handed to the
+ * device in a single transmit call.
+ */
+void RunScheduler(std::shared_ptr<icsneo::Device> device, std::vector<PeriodicMessage>& messages, std::chrono::seconds duration) {
+	TimerWheel wheel(messages);
+	for(size_t i = 0; i < messages.size(); i++) {
+		// Every message is first sent on the first tick, and then on its period
+		messages[i].dueTick = 1;
+		wheel.schedule(static_cast<int>(i));
+	}
+
+	std::vector<int> due;
+	std::vector<std::shared_ptr<icsneo::Message>> batch;
+	due.reserve(messages.size());
+	batch.reserve(messages.size());
+	size_t failedTransmits = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	const uint64_t lastTick = duration / tickLength;
+	while(wheel.getCurrentTick() < lastTick) {
+		std::this_thread::sleep_until(start + tickLength * (wheel.getCurrentTick() + 1));
+		const auto now = std::chrono::steady_clock::now();
+
+		// If we woke up late, every tick that has passed is handled at once, so each message due sends once now.
+		// Periods missed entirely are skipped below and counted in skipped rather than sent in a burst.
+		const uint64_t nowTick = std::min<uint64_t>(lastTick, (now - start) / tickLength);
+		due.clear();
+		batch.clear();
+		while(wheel.getCurrentTick() < nowTick)
+			wheel.advance(due);
+
+		for(int index : due) {
+			PeriodicMessage& entry = messages[index];
+			for(auto& mutator : entry.mutators)
+				mutator(entry.message->data);
+			batch.push_back(entry.message);
+
+			if(entry.sent != 0) {
+				auto intervalUs = std::chrono::duration_cast<std::chrono::microseconds>(now - entry.lastSent).count();
+				int64_t jitterUs = intervalUs - static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(tickLength * entry.periodTicks).count());
+				if(entry.sent == 1 || jitterUs < entry.minJitterUs)
+					entry.minJitterUs = jitterUs;
+				if(entry.sent == 1 || jitterUs > entry.maxJitterUs)
+					entry.maxJitterUs = jitterUs;
+				entry.sumAbsJitterUs += std::abs(static_cast<double>(jitterUs));
+				entry.sumSquaredJitterUs += static_cast<double>(jitterUs) * jitterUs;
+			}
+			entry.lastSent = now;
+			entry.sent++;
+
+			// Reschedule from the previous due time rather than from now so the period does not drift
+			entry.dueTick += entry.periodTicks;
+			while(entry.dueTick <= wheel.getCurrentTick()) {
+				entry.dueTick += entry.periodTicks;
+				entry.skipped++;
+			}
+			wheel.schedule(index);
+		}
+
+		if(!batch.empty() && !device->transmit(batch))
+			failedTransmits++;
+	}
+
+	if(failedTransmits != 0) {
+		std::cout << "\t" << failedTransmits << " batch transmit" << (failedTransmits == 1 ? "" : "s") << " failed" << std::endl;
+		std::cout << icsneo::GetLastError() << std::endl;
+	}
+}
+
+// Prints the measured period jitter for each message
+void PrintJitterReport(const std::vector<PeriodicMessage>& messages) {
+	std::cout << "\tArbID       Period      Sent  Skipped   Min(us)   Max(us)  MeanAbs(us)  StdDev(us)" << std::endl;
+	for(const auto& entry : messages) {
+		std::cout << "\t0x" << std::hex << std::setfill('0') << std::setw(entry.message->isExtended ? 8 : 3) << entry.message->arbid;
+		std::cout << std::dec << std::setfill(' ') << std::setw(entry.message->isExtended ? 6 : 11) << entry.periodTicks << "ms";
+		std::cout << std::setw(8) << entry.sent << std::setw(9) << entry.skipped;
+
+		uint64_t intervals = entry.sent > 1 ? entry.sent - 1 : 0;
+		if(intervals == 0) {
+			std::cout << "         -         -            -           -" << std::endl;
+			continue;
+		}
+		std::cout << std::setw(10) << entry.minJitterUs << std::setw(10) << entry.maxJitterUs;
+		std::cout << std::fixed << std::setprecision(1);
+		std::cout << std::setw(13) << entry.sumAbsJitterUs / intervals;
+		std::cout << std::setw(12) << std::sqrt(entry.sumSquaredJitterUs / intervals) << std::endl;
+	}
+}
+
+int main(int argc, char** argv) {
+	// The run length in seconds may be given as the first argument
+	std::chrono::seconds duration(10);
+	if(argc > 1)
+		duration = std::chrono::seconds(std::max(1, atoi(argv[1])));
+
+	std::cout << "Running libicsneo " << icsneo::GetVersion() << std::endl;
+
+	std::cout << "\nFinding devices... " << std::flush;
+	auto devices = icsneo::FindAllDevices();
+	std::cout << "OK, " << devices.size() << " device" << (devices.size() == 1 ? "" : "s") << " found" << std::endl;
+	if(devices.empty())
+		return 1;
+
+	// We'll use the first device found
+	auto device = devices.front();
+	std::cout << "Connecting to " << device->getType() << ' ' << device->getSerial() << "... ";
+	if(!device->open()) {
+		std::cout << "FAIL" << std::endl;
+		std::cout << icsneo::GetLastError() << std::endl;
+		return 1;
+	}
+	std::cout << "OK" << std::endl;
+
+	std::cout << "\tGoing online... ";
+	if(!device->goOnline()) {
+		std::cout << "FAIL" << std::endl;
+		device->close();
+		return 1;
+	}
+	std::cout << "OK" << std::endl;
+
+	// A few hand written ECU frames with an alive counter and a checksum, like a real ECU would send
+	std::vector<PeriodicMessage> messages;
+	messages.push_back(MakePeriodicMessage(icsneo::Network::NetID::HSCAN, 0x0C0, {0x00, 0x00, 0x12, 0x34, 0x00, 0x00, 0x00, 0x00}, std::chrono::milliseconds(1)));
+	messages.back().mutators.push_back(RollingCounter(6, 4));
+	messages.back().mutators.push_back(Crc8SaeJ1850(7));
+
+	messages.push_back(MakePeriodicMessage(icsneo::Network::NetID::HSCAN, 0x1A0, {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x00, 0x00}, std::chrono::milliseconds(10)));
+	messages.back().mutators.push_back(RollingCounter(6, 4));
+	messages.back().mutators.push_back(XorChecksum(7));
+
+	messages.push_back(MakePeriodicMessage(icsneo::Network::NetID::HSCAN, 0x18FEF100, {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00}, std::chrono::milliseconds(100)));
+	messages.back().mutators.push_back(RollingCounter(7, 8));
+
+	messages.push_back(MakePeriodicMessage(icsneo::Network::NetID::HSCAN, 0x7DF, {0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, std::chrono::milliseconds(1000)));
+
+	// And a few hundred filler frames spread over the usual periods to simulate the rest of a network
+	const std::array<int, 7> fillerPeriods = {{5, 20, 50, 100, 200, 500, 1000}};
+	for(uint32_t i = 0; i < 300; i++) {
+		messages.push_back(MakePeriodicMessage(icsneo::Network::NetID::HSCAN, 0x200 + i, {0, 0, 0, 0, 0, 0, 0, 0}, std::chrono::milliseconds(fillerPeriods[i % fillerPeriods.size()])));
+		messages.back().mutators.push_back(RollingCounter(0, 8));
+	}
+
+	std::cout << "\tTransmitting " << messages.size() << " periodic messages for " << duration.count() << " seconds... " << std::endl;
+	RunScheduler(device, messages, duration);
+	PrintJitterReport(messages);
+
+	std::cout << "\tGoing offline... ";
+	std::cout << (device->goOffline() ? "OK" : "FAIL") << std::endl;
+
+	std::cout << "\tDisconnecting... ";
+	std::cout << (device->close() ? "OK\n" : "FAIL\n") << std::endl;
+	return 0;
+}
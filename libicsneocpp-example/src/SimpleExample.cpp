@@ -4,6 +4,7 @@
 #include <chrono>
 
 #include "icsneo/icsneocpp.h"
+#include "SettingsTransaction.h"
 
 int main() {
 	// Print version
@@ -40,19 +41,6 @@ int main() {
 		else
 			std::cout << "OK, " << (baud/1000) << "kbit/s" << std::endl;
 
-		std::cout << "\tSetting HSCAN to operate at 125kbit/s... ";
-		ret = device->settings->setBaudrateFor(icsneo::Network::NetID::HSCAN, 125000);
-		std::cout << (ret ? "OK" : "FAIL") << std::endl;
-
-		// Changes to the settings do not take affect until you call settings->apply()!
-		// When you get the baudrate here, you're reading what the device is currently operating on
-		std::cout << "\tGetting HSCAN Baudrate... (expected to be unchanged) ";
-		baud = device->settings->getBaudrateFor(icsneo::Network::NetID::HSCAN);
-		if(baud < 0)
-			std::cout << "FAIL" << std::endl;
-		else
-			std::cout << "OK, " << (baud/1000) << "kbit/s" << std::endl;
-
 		std::cout << "\tGetting HSCANFD Baudrate... ";
 		baud = device->settings->getFDBaudrateFor(icsneo::Network::NetID::HSCAN);
 		if(baud < 0)
@@ -60,42 +48,30 @@ int main() {
 		else
 			std::cout << "OK, " << (baud/1000) << "kbit/s" << std::endl;
 
-		std::cout << "\tSetting HSCANFD to operate at 8Mbit/s... ";
-		ret = device->settings->setFDBaudrateFor(icsneo::Network::NetID::HSCAN, 8000000);
-		std::cout << (ret ? "OK" : "FAIL") << std::endl;
-
-		std::cout << "\tGetting HSCANFD Baudrate... (expected to be unchanged) ";
-		baud = device->settings->getFDBaudrateFor(icsneo::Network::NetID::HSCAN);
-		if(baud < 0)
-			std::cout << "FAIL" << std::endl;
-		else
-			std::cout << "OK, " << (baud/1000) << "kbit/s" << std::endl;
-
-		// Setting settings temporarily does not need to be done before committing to device EEPROM
-		// It's done here to test both functionalities
-		// Setting temporarily will keep these settings until another send/commit is called or a power cycle occurs
-		std::cout << "\tSetting settings temporarily... ";
-		ret = device->settings->apply(true);
-		std::cout << (ret ? "OK" : "FAIL") << std::endl;
-
-		// Now that we have applied, we expect that our operating baudrates have changed
+		// A SettingsTransaction records changes and makes them all with a single apply, rather than one apply per change
+		// Committing permanently writes them to the device EEPROM, commit(true) would keep them only until a power cycle
+		std::cout << "\tSetting HSCAN to operate at 125kbit/s and HSCANFD at 8Mbit/s... ";
+		SettingsTransaction transaction(*device);
+		transaction.setBaudrateFor(icsneo::Network::NetID::HSCAN, 125000).setFDBaudrateFor(icsneo::Network::NetID::HSCAN, 8000000);
+		SettingsTransaction::Report report;
+		ret = transaction.commit(false, &report);
+		std::cout << (ret ? "OK, " : "FAIL, ") << report.changed << " of " << report.recorded << " changed, "
+			<< report.applies << " applied, " << report.appliesSaved() << " applies saved" << std::endl;
+
+		// Now that we have committed, we expect that our operating baudrates have changed
 		std::cout << "\tGetting HSCAN Baudrate... ";
 		baud = device->settings->getBaudrateFor(icsneo::Network::NetID::HSCAN);
 		if(baud < 0)
 			std::cout << "FAIL" << std::endl;
 		else
 			std::cout << "OK, " << (baud/1000) << "kbit/s" << std::endl;
-		
+
 		std::cout << "\tGetting HSCANFD Baudrate... ";
 		baud = device->settings->getFDBaudrateFor(icsneo::Network::NetID::HSCAN);
 		if(baud < 0)
-			std::cout << "FAIL" << std::endl;
+			std::cout << "FAIL\n" << std::endl;
 		else
-			std::cout << "OK, " << (baud/1000) << "kbit/s" << std::endl;
-
-		std::cout << "\tSetting settings permanently... ";
-		ret = device->settings->apply();
-		std::cout << (ret ? "OK\n\n" : "FAIL\n\n");
+			std::cout << "OK, " << (baud/1000) << "kbit/s\n" << std::endl;
 
 		// The concept of going "online" tells the connected device to start listening, i.e. ACKing traffic and giving it to us
 		std::cout << "\tGoing online... ";
@@ -7,6 +7,19 @@ namespace libicsneocsharp_example {
         private neodevice_t selectedDevice;
         private List<neodevice_t> devices = new List<neodevice_t>();
         private uint numDevices = 0;
+        // Applied in native code when getting messages, so messages which do not pass never reach managed memory
+        private SWIGTYPE_p_icsneocsharp_filter_t receiveFilter = icsneocsharp.icsneocsharp_newFilter();
+        // Reused for every poll, icsneo_getMessages fills it in place
+        private NeoMessage[] msgs;
+        // Reused for every scan and every time events are read, filled in place
+        private NeoDevice[] foundDevices = new NeoDevice[99];
+        private NeoEvent[] events = new NeoEvent[99];
+        // Native buffers for transmitting, kept and reused rather than allocated for every message
+        private NeoBufferPool bufferPool = new NeoBufferPool(1, 64);
+        private static readonly byte[] samplePayload = { 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+        private MessageListener messageListener;
+        private long listenedMessages;
+        private long listenedCANMessages;
 
         private void PrintAllDevices() {
             if(numDevices == 0) {
@@ -40,18 +53,13 @@ namespace libicsneocsharp_example {
         }
 
         private uint ScanNewDevices() {
-            neodevice_t newDevices = icsneocsharp.new_neodevice_t_array(99);
-
-            int count = 10;
-
-            icsneocsharp.icsneo_findAllDevices(newDevices, ref count);
+            int count = NeoDevices.FindAll(foundDevices);
 
             numDevices += (uint) count;
 
-            for(int i = 0; i < numDevices; i++) {
-                devices.Add(icsneocsharp.neodevice_t_array_getitem(newDevices, i));
+            for(int i = 0; i < count; i++) {
+                devices.Add(foundDevices[i].ToDevice());
             }
-            icsneocsharp.delete_neodevice_t_array(newDevices);
             return (uint) count;
         }
 
@@ -67,57 +75,44 @@ namespace libicsneocsharp_example {
             System.Console.WriteLine("H - Get events");
             System.Console.WriteLine("I - Set HS CAN to 250K");
             System.Console.WriteLine("J - Set HS CAN to 500K");
+            System.Console.WriteLine("K - Set receive filter");
+            System.Console.WriteLine("L - Start/stop listening for messages");
+            System.Console.WriteLine("M - Stream messages for 5 seconds");
             System.Console.WriteLine("X - Exit");
         }
 
         void PrintLastError() {
-            neoevent_t error = new neoevent_t();
-            if(icsneocsharp.icsneo_getLastError(error))
-                System.Console.WriteLine("Error 0x" + error.eventNumber + ": " + error.description);
+            if(NeoDevices.GetLastError(out NeoEvent error))
+                System.Console.WriteLine("Error 0x" + error.eventNumber + ": " + error.Description);
             else
                 System.Console.WriteLine("No errors found!");
         }
 
         void PrintAPIEvents() {
-            neoevent_t events = icsneocsharp.new_neoevent_t_array(99);
-            int eventCount = 99;
-            if(icsneocsharp.icsneo_getEvents(events, ref eventCount)) {
-                if(eventCount == 1) {
-                    neoevent_t evt = icsneocsharp.neoevent_t_array_getitem(events, 0);
-                    System.Console.WriteLine("1 API event found!");
-                    System.Console.WriteLine("Event 0x" + evt.eventNumber + ": " + evt.description);
-                } else {
-                    System.Console.WriteLine(eventCount + " API events found!");
-                    for(var i = 0; i < eventCount; ++i) {
-                        neoevent_t evt = icsneocsharp.neoevent_t_array_getitem(events, i);
-                        System.Console.WriteLine("Event 0x" + evt.eventNumber + ": " + evt.description);
-                    }
-                }
+            if(NeoDevices.GetEvents(events, out int eventCount)) {
+                PrintEvents(eventCount, "API");
             } else {
                 System.Console.WriteLine("Failed to get API events!");
             }
-            icsneocsharp.delete_neoevent_t_array(events);
         }
 
         void PrintDeviceEvents(neodevice_t device) {
-            neoevent_t events = icsneocsharp.new_neoevent_t_array(99);
-            int eventCount = 99;
-            if(icsneocsharp.icsneo_getDeviceEvents(device, events, ref eventCount)) {
-                if(eventCount == 1) {
-                    neoevent_t evt = icsneocsharp.neoevent_t_array_getitem(events, 0);
-                    System.Console.WriteLine("1 device event found!");
-                    System.Console.WriteLine("Event 0x" + evt.eventNumber + ": " + evt.description);
-                } else {
-                    System.Console.WriteLine(eventCount + " device events found!");
-                    for(var i = 0; i < eventCount; ++i) {
-                        neoevent_t evt = icsneocsharp.neoevent_t_array_getitem(events, i);
-                        System.Console.WriteLine("Event 0x" + evt.eventNumber + ": " + evt.description);
-                    }
-                }
+            if(NeoDevices.GetDeviceEvents(device, events, out int eventCount)) {
+                PrintEvents(eventCount, "device");
             } else {
                 System.Console.WriteLine("Failed to get API events!");
             }
-            icsneocsharp.delete_neoevent_t_array(events);
+        }
+
+        void PrintEvents(int eventCount, string kind) {
+            if(eventCount == 1)
+                System.Console.WriteLine("1 " + kind + " event found!");
+            else
+                System.Console.WriteLine(eventCount + " " + kind + " events found!");
+            for(var i = 0; i < eventCount; ++i) {
+                // Description is decoded once per event number, rather than for every event
+                System.Console.WriteLine("Event 0x" + events[i].eventNumber + ": " + events[i].Description);
+            }
         }
 
         private char GetCharInput(List<char> allowed) {
@@ -140,6 +135,19 @@ namespace libicsneocsharp_example {
             return key;
         }
 
+        // Reads the stream until duration has passed, then stops it and reads what was left queued
+        private async System.Threading.Tasks.Task<long> StreamMessages(MessageStream stream, System.TimeSpan duration) {
+            long count = 0;
+            using(var stop = new System.Threading.CancellationTokenSource(duration))
+            using(stop.Token.Register(stream.Dispose)) {
+                await foreach(MessageBatch batch in stream) {
+                    count += batch.Count;
+                    batch.Dispose();
+                }
+            }
+            return count;
+        }
+
         neodevice_t SelectDevice() {
             System.Console.WriteLine("Please select a device:");
             PrintAllDevices();
@@ -159,6 +167,10 @@ namespace libicsneocsharp_example {
             return devices[selectedDeviceNum - 1];
         }
 
+        public InteractiveExample() {
+            msgs = new NeoMessage[msgLimit];
+        }
+
         public void Run() {
             neoversion_t version = icsneocsharp.icsneo_getVersion();
             System.Console.WriteLine("ICS icsneocsharp.dll version " + version.major + "." + version.minor + "." + version.patch);
@@ -167,7 +179,7 @@ namespace libicsneocsharp_example {
             while(true) {
                 PrintMainMenu();
                 System.Console.WriteLine();
-                char input = GetCharInput(new List<char> { 'A', 'a', 'B', 'b', 'C', 'c', 'D', 'd', 'E', 'e', 'F', 'f', 'G', 'g', 'H', 'h', 'I', 'i', 'J', 'j', 'X', 'x' });
+                char input = GetCharInput(new List<char> { 'A', 'a', 'B', 'b', 'C', 'c', 'D', 'd', 'E', 'e', 'F', 'f', 'G', 'g', 'H', 'h', 'I', 'i', 'J', 'j', 'K', 'k', 'L', 'l', 'M', 'm', 'X', 'x' });
                 System.Console.WriteLine();
                 switch(input) {
                 // List current devices
@@ -371,14 +383,11 @@ namespace libicsneocsharp_example {
 
                     icsneocsharp.icsneo_describeDevice(selectedDevice, description, ref maxLength);
 
-                    // Prepare the neomessage_t array and size for reading in the messages
-                    neomessage_t msgs = icsneocsharp.new_neomessage_t_array((int)msgLimit);
-                    int msgCount = (int)msgLimit;
-
-                    if(!icsneocsharp.icsneo_getMessages(selectedDevice, msgs, ref msgCount, 0)) {
+                    // The messages are read straight into the managed array, and their fields with plain memory loads
+                    int msgCount;
+                    if(!NeoMessages.GetMessages(selectedDevice, receiveFilter, msgs, out msgCount, 0)) {
                         System.Console.WriteLine("Failed to get messages for " + description.ToString() + "!\n");
                         PrintLastError();
-                        icsneocsharp.delete_neomessage_t_array(msgs);
                         System.Console.WriteLine();
                         break;
                     }
@@ -391,19 +400,18 @@ namespace libicsneocsharp_example {
 
                     // Print out the received messages
                     for(int i = 0; i < msgCount; i++) {
-                        neomessage_t msg = icsneocsharp.neomessage_t_array_getitem(msgs, i);
-                        if(msg.type == icsneocsharp.ICSNEO_NETWORK_TYPE_CAN) {
-                            System.Console.Write("\t0x" + "{0:x}" + " [" + msg.length + "] ", icsneocsharp.neomessage_can_t_cast(msg).arbid);
-                            for(int j = 0; j < msg.length; j++) {
-                                System.Console.Write("{0:x} ", icsneocsharp.neomessage_can_t_cast(msg).data[j]);
+                        if(msgs[i].type == icsneocsharp.ICSNEO_NETWORK_TYPE_CAN) {
+                            ref NeoMessageCan msg = ref NeoMessages.AsCan(ref msgs[i]);
+                            System.Console.Write("\t0x" + "{0:x}" + " [" + msg.length + "] ", msg.arbid);
+                            foreach(byte b in msg.Data) {
+                                System.Console.Write("{0:x} ", b);
                             }
                             System.Console.WriteLine("(" + msg.timestamp + ")");
                         } else {
-                            if(msg.netid != 0)
-                                System.Console.WriteLine("\tMessage on netid " + msg.netid + " with length " + msg.length);
+                            if(msgs[i].netid != 0)
+                                System.Console.WriteLine("\tMessage on netid " + msgs[i].netid + " with length " + msgs[i].length);
                         }
                     }
-                    icsneocsharp.delete_neomessage_t_array(msgs);
                     break;
                 }
                 // Send message
@@ -424,23 +432,19 @@ namespace libicsneocsharp_example {
                     icsneocsharp.icsneo_describeDevice(selectedDevice, description, ref maxLength);
 
                     // Start generating sample msg
-                    neomessage_can_t msg = new neomessage_can_t();
-                    msg.arbid = 0x120;
-                    msg.length = 6;
-                    msg.netid = (ushort)icsneocsharp.ICSNEO_NETID_HSCAN;
-                    msg.data = new byte[6] { 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
-                    msg.status.canfdFDF = 0;
-                    msg.status.extendedFrame = 0;
-                    msg.status.canfdBRS = 0;
-                    // End generating sample msg
-
-                    // Attempt to transmit the sample msg
-                    if(icsneocsharp.icsneo_transmit(selectedDevice, icsneocsharp.from_can_neomessage_t_cast(msg))) {
-                        System.Console.WriteLine("Message transmit successful!");
-                    } else {
-                        System.Console.WriteLine("Failed to transmit message to " + description.ToString() + "!\n");
-                        PrintLastError();
-                        System.Console.WriteLine();
+                    // The buffer is reused from the pool, and the payload copied into its native memory
+                    using(NeoBuffer buffer = bufferPool.Rent()) {
+                        buffer.AddCan(icsneocsharp.ICSNEO_NETID_HSCAN, 0x120, samplePayload);
+                        // End generating sample msg
+
+                        // Attempt to transmit the sample msg
+                        if(buffer.Transmit(selectedDevice)) {
+                            System.Console.WriteLine("Message transmit successful!");
+                        } else {
+                            System.Console.WriteLine("Failed to transmit message to " + description.ToString() + "!\n");
+                            PrintLastError();
+                            System.Console.WriteLine();
+                        }
                     }
                     break;
                 }
@@ -505,6 +509,124 @@ namespace libicsneocsharp_example {
                     }
                     break;
                 }
+                // Set receive filter
+                case 'K':
+                    goto case 'k';
+                case 'k': {
+                    System.Console.WriteLine("Which messages would you like to receive?");
+                    System.Console.WriteLine("[1] All messages\n[2] Only HS CAN\n[3] Only CAN messages with arbids 0x100 to 0x1FF\n[4] Cancel\n");
+
+                    char option = GetCharInput(new List<char> { '1', '2', '3', '4' });
+                    System.Console.WriteLine();
+
+                    switch(option) {
+                    case '1':
+                        icsneocsharp.icsneocsharp_clearFilter(receiveFilter);
+                        System.Console.WriteLine("Receiving all messages!\n");
+                        break;
+                    case '2':
+                        icsneocsharp.icsneocsharp_clearFilter(receiveFilter);
+                        icsneocsharp.icsneocsharp_filterAddNetid(receiveFilter, icsneocsharp.ICSNEO_NETID_HSCAN);
+                        System.Console.WriteLine("Receiving only HS CAN messages!\n");
+                        break;
+                    case '3':
+                        // Arbids are masked to 11 bits before they are compared
+                        icsneocsharp.icsneocsharp_clearFilter(receiveFilter);
+                        icsneocsharp.icsneocsharp_filterAddType(receiveFilter, icsneocsharp.ICSNEO_NETWORK_TYPE_CAN);
+                        icsneocsharp.icsneocsharp_filterAddArbidRange(receiveFilter, 0x100, 0x1FF, 0x7FF);
+                        System.Console.WriteLine("Receiving only CAN messages with arbids 0x100 to 0x1FF!\n");
+                        break;
+                    default:
+                        System.Console.WriteLine("Canceling!\n");
+                        break;
+                    }
+                    break;
+                }
+                // Start/stop listening for messages
+                case 'L':
+                    goto case 'l';
+                case 'l': {
+                    if(messageListener != null) {
+                        // Removing the listener delivers the messages already collected before it returns
+                        ulong dropped = messageListener.Dropped;
+                        if(messageListener.Remove()) {
+                            System.Console.WriteLine("Stopped listening, " + listenedMessages + " messages received, " + listenedCANMessages + " of them CAN!");
+                            System.Console.WriteLine(dropped + " messages were dropped\n");
+                            messageListener = null;
+                        } else {
+                            System.Console.WriteLine("Failed to stop listening!\n");
+                            PrintLastError();
+                            System.Console.WriteLine();
+                        }
+                        break;
+                    }
+
+                    // Select a device and get its description
+                    if(numDevices == 0) {
+                        System.Console.WriteLine("No devices found! Please scan for new devices.\n");
+                        break;
+                    }
+                    selectedDevice = SelectDevice();
+
+                    // Get the product description for the device
+                    System.Text.StringBuilder description = new System.Text.StringBuilder(icsneocsharp.ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION);
+                    int maxLength = icsneocsharp.ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION;
+
+                    icsneocsharp.icsneo_describeDevice(selectedDevice, description, ref maxLength);
+
+                    // The handler is called on a native thread with up to 256 messages at a time, which pass the receive filter
+                    // A smaller batch is delivered once its first message has waited 1ms
+                    listenedMessages = 0;
+                    listenedCANMessages = 0;
+                    try {
+                        messageListener = new MessageListener(selectedDevice, messages => {
+                            foreach(ref readonly NeoMessage msg in messages) {
+                                if(msg.type == icsneocsharp.ICSNEO_NETWORK_TYPE_CAN)
+                                    listenedCANMessages++;
+                            }
+                            listenedMessages += messages.Length;
+                        }, 256, 1000, receiveFilter);
+                        System.Console.WriteLine("Listening for messages from " + description.ToString() + ", select L again to stop!\n");
+                    } catch(System.InvalidOperationException) {
+                        System.Console.WriteLine("Failed to listen for messages from " + description.ToString() + "!\n");
+                        PrintLastError();
+                        System.Console.WriteLine();
+                    }
+                    break;
+                }
+                // Stream messages for 5 seconds
+                case 'M':
+                    goto case 'm';
+                case 'm': {
+                    // Select a device and get its description
+                    if(numDevices == 0) {
+                        System.Console.WriteLine("No devices found! Please scan for new devices.\n");
+                        break;
+                    }
+                    selectedDevice = SelectDevice();
+
+                    // Get the product description for the device
+                    System.Text.StringBuilder description = new System.Text.StringBuilder(icsneocsharp.ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION);
+                    int maxLength = icsneocsharp.ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION;
+
+                    icsneocsharp.icsneo_describeDevice(selectedDevice, description, ref maxLength);
+
+                    MessageStream stream;
+                    try {
+                        // Up to 16 batches of 256 messages are queued, after which the oldest are dropped
+                        stream = new MessageStream(selectedDevice, 16, MessageStreamFullMode.DropOldest, 256, 1000, receiveFilter);
+                    } catch(System.InvalidOperationException) {
+                        System.Console.WriteLine("Failed to stream messages from " + description.ToString() + "!\n");
+                        PrintLastError();
+                        System.Console.WriteLine();
+                        break;
+                    }
+
+                    System.Console.WriteLine("Streaming messages from " + description.ToString() + " for 5 seconds!");
+                    long streamedMessages = StreamMessages(stream, System.TimeSpan.FromSeconds(5)).GetAwaiter().GetResult();
+                    System.Console.WriteLine(streamedMessages + " messages received, " + stream.DroppedOldest + " dropped from the queue, " + stream.ListenerDropped + " dropped by the listener\n");
+                    break;
+                }
                 case 'X':
                     goto case 'x';
                 case 'x':
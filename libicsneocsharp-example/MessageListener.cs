@@ -0,0 +1,77 @@
+using System;
+using System.Runtime.InteropServices;
+
+/// <summary>
+/// Handles a batch of received messages. The messages, and the payloads their Data views, are in native
+/// memory which is reused for later batches, so do not keep them after the handler returns.
+/// Use CopyData, or copy the structs, for anything which has to outlive it.
+/// </summary>
+public delegate void MessageHandler(ReadOnlySpan<NeoMessage> messages);
+
+/// <summary>
+/// Receives messages from a device in batches, instead of polling, see icsneocsharp_addMessageListener.
+/// The handler is called on a native delivery thread, one per listener, never from two threads at once.
+/// Messages are collected in native code and the handler is called once per batch, with batchSize messages
+/// or fewer once the first of them has waited maxDelayMicroseconds. Do not dispose the listener from within the handler.
+/// </summary>
+public sealed class MessageListener : IDisposable {
+    // The native side calls this with the batch, it matches icsneocsharp_onMessages_t
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    private unsafe delegate void OnMessages(NeoMessage* messages, int count);
+
+    private readonly MessageHandler handler;
+    // The delegate behind the function pointer native code holds, kept alive until the listener is removed
+    private readonly OnMessages onMessages;
+    private GCHandle onMessagesHandle;
+    private SWIGTYPE_p_icsneocsharp_listener_t listener;
+
+    /// <summary>
+    /// Starts listening for messages which pass filter, which is copied so it can be changed or deleted afterwards.
+    /// A null filter passes everything. Throws InvalidOperationException if the listener could not be added,
+    /// including when all 8 listeners are in use.
+    /// </summary>
+    public unsafe MessageListener(neodevice_t device, MessageHandler handler, int batchSize, ulong maxDelayMicroseconds, SWIGTYPE_p_icsneocsharp_filter_t filter = null) {
+        if(handler == null)
+            throw new ArgumentNullException("handler");
+        this.handler = handler;
+        onMessages = Deliver;
+        onMessagesHandle = GCHandle.Alloc(onMessages);
+        listener = icsneocsharp.icsneocsharp_addMessageListener(device, Marshal.GetFunctionPointerForDelegate(onMessages), filter, batchSize, maxDelayMicroseconds);
+        if(listener == null) {
+            onMessagesHandle.Free();
+            throw new InvalidOperationException("Unable to add the message listener");
+        }
+    }
+
+    /// <summary>
+    /// The number of messages dropped because the handler could not keep up
+    /// </summary>
+    public ulong Dropped { get { return icsneocsharp.icsneocsharp_getMessageListenerDropped(listener); } }
+
+    /// <summary>
+    /// Stops listening. The messages already collected are delivered before this returns.
+    /// Returns false, and keeps listening, if the callback could not be removed from the device.
+    /// </summary>
+    public bool Remove() {
+        if(listener == null)
+            return true;
+        if(!icsneocsharp.icsneocsharp_removeMessageListener(listener))
+            return false;
+        listener = null;
+        onMessagesHandle.Free();
+        return true;
+    }
+
+    public void Dispose() {
+        Remove();
+    }
+
+    private unsafe void Deliver(NeoMessage* messages, int count) {
+        // An exception escaping into the delivery thread would end the process
+        try {
+            handler(new ReadOnlySpan<NeoMessage>(messages, count));
+        } catch(Exception e) {
+            Console.Error.WriteLine(e);
+        }
+    }
+}
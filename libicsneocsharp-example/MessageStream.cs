@@ -0,0 +1,212 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Channels;
+
+/// <summary>
+/// What a MessageStream does with a batch when its queue is full
+/// </summary>
+public enum MessageStreamFullMode {
+    /// <summary>Hold the native delivery thread until there is room. Once its batches fill up, the listener drops and counts new messages.</summary>
+    Wait,
+    /// <summary>Drop the oldest queued batch to make room for the new one</summary>
+    DropOldest,
+    /// <summary>Drop the new batch, keeping the ones already queued</summary>
+    DropNewest
+}
+
+/// <summary>
+/// A batch of messages from a MessageStream. The messages are copies, and their Data views payloads owned by the
+/// batch, so they stay valid until the batch is disposed. Disposing it returns it to the stream to be reused.
+/// </summary>
+public sealed class MessageBatch : IDisposable {
+    private readonly MessageStream stream;
+    private NeoMessage[] messages;
+    private IntPtr data;
+    private int dataCapacity;
+    private bool returned;
+
+    internal MessageBatch(MessageStream stream, int capacity) {
+        this.stream = stream;
+        messages = new NeoMessage[capacity];
+    }
+
+    ~MessageBatch() {
+        Free();
+    }
+
+    public int Count { get; private set; }
+
+    public ReadOnlySpan<NeoMessage> Messages { get { return new ReadOnlySpan<NeoMessage>(messages, 0, Count); } }
+
+    public void Dispose() {
+        if(returned)
+            return;
+        returned = true;
+        stream.Return(this);
+    }
+
+    // Copies a batch from the listener, pointing each message at its payload in this batch's own memory
+    internal unsafe void CopyFrom(ReadOnlySpan<NeoMessage> source) {
+        long dataLength = 0;
+        for(int i = 0; i < source.Length; i++)
+            dataLength += (long)source[i].length.ToUInt64();
+        if(dataLength > dataCapacity) {
+            int capacity = (int)Math.Max(dataLength, 64 * 1024);
+            data = data == IntPtr.Zero ? Marshal.AllocHGlobal(capacity) : Marshal.ReAllocHGlobal(data, (IntPtr)capacity);
+            dataCapacity = capacity;
+        }
+        if(messages.Length < source.Length)
+            messages = new NeoMessage[source.Length];
+
+        byte* next = (byte*)data;
+        for(int i = 0; i < source.Length; i++) {
+            long length = (long)source[i].length.ToUInt64();
+            messages[i] = source[i];
+            messages[i].data = (IntPtr)next;
+            if(length != 0)
+                Buffer.MemoryCopy((void*)source[i].data, next, length, length);
+            next += length;
+        }
+        Count = source.Length;
+        returned = false;
+    }
+
+    internal void Free() {
+        if(data != IntPtr.Zero) {
+            Marshal.FreeHGlobal(data);
+            data = IntPtr.Zero;
+            dataCapacity = 0;
+        }
+        GC.SuppressFinalize(this);
+    }
+}
+
+/// <summary>
+/// Receives messages from a device as an async stream of batches. A MessageListener is the single reader of
+/// the device, its native delivery thread copies each batch and queues it in a bounded Channel, which
+/// ReadAllAsync, or await foreach on the stream itself, drains. What happens when the queue is full
+/// is set by MessageStreamFullMode, and each outcome is counted. Dispose the batches once done with them,
+/// so they can be reused rather than allocated for every batch.
+/// </summary>
+public sealed class MessageStream : IAsyncEnumerable<MessageBatch>, IDisposable {
+    private readonly Channel<MessageBatch> channel;
+    private readonly MessageStreamFullMode fullMode;
+    private readonly int batchSize;
+    private readonly ConcurrentQueue<MessageBatch> pool = new ConcurrentQueue<MessageBatch>();
+    private readonly int poolLimit;
+    private readonly CancellationTokenSource closing = new CancellationTokenSource();
+    private readonly MessageListener listener;
+    private long waits;
+    private long droppedOldest;
+    private long droppedNewest;
+    private ulong listenerDropped;
+    private bool disposed;
+
+    /// <summary>
+    /// Starts streaming messages which pass filter, a null filter passes everything. Up to capacity batches of up to
+    /// batchSize messages are queued, a batch is sent once it is full or its first message has waited maxDelayMicroseconds.
+    /// Throws InvalidOperationException if the listener could not be added.
+    /// </summary>
+    public MessageStream(neodevice_t device, int capacity, MessageStreamFullMode fullMode, int batchSize, ulong maxDelayMicroseconds, SWIGTYPE_p_icsneocsharp_filter_t filter = null) {
+        if(capacity <= 0)
+            throw new ArgumentOutOfRangeException("capacity");
+        this.fullMode = fullMode;
+        this.batchSize = batchSize;
+        poolLimit = capacity + 2;
+        // Dropping is done here rather than by the channel, so it can be counted
+        channel = Channel.CreateBounded<MessageBatch>(new BoundedChannelOptions(capacity) {
+            FullMode = BoundedChannelFullMode.Wait,
+            SingleWriter = true,
+            SingleReader = false
+        });
+        listener = new MessageListener(device, Write, batchSize, maxDelayMicroseconds, filter);
+    }
+
+    /// <summary>The number of batches which had to wait for room in the queue, in MessageStreamFullMode.Wait</summary>
+    public long Waits { get { return Interlocked.Read(ref waits); } }
+
+    /// <summary>The number of messages in batches dropped from the front of the queue, in MessageStreamFullMode.DropOldest</summary>
+    public long DroppedOldest { get { return Interlocked.Read(ref droppedOldest); } }
+
+    /// <summary>The number of messages in new batches dropped because the queue was full, in MessageStreamFullMode.DropNewest</summary>
+    public long DroppedNewest { get { return Interlocked.Read(ref droppedNewest); } }
+
+    /// <summary>The number of messages the native listener dropped because this stream could not keep up</summary>
+    public ulong ListenerDropped { get { return disposed ? listenerDropped : listener.Dropped; } }
+
+    /// <summary>
+    /// The queued batches as they arrive, until the stream is disposed and the queue is empty
+    /// </summary>
+    public IAsyncEnumerable<MessageBatch> ReadAllAsync(CancellationToken cancellationToken = default) {
+        return channel.Reader.ReadAllAsync(cancellationToken);
+    }
+
+    public IAsyncEnumerator<MessageBatch> GetAsyncEnumerator(CancellationToken cancellationToken = default) {
+        return ReadAllAsync(cancellationToken).GetAsyncEnumerator(cancellationToken);
+    }
+
+    /// <summary>
+    /// Stops listening. Batches already queued can still be read, and the stream ends after them.
+    /// Batches the listener delivers while it stops are dropped rather than waited for.
+    /// </summary>
+    public void Dispose() {
+        if(disposed)
+            return;
+        closing.Cancel();
+        listenerDropped = listener.Dropped;
+        listener.Dispose();
+        disposed = true;
+        channel.Writer.TryComplete();
+        while(pool.TryDequeue(out MessageBatch batch))
+            batch.Free();
+    }
+
+    internal void Return(MessageBatch batch) {
+        if(!disposed && pool.Count < poolLimit)
+            pool.Enqueue(batch);
+        else
+            batch.Free();
+    }
+
+    // Runs on the listener's delivery thread, the only writer
+    private void Write(ReadOnlySpan<NeoMessage> messages) {
+        if(closing.IsCancellationRequested)
+            return;
+        if(!pool.TryDequeue(out MessageBatch batch))
+            batch = new MessageBatch(this, batchSize);
+        batch.CopyFrom(messages);
+
+        if(channel.Writer.TryWrite(batch))
+            return;
+        switch(fullMode) {
+        case MessageStreamFullMode.Wait:
+            Interlocked.Increment(ref waits);
+            try {
+                while(!channel.Writer.TryWrite(batch)) {
+                    if(!channel.Writer.WaitToWriteAsync(closing.Token).AsTask().GetAwaiter().GetResult()) {
+                        batch.Dispose();
+                        return;
+                    }
+                }
+            } catch(OperationCanceledException) {
+                batch.Dispose();
+            }
+            break;
+        case MessageStreamFullMode.DropOldest:
+            while(!channel.Writer.TryWrite(batch)) {
+                if(channel.Reader.TryRead(out MessageBatch oldest)) {
+                    Interlocked.Add(ref droppedOldest, oldest.Count);
+                    oldest.Dispose();
+                }
+            }
+            break;
+        case MessageStreamFullMode.DropNewest:
+            Interlocked.Add(ref droppedNewest, batch.Count);
+            batch.Dispose();
+            break;
+        }
+    }
+}
@@ -0,0 +1,189 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+/// <summary>
+/// Native buffers of NeoMessage, with room for transmit payloads, which are kept and reused rather than allocated
+/// for every call. Rent a buffer, poll into it or fill and transmit it as often as needed, and dispose it to
+/// return it. Once the pool holds as many buffers as are in use at once, polling and transmitting allocate
+/// nothing, managed or native. Buffers can be used from any thread, but only one thread at a time.
+/// </summary>
+public sealed class NeoBufferPool : IDisposable {
+    private readonly Stack<NeoBuffer> buffers = new Stack<NeoBuffer>();
+    private bool disposed;
+
+    /// <summary>
+    /// Each buffer holds messagesPerBuffer messages, and dataBytesPerBuffer bytes of payload for transmitting
+    /// </summary>
+    public NeoBufferPool(int messagesPerBuffer, int dataBytesPerBuffer) {
+        if(messagesPerBuffer <= 0)
+            throw new ArgumentOutOfRangeException("messagesPerBuffer");
+        if(dataBytesPerBuffer < 0)
+            throw new ArgumentOutOfRangeException("dataBytesPerBuffer");
+        MessagesPerBuffer = messagesPerBuffer;
+        DataBytesPerBuffer = dataBytesPerBuffer;
+    }
+
+    public int MessagesPerBuffer { get; }
+    public int DataBytesPerBuffer { get; }
+
+    /// <summary>
+    /// An empty buffer, reused if one has been returned
+    /// </summary>
+    public NeoBuffer Rent() {
+        lock(buffers) {
+            if(disposed)
+                throw new ObjectDisposedException("NeoBufferPool");
+            if(buffers.Count != 0) {
+                NeoBuffer buffer = buffers.Pop();
+                buffer.Rented();
+                return buffer;
+            }
+        }
+        return new NeoBuffer(this, MessagesPerBuffer, DataBytesPerBuffer);
+    }
+
+    /// <summary>
+    /// Frees the buffers in the pool. Buffers still rented are freed when they are disposed.
+    /// </summary>
+    public void Dispose() {
+        lock(buffers) {
+            disposed = true;
+            while(buffers.Count != 0)
+                buffers.Pop().Free();
+        }
+    }
+
+    internal void Return(NeoBuffer buffer) {
+        lock(buffers) {
+            if(!disposed) {
+                buffers.Push(buffer);
+                return;
+            }
+        }
+        buffer.Free();
+    }
+}
+
+/// <summary>
+/// A native array of NeoMessage from a NeoBufferPool, with a slab for the payloads of messages to transmit.
+/// Poll fills it from a device, their payloads stay in icsneoc's memory until the next poll, as NeoMessages.GetMessages does.
+/// AddCan and Transmit build frames in it and send them with one icsneo_transmitMessages.
+/// </summary>
+public sealed unsafe class NeoBuffer : IDisposable {
+    private readonly NeoBufferPool pool;
+    private NeoMessage* messages;
+    private byte* data;
+    private int dataUsed;
+    private bool returned;
+
+    [DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneo_transmitMessages")]
+    private static extern bool TransmitMessages(HandleRef device, NeoMessage* messages, uint count);
+
+    internal NeoBuffer(NeoBufferPool pool, int capacity, int dataCapacity) {
+        this.pool = pool;
+        Capacity = capacity;
+        DataCapacity = dataCapacity;
+        messages = (NeoMessage*)Marshal.AllocHGlobal(capacity * sizeof(NeoMessage));
+        data = dataCapacity == 0 ? null : (byte*)Marshal.AllocHGlobal(dataCapacity);
+    }
+
+    ~NeoBuffer() {
+        FreeMemory();
+    }
+
+    public int Capacity { get; }
+    public int DataCapacity { get; }
+
+    /// <summary>
+    /// The number of messages in the buffer, polled or added
+    /// </summary>
+    public int Count { get; private set; }
+
+    public Span<NeoMessage> Messages { get { return new Span<NeoMessage>(messages, Count); } }
+
+    /// <summary>
+    /// Replaces the contents of the buffer with up to Capacity messages from the device which pass filter.
+    /// A null filter passes everything.
+    /// </summary>
+    public bool Poll(neodevice_t device, ulong timeout, SWIGTYPE_p_icsneocsharp_filter_t filter = null) {
+        Clear();
+        bool result = NeoMessages.GetMessages(device, filter, new Span<NeoMessage>(messages, Capacity), out int count, timeout);
+        Count = count;
+        return result;
+    }
+
+    public void Clear() {
+        Count = 0;
+        dataUsed = 0;
+    }
+
+    /// <summary>
+    /// Adds a CAN frame to transmit, copying payload into the buffer.
+    /// Returns false if the buffer has no room left for the frame or its payload.
+    /// </summary>
+    public bool AddCan(int netid, uint arbid, ReadOnlySpan<byte> payload, bool extended = false, bool canfd = false, bool brs = false) {
+        if(Count == Capacity || payload.Length > DataCapacity - dataUsed)
+            return false;
+
+        byte* payloadCopy = data + dataUsed;
+        payload.CopyTo(new Span<byte>(payloadCopy, payload.Length));
+        dataUsed += payload.Length;
+
+        NeoMessage* slot = messages + Count++;
+        *slot = default(NeoMessage);
+        ref NeoMessageCan frame = ref NeoMessages.AsCan(ref *slot);
+        frame.data = (IntPtr)payloadCopy;
+        frame.length = (UIntPtr)(uint)payload.Length;
+        frame.arbid = arbid;
+        frame.netid = (ushort)netid;
+        frame.type = (byte)icsneocsharp.ICSNEO_NETWORK_TYPE_CAN;
+        if(extended)
+            frame.statusBitfield[0] |= NeoMessages.STATUS_EXTENDED_FRAME;
+        if(canfd)
+            frame.statusBitfield[3] |= NeoMessages.STATUS_CANFD_FDF;
+        if(brs)
+            frame.statusBitfield[3] |= NeoMessages.STATUS_CANFD_BRS;
+        return true;
+    }
+
+    /// <summary>
+    /// Transmits every message in the buffer with one icsneo_transmitMessages. The buffer keeps them, Clear it to build the next batch.
+    /// </summary>
+    public bool Transmit(neodevice_t device) {
+        if(Count == 0)
+            return true;
+        return TransmitMessages(neodevice_t.getCPtr(device), messages, (uint)Count);
+    }
+
+    /// <summary>
+    /// Returns the buffer to its pool. It must not be used afterwards.
+    /// </summary>
+    public void Dispose() {
+        if(returned)
+            return;
+        returned = true;
+        Clear();
+        pool.Return(this);
+    }
+
+    internal void Rented() {
+        returned = false;
+    }
+
+    internal void Free() {
+        FreeMemory();
+        GC.SuppressFinalize(this);
+    }
+
+    private void FreeMemory() {
+        if(messages != null) {
+            Marshal.FreeHGlobal((IntPtr)messages);
+            messages = null;
+        }
+        if(data != null) {
+            Marshal.FreeHGlobal((IntPtr)data);
+            data = null;
+        }
+    }
+}
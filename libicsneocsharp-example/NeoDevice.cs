@@ -0,0 +1,193 @@
+using System;
+using System.Collections.Concurrent;
+using System.Runtime.InteropServices;
+using System.Text;
+
+/// <summary>
+/// neodevice_t as a blittable struct, so icsneo_findAllDevices can fill a managed array in place rather than
+/// a native array copied out one neodevice_t proxy at a time. ToDevice makes a proxy for the calls which need one.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct NeoDevice {
+    public IntPtr device;
+    public int handle;
+    public uint type;
+    public fixed byte serial[7];
+
+    /// <summary>
+    /// The serial number, decoded the first time it is seen and the same string every time after
+    /// </summary>
+    public string Serial {
+        get {
+            fixed(byte* bytes = serial)
+                return NeoDevices.InternSerial(bytes);
+        }
+    }
+
+    /// <summary>
+    /// Compares the serial number without decoding it
+    /// </summary>
+    public bool SerialEquals(string other) {
+        fixed(byte* bytes = serial)
+            return NeoDevices.SerialEquals(bytes, other);
+    }
+
+    /// <summary>
+    /// A copy of the device in a new native neodevice_t, for the icsneocsharp functions which take one
+    /// </summary>
+    public neodevice_t ToDevice() {
+        neodevice_t proxy = new neodevice_t();
+        *(NeoDevice*)neodevice_t.getCPtr(proxy).Handle = this;
+        return proxy;
+    }
+}
+
+/// <summary>
+/// neoevent_t as a blittable struct. description points at a string icsneoc keeps for as long as it is loaded,
+/// Description decodes it once per event number and returns the same string every time after.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct NeoEvent {
+    public IntPtr description;
+    public long timestamp;
+    public uint eventNumber;
+    public byte severity;
+    public fixed byte serial[7];
+    public fixed byte reserved[16];
+
+    public string Description { get { return NeoDevices.InternDescription(eventNumber, description); } }
+
+    /// <summary>
+    /// The serial number of the device the event is for, empty for API events
+    /// </summary>
+    public string Serial {
+        get {
+            fixed(byte* bytes = serial)
+                return NeoDevices.InternSerial(bytes);
+        }
+    }
+}
+
+/// <summary>
+/// Finds devices and gets events straight into a pinned NeoDevice or NeoEvent array or span, in one call each,
+/// rather than a native array read back through a new proxy per element.
+/// </summary>
+public static class NeoDevices {
+    private const int SERIAL_LENGTH = 7;
+
+    // The sizes of neodevice_t and neoevent_t, time_t is 64 bits on every 64-bit platform and on Windows
+    private static readonly int NEODEVICE_SIZE = IntPtr.Size == 8 ? 24 : 20;
+    private const int NEOEVENT_SIZE = 48;
+
+    private static readonly ConcurrentDictionary<ulong, string> serials = new ConcurrentDictionary<ulong, string>();
+    private static readonly ConcurrentDictionary<uint, string> descriptions = new ConcurrentDictionary<uint, string>();
+
+    static NeoDevices() {
+        if(Marshal.SizeOf<NeoDevice>() != NEODEVICE_SIZE || Marshal.SizeOf<NeoEvent>() != NEOEVENT_SIZE)
+            throw new PlatformNotSupportedException("NeoDevice or NeoEvent does not match neodevice_t or neoevent_t on this platform");
+    }
+
+    // The generated wrappers pass these size_t counts as ref int, which is too small on 64-bit platforms
+    [DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneo_findAllDevices")]
+    private static extern unsafe void FindAllDevices(NeoDevice* devices, ref UIntPtr count);
+
+    [DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneo_getEvents")]
+    private static extern unsafe bool GetEventsNative(NeoEvent* events, ref UIntPtr size);
+
+    [DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneo_getDeviceEvents")]
+    private static extern unsafe bool GetDeviceEventsNative(NeoDevice* device, NeoEvent* events, ref UIntPtr size);
+
+    [DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneo_getLastError")]
+    private static extern unsafe bool GetLastErrorNative(NeoEvent* error);
+
+    /// <summary>
+    /// icsneo_findAllDevices into devices, returning the number found, up to devices.Length
+    /// </summary>
+    public static unsafe int FindAll(Span<NeoDevice> devices) {
+        UIntPtr count = (UIntPtr)(uint)devices.Length;
+        fixed(NeoDevice* pinned = devices)
+            FindAllDevices(pinned, ref count);
+        return (int)count.ToUInt32();
+    }
+
+    /// <summary>
+    /// icsneo_getEvents into events, which takes them from icsneoc.
+    /// count is the number of events written to the start of events.
+    /// </summary>
+    public static unsafe bool GetEvents(Span<NeoEvent> events, out int count) {
+        UIntPtr size = (UIntPtr)(uint)events.Length;
+        fixed(NeoEvent* pinned = events) {
+            if(!GetEventsNative(pinned, ref size)) {
+                count = 0;
+                return false;
+            }
+        }
+        count = (int)size.ToUInt32();
+        return true;
+    }
+
+    /// <summary>
+    /// icsneo_getDeviceEvents for a device from FindAll
+    /// </summary>
+    public static unsafe bool GetDeviceEvents(ref NeoDevice device, Span<NeoEvent> events, out int count) {
+        fixed(NeoDevice* pinned = &device)
+            return GetDeviceEvents(pinned, events, out count);
+    }
+
+    /// <summary>
+    /// icsneo_getDeviceEvents for a device proxy
+    /// </summary>
+    public static unsafe bool GetDeviceEvents(neodevice_t device, Span<NeoEvent> events, out int count) {
+        return GetDeviceEvents((NeoDevice*)neodevice_t.getCPtr(device).Handle, events, out count);
+    }
+
+    public static unsafe bool GetLastError(out NeoEvent error) {
+        error = default(NeoEvent);
+        fixed(NeoEvent* pinned = &error)
+            return GetLastErrorNative(pinned);
+    }
+
+    private static unsafe bool GetDeviceEvents(NeoDevice* device, Span<NeoEvent> events, out int count) {
+        UIntPtr size = (UIntPtr)(uint)events.Length;
+        fixed(NeoEvent* pinned = events) {
+            if(!GetDeviceEventsNative(device, pinned, ref size)) {
+                count = 0;
+                return false;
+            }
+        }
+        count = (int)size.ToUInt32();
+        return true;
+    }
+
+    // Serials are looked up by their bytes, up to the terminator, so a serial seen before costs no allocation
+    internal static unsafe string InternSerial(byte* serial) {
+        ulong key = 0;
+        int length = 0;
+        while(length < SERIAL_LENGTH && serial[length] != 0) {
+            key |= (ulong)serial[length] << (length * 8);
+            length++;
+        }
+        if(serials.TryGetValue(key, out string value))
+            return value;
+        return serials.GetOrAdd(key, Encoding.ASCII.GetString(serial, length));
+    }
+
+    internal static unsafe bool SerialEquals(byte* serial, string other) {
+        if(other == null || other.Length > SERIAL_LENGTH)
+            return false;
+        for(int i = 0; i < other.Length; i++) {
+            if(serial[i] != other[i])
+                return false;
+        }
+        return other.Length == SERIAL_LENGTH || serial[other.Length] == 0;
+    }
+
+    // icsneoc describes every event with the same string for its event number
+    internal static string InternDescription(uint eventNumber, IntPtr description) {
+        if(descriptions.TryGetValue(eventNumber, out string value))
+            return value;
+        if(description == IntPtr.Zero)
+            return null;
+        return descriptions.GetOrAdd(eventNumber, Marshal.PtrToStringAnsi(description));
+    }
+}
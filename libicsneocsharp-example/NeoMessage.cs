@@ -0,0 +1,125 @@
+using System;
+using System.Runtime.InteropServices;
+
+/// <summary>
+/// neomessage_t as a blittable struct, laid out exactly as icsneoc lays it out, so icsneo_getMessages can fill
+/// a managed array in place. Reading a field is a plain memory load, where a neomessage_t proxy property is a
+/// P/Invoke call each. data points into memory owned by icsneoc, which stays valid until the next poll,
+/// Data views it in place and CopyData copies it out to keep.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct NeoMessage {
+    public fixed uint statusBitfield[4];
+    public ulong timestamp;
+    public ulong timestampReserved;
+    public IntPtr data;
+    public UIntPtr length;
+    public fixed byte header[4];
+    public ushort netid;
+    public byte type;
+    public fixed byte reserved[17];
+
+    public bool globalError { get { return (statusBitfield[0] & NeoMessages.STATUS_GLOBAL_ERROR) != 0; } }
+    public bool transmitMessage { get { return (statusBitfield[0] & NeoMessages.STATUS_TRANSMIT_MESSAGE) != 0; } }
+
+    public ReadOnlySpan<byte> Data { get { return new ReadOnlySpan<byte>((void*)data, (int)length.ToUInt64()); } }
+
+    public byte[] CopyData() {
+        return Data.ToArray();
+    }
+}
+
+/// <summary>
+/// neomessage_can_t as a blittable struct. It is the same size as NeoMessage, use NeoMessages.AsCan to view
+/// polled messages of type ICSNEO_NETWORK_TYPE_CAN as CAN messages without copying them.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct NeoMessageCan {
+    public fixed uint statusBitfield[4];
+    public ulong timestamp;
+    public ulong timestampReserved;
+    public IntPtr data;
+    public UIntPtr length;
+    public uint arbid;
+    public ushort netid;
+    public byte type;
+    public byte dlcOnWire;
+    public fixed byte reserved[16];
+
+    public bool globalError { get { return (statusBitfield[0] & NeoMessages.STATUS_GLOBAL_ERROR) != 0; } }
+    public bool transmitMessage { get { return (statusBitfield[0] & NeoMessages.STATUS_TRANSMIT_MESSAGE) != 0; } }
+    public bool extendedFrame { get { return (statusBitfield[0] & NeoMessages.STATUS_EXTENDED_FRAME) != 0; } }
+    public bool remoteFrame { get { return (statusBitfield[0] & NeoMessages.STATUS_REMOTE_FRAME) != 0; } }
+    public bool canfdFDF { get { return (statusBitfield[3] & NeoMessages.STATUS_CANFD_FDF) != 0; } }
+    public bool canfdBRS { get { return (statusBitfield[3] & NeoMessages.STATUS_CANFD_BRS) != 0; } }
+
+    public ReadOnlySpan<byte> Data { get { return new ReadOnlySpan<byte>((void*)data, (int)length.ToUInt64()); } }
+
+    public byte[] CopyData() {
+        return Data.ToArray();
+    }
+}
+
+/// <summary>
+/// Polls messages straight into a pinned NeoMessage array or span, rather than a native neomessage_t array
+/// read one proxy property at a time.
+/// </summary>
+public static class NeoMessages {
+    // Bits of neomessage_statusbitfield_t, by the word of statusBitfield they are in
+    public const uint STATUS_GLOBAL_ERROR = 0x1;        // Word 0
+    public const uint STATUS_TRANSMIT_MESSAGE = 0x2;    // Word 0
+    public const uint STATUS_EXTENDED_FRAME = 0x4;      // Word 0
+    public const uint STATUS_REMOTE_FRAME = 0x8;        // Word 0
+    public const uint STATUS_CANFD_FDF = 0x10;          // Word 3
+    public const uint STATUS_CANFD_BRS = 0x20;          // Word 3
+
+    // The size of neomessage_t on every platform icsneoc supports
+    private static readonly int NEOMESSAGE_SIZE = IntPtr.Size == 8 ? 72 : 64;
+
+    static NeoMessages() {
+        if(Marshal.SizeOf<NeoMessage>() != NEOMESSAGE_SIZE || Marshal.SizeOf<NeoMessageCan>() != NEOMESSAGE_SIZE)
+            throw new PlatformNotSupportedException("NeoMessage does not match the size of neomessage_t on this platform");
+    }
+
+    // icsneocsharp_getMessagesFiltered, with the message array as a plain pointer so it can be pinned managed memory
+    [DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_getMessagesFiltered")]
+    private static extern unsafe bool GetMessagesFiltered(HandleRef device, HandleRef filter, NeoMessage* messages, ref int items, ulong timeout);
+
+    /// <summary>
+    /// icsneo_getMessages into messages, which is pinned for the duration of the call.
+    /// count is the number of messages written to the start of messages.
+    /// </summary>
+    public static bool GetMessages(neodevice_t device, Span<NeoMessage> messages, out int count, ulong timeout) {
+        return GetMessages(device, null, messages, out count, timeout);
+    }
+
+    /// <summary>
+    /// icsneocsharp_getMessagesFiltered into messages, only keeping the messages which pass filter.
+    /// The device is polled into native memory and only the messages which pass are copied into messages.
+    /// A null filter passes everything.
+    /// </summary>
+    public static unsafe bool GetMessages(neodevice_t device, SWIGTYPE_p_icsneocsharp_filter_t filter, Span<NeoMessage> messages, out int count, ulong timeout) {
+        count = messages.Length;
+        fixed(NeoMessage* pinned = messages) {
+            if(!GetMessagesFiltered(neodevice_t.getCPtr(device), SWIGTYPE_p_icsneocsharp_filter_t.getCPtr(filter), pinned, ref count, timeout)) {
+                count = 0;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// Views messages as CAN messages, check each one's type is ICSNEO_NETWORK_TYPE_CAN before using it
+    /// </summary>
+    public static Span<NeoMessageCan> AsCan(Span<NeoMessage> messages) {
+        return MemoryMarshal.Cast<NeoMessage, NeoMessageCan>(messages);
+    }
+
+    /// <summary>
+    /// Views one message as a CAN message, check its type is ICSNEO_NETWORK_TYPE_CAN before using it
+    /// </summary>
+    public static ref NeoMessageCan AsCan(ref NeoMessage message) {
+        return ref AsCan(MemoryMarshal.CreateSpan(ref message, 1))[0];
+    }
+}
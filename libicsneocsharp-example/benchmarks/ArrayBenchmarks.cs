@@ -0,0 +1,90 @@
+using BenchmarkDotNet.Attributes;
+
+namespace libicsneocsharp_benchmarks {
+    /// <summary>
+    /// The %array_functions helpers around device discovery and events. FindAllDevices allocates a native
+    /// neodevice_t array, fills it and copies the device out with getitem, as the interactive example does on
+    /// every scan. GetEvents polls the event queue into a neoevent_t array, which the simulated device leaves empty,
+    /// so it is the cost of the calls themselves. The getitem benchmarks copy one element out into a new proxy and read a field.
+    /// The Bulk benchmarks do the same into reused NeoDevice and NeoEvent arrays, with the serial interned.
+    /// </summary>
+    [MemoryDiagnoser]
+    public class ArrayBenchmarks {
+        private const int CAPACITY = 99;
+
+        private SimulatedDevice sim;
+        private neodevice_t devices;
+        private neoevent_t events;
+        private SizeT count;
+        private NeoDevice[] bulkDevices = new NeoDevice[CAPACITY];
+        private NeoEvent[] bulkEvents = new NeoEvent[CAPACITY];
+
+        [GlobalSetup]
+        public void Setup() {
+            sim = new SimulatedDevice();
+            devices = icsneocsharp.new_neodevice_t_array(CAPACITY);
+            events = icsneocsharp.new_neoevent_t_array(CAPACITY);
+            count.value = CAPACITY;
+            icsneocsharp.icsneo_findAllDevices(devices, ref count.value);
+        }
+
+        [GlobalCleanup]
+        public void Cleanup() {
+            icsneocsharp.delete_neoevent_t_array(events);
+            icsneocsharp.delete_neodevice_t_array(devices);
+            sim.Dispose();
+        }
+
+        [Benchmark]
+        public string FindAllDevices() {
+            neodevice_t found = icsneocsharp.new_neodevice_t_array(CAPACITY);
+            count.value = CAPACITY;
+            count.high = 0;
+            icsneocsharp.icsneo_findAllDevices(found, ref count.value);
+            string serial = null;
+            for(int i = 0; i < count.value; i++) {
+                using(neodevice_t device = icsneocsharp.neodevice_t_array_getitem(found, i))
+                    serial = device.serial;
+            }
+            icsneocsharp.delete_neodevice_t_array(found);
+            return serial;
+        }
+
+        [Benchmark]
+        public string FindAllDevicesBulk() {
+            int found = NeoDevices.FindAll(bulkDevices);
+            string serial = null;
+            for(int i = 0; i < found; i++)
+                serial = bulkDevices[i].Serial;
+            return serial;
+        }
+
+        [Benchmark]
+        public int GetEvents() {
+            count.value = CAPACITY;
+            count.high = 0;
+            if(!icsneocsharp.icsneo_getEvents(events, ref count.value))
+                return -1;
+            return count.value;
+        }
+
+        [Benchmark]
+        public int GetEventsBulk() {
+            if(!NeoDevices.GetEvents(bulkEvents, out int found))
+                return -1;
+            return found;
+        }
+
+        [Benchmark]
+        public uint DeviceGetItem() {
+            using(neodevice_t device = icsneocsharp.neodevice_t_array_getitem(devices, 0))
+                return device.type;
+        }
+
+        [Benchmark]
+        public uint EventGetItem() {
+            using(neoevent_t evt = icsneocsharp.neoevent_t_array_getitem(events, 0))
+                return evt.eventNumber;
+        }
+    }
+}
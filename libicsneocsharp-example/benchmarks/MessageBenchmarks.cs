@@ -0,0 +1,75 @@
+using BenchmarkDotNet.Attributes;
+
+namespace libicsneocsharp_benchmarks {
+    /// <summary>
+    /// Reading one CAN frame. Every property of a neomessage_can_t proxy is a P/Invoke call of its own, and status
+    /// also allocates a proxy. Data is a span over the native payload, CopyData copies it into a new byte[].
+    /// The casts wrap the same native message in a new proxy. The NeoMessageCan benchmarks read the same
+    /// fields from a blittable struct for comparison.
+    /// </summary>
+    [MemoryDiagnoser]
+    public class MessageBenchmarks {
+        private SimulatedDevice sim;
+        private neomessage_can_t canMessage;
+        private neomessage_t message;
+        private NeoMessage[] neoMessages = new NeoMessage[1];
+
+        [GlobalSetup]
+        public void Setup() {
+            sim = new SimulatedDevice();
+            canMessage = new neomessage_can_t();
+            canMessage.arbid = 0x120;
+            canMessage.length = 8;
+            canMessage.netid = (ushort)icsneocsharp.ICSNEO_NETID_HSCAN;
+            canMessage.type = (byte)icsneocsharp.ICSNEO_NETWORK_TYPE_CAN;
+            canMessage.data = new byte[8] { 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x11 };
+            message = icsneocsharp.from_can_neomessage_t_cast(canMessage);
+
+            if(!NeoMessages.GetMessages(sim.device, neoMessages, out int count, 0) || count != 1)
+                throw new System.InvalidOperationException("Could not poll a message from the simulated device");
+        }
+
+        [GlobalCleanup]
+        public void Cleanup() {
+            canMessage.Dispose();
+            sim.Dispose();
+        }
+
+        [Benchmark]
+        public long Properties() {
+            return canMessage.arbid + canMessage.netid + canMessage.type + (long)canMessage.timestamp + canMessage.length;
+        }
+
+        [Benchmark]
+        public uint Status() {
+            return canMessage.status.extendedFrame;
+        }
+
+        [Benchmark]
+        public byte Data() {
+            return canMessage.data[0];
+        }
+
+        [Benchmark]
+        public byte[] CopyData() {
+            return canMessage.CopyData();
+        }
+
+        [Benchmark]
+        public uint CanCast() {
+            using(neomessage_can_t can = icsneocsharp.neomessage_can_t_cast(message))
+                return can.arbid;
+        }
+
+        [Benchmark]
+        public long NeoMessageCanFields() {
+            ref NeoMessageCan can = ref NeoMessages.AsCan(ref neoMessages[0]);
+            return can.arbid + can.netid + can.type + (long)can.timestamp + (long)can.length.ToUInt64() + (can.extendedFrame ? 1 : 0);
+        }
+
+        [Benchmark]
+        public byte NeoMessageData() {
+            return neoMessages[0].Data[0];
+        }
+    }
+}
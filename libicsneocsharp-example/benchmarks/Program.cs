@@ -0,0 +1,9 @@
+using BenchmarkDotNet.Running;
+
+namespace libicsneocsharp_benchmarks {
+    class Program {
+        static void Main(string[] args) {
+            BenchmarkSwitcher.FromAssembly(typeof(Program).Assembly).Run(args);
+        }
+    }
+}
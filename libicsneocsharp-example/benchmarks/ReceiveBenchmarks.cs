@@ -0,0 +1,86 @@
+using BenchmarkDotNet.Attributes;
+
+namespace libicsneocsharp_benchmarks {
+    /// <summary>
+    /// The cost per received message of polling the simulated device, which returns MESSAGES_PER_POLL CAN frames per poll.
+    /// Poll is icsneo_getMessages alone, PollAndRead also copies every message out with getitem and reads its
+    /// fields and data through the proxies, as the interactive example used to. PollNeoMessages fills a
+    /// NeoMessage[] in place and reads the same fields from the structs, PollPooled does the same into a pooled NeoBuffer.
+    /// </summary>
+    [MemoryDiagnoser]
+    public class ReceiveBenchmarks {
+        private const int CAPACITY = 1000;
+
+        private SimulatedDevice sim;
+        private neomessage_t messages;
+        private NeoMessage[] neoMessages = new NeoMessage[CAPACITY];
+        private SizeT items;
+        private NeoBufferPool pool = new NeoBufferPool(CAPACITY, 0);
+        private NeoBuffer buffer;
+
+        [GlobalSetup]
+        public void Setup() {
+            sim = new SimulatedDevice();
+            messages = icsneocsharp.new_neomessage_t_array(CAPACITY);
+            buffer = pool.Rent();
+        }
+
+        [GlobalCleanup]
+        public void Cleanup() {
+            icsneocsharp.delete_neomessage_t_array(messages);
+            buffer.Dispose();
+            pool.Dispose();
+            sim.Dispose();
+        }
+
+        [Benchmark(OperationsPerInvoke = SimulatedDevice.MESSAGES_PER_POLL)]
+        public int Poll() {
+            items.value = CAPACITY;
+            items.high = 0;
+            if(!icsneocsharp.icsneo_getMessages(sim.device, messages, ref items.value, 0))
+                return -1;
+            return items.value;
+        }
+
+        [Benchmark(OperationsPerInvoke = SimulatedDevice.MESSAGES_PER_POLL)]
+        public long PollAndRead() {
+            long sum = 0;
+            items.value = CAPACITY;
+            items.high = 0;
+            if(!icsneocsharp.icsneo_getMessages(sim.device, messages, ref items.value, 0))
+                return -1;
+            for(int i = 0; i < items.value; i++) {
+                using(neomessage_t message = icsneocsharp.neomessage_t_array_getitem(messages, i)) {
+                    sum += message.netid + (long)message.timestamp + message.length;
+                    sum += message.data[0];
+                }
+            }
+            return sum;
+        }
+
+        [Benchmark(OperationsPerInvoke = SimulatedDevice.MESSAGES_PER_POLL)]
+        public long PollNeoMessages() {
+            long sum = 0;
+            if(!NeoMessages.GetMessages(sim.device, neoMessages, out int count, 0))
+                return -1;
+            for(int i = 0; i < count; i++) {
+                ref NeoMessage message = ref neoMessages[i];
+                sum += message.netid + (long)message.timestamp + (long)message.length.ToUInt64();
+                sum += message.Data[0];
+            }
+            return sum;
+        }
+
+        [Benchmark(OperationsPerInvoke = SimulatedDevice.MESSAGES_PER_POLL)]
+        public long PollPooled() {
+            long sum = 0;
+            if(!buffer.Poll(sim.device, 0))
+                return -1;
+            foreach(ref NeoMessage message in buffer.Messages) {
+                sum += message.netid + (long)message.timestamp + (long)message.length.ToUInt64();
+                sum += message.Data[0];
+            }
+            return sum;
+        }
+    }
+}
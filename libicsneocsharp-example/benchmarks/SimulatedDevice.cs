@@ -0,0 +1,59 @@
+using System;
+using System.Reflection;
+using System.Runtime.InteropServices;
+
+namespace libicsneocsharp_benchmarks {
+    /// <summary>
+    /// The simulated device, open, online and polling. It only exists when icsneocsharp is built with
+    /// -DICSNEOCSHARP_SIMULATED_DEVICE=ON, which links it against the simulated icsneoc rather than libicsneo.
+    /// A real device is refused, as the transmit benchmarks would put their frames on its bus.
+    /// </summary>
+    sealed class SimulatedDevice : IDisposable {
+        public const string SERIAL = "SIM001";
+        // What the simulated device returns per poll, unless ICSNEOSIM_MESSAGES_PER_POLL says otherwise
+        public const int MESSAGES_PER_POLL = 100;
+
+        private readonly neodevice_t devices;
+        public readonly neodevice_t device;
+
+        static SimulatedDevice() {
+            // The binding imports "icsneocsharp.dll", which is libicsneocsharp.so everywhere but Windows
+            NativeLibrary.SetDllImportResolver(typeof(SimulatedDevice).Assembly, (string name, Assembly assembly, DllImportSearchPath? path) => {
+                if(name == "icsneocsharp.dll" && !RuntimeInformation.IsOSPlatform(OSPlatform.Windows))
+                    return NativeLibrary.Load("icsneocsharp", assembly, path);
+                return IntPtr.Zero;
+            });
+        }
+
+        public SimulatedDevice() {
+            devices = icsneocsharp.new_neodevice_t_array(1);
+            // size_t *count is written back as 8 bytes, so it gets a SizeT rather than a lone int
+            SizeT count = new SizeT { value = 1 };
+            icsneocsharp.icsneo_findAllDevices(devices, ref count.value);
+            if(count.value == 0)
+                throw new InvalidOperationException("No devices found, build icsneocsharp with -DICSNEOCSHARP_SIMULATED_DEVICE=ON");
+
+            device = icsneocsharp.neodevice_t_array_getitem(devices, 0);
+            if(device.serial != SERIAL)
+                throw new InvalidOperationException("Found " + device.serial + " rather than the simulated device, build icsneocsharp with -DICSNEOCSHARP_SIMULATED_DEVICE=ON");
+
+            if(!icsneocsharp.icsneo_openDevice(device) || !icsneocsharp.icsneo_goOnline(device) || !icsneocsharp.icsneo_enableMessagePolling(device))
+                throw new InvalidOperationException("Could not bring up the simulated device");
+        }
+
+        public void Dispose() {
+            if(!icsneocsharp.icsneo_closeDevice(device))
+                Console.Error.WriteLine("Could not close the simulated device");
+            icsneocsharp.delete_neodevice_t_array(devices);
+        }
+    }
+
+    /// <summary>
+    /// Room for a size_t which the binding passes as ref int. The native side writes all of it, value gets the low half.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    struct SizeT {
+        public int value;
+        public int high;
+    }
+}
@@ -0,0 +1,89 @@
+using BenchmarkDotNet.Attributes;
+
+namespace libicsneocsharp_benchmarks {
+    /// <summary>
+    /// The cost per frame of transmitting to the simulated device, which copies and counts each frame.
+    /// Transmit sends one prebuilt frame, BuildAndTransmit builds it with the setters first, as the interactive
+    /// example used to. TransmitMessages sends BATCH frames per call from a neomessage_t array filled with setitem.
+    /// The pooled benchmarks build the frames in a NeoBuffer instead, one at a time and BATCH at a time.
+    /// </summary>
+    [MemoryDiagnoser]
+    public class TransmitBenchmarks {
+        private const int BATCH = 100;
+
+        private SimulatedDevice sim;
+        private byte[] payload = { 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x11 };
+        private neomessage_can_t canMessage;
+        private neomessage_t message;
+        private neomessage_t messages;
+        private neomessage_can_t[] frames = new neomessage_can_t[BATCH];
+        private NeoBufferPool pool = new NeoBufferPool(BATCH, BATCH * 8);
+
+        [GlobalSetup]
+        public void Setup() {
+            sim = new SimulatedDevice();
+            canMessage = Build(0x120);
+            message = icsneocsharp.from_can_neomessage_t_cast(canMessage);
+
+            messages = icsneocsharp.new_neomessage_t_array(BATCH);
+            for(int i = 0; i < BATCH; i++) {
+                frames[i] = Build(0x120 + (uint)i);
+                // setitem copies the struct but shares its data, which is freed with the frame, so the frames are kept
+                icsneocsharp.neomessage_t_array_setitem(messages, i, icsneocsharp.from_can_neomessage_t_cast(frames[i]));
+            }
+        }
+
+        [GlobalCleanup]
+        public void Cleanup() {
+            icsneocsharp.delete_neomessage_t_array(messages);
+            foreach(neomessage_can_t frame in frames)
+                frame.Dispose();
+            canMessage.Dispose();
+            pool.Dispose();
+            sim.Dispose();
+        }
+
+        private neomessage_can_t Build(uint arbid) {
+            neomessage_can_t msg = new neomessage_can_t();
+            msg.arbid = arbid;
+            msg.length = (uint)payload.Length;
+            msg.netid = (ushort)icsneocsharp.ICSNEO_NETID_HSCAN;
+            msg.type = (byte)icsneocsharp.ICSNEO_NETWORK_TYPE_CAN;
+            msg.data = payload;
+            return msg;
+        }
+
+        [Benchmark]
+        public bool Transmit() {
+            return icsneocsharp.icsneo_transmit(sim.device, message);
+        }
+
+        [Benchmark]
+        public bool BuildAndTransmit() {
+            using(neomessage_can_t msg = Build(0x120))
+                return icsneocsharp.icsneo_transmit(sim.device, icsneocsharp.from_can_neomessage_t_cast(msg));
+        }
+
+        [Benchmark(OperationsPerInvoke = BATCH)]
+        public bool TransmitMessages() {
+            return icsneocsharp.icsneo_transmitMessages(sim.device, messages, BATCH);
+        }
+
+        [Benchmark]
+        public bool TransmitPooled() {
+            using(NeoBuffer buffer = pool.Rent()) {
+                buffer.AddCan(icsneocsharp.ICSNEO_NETID_HSCAN, 0x120, payload);
+                return buffer.Transmit(sim.device);
+            }
+        }
+
+        [Benchmark(OperationsPerInvoke = BATCH)]
+        public bool TransmitMessagesPooled() {
+            using(NeoBuffer buffer = pool.Rent()) {
+                for(int i = 0; i < BATCH; i++)
+                    buffer.AddCan(icsneocsharp.ICSNEO_NETID_HSCAN, 0x120 + (uint)i, payload);
+                return buffer.Transmit(sim.device);
+            }
+        }
+    }
+}
@@ -8,36 +8,76 @@
 #define DLLExport
 
 %typemap(ctype) uint8_t const *data "unsigned char *" 
-%typemap(imtype, out="System.IntPtr") uint8_t const *data "byte[]"
-%typemap(cstype) uint8_t const *data "byte[]"
+%typemap(imtype, out="System.IntPtr") uint8_t const *data "System.IntPtr"
+%typemap(cstype) uint8_t const *data "System.ReadOnlySpan<byte>"
 
 %typemap(in) uint8_t const *data %{
 	$1 = $input;
 %}
 
+/* Setting data copies the payload into memory the message owns, see icsneocsharp_setData */
 %typemap(csvarin) uint8_t const *data %{
 	set {
-		icsneocsharpPINVOKE.$csclazznamedata_set(swigCPtr, value);
+		unsafe {
+			fixed(byte* bytes = value) {
+				if(!icsneocsharpPINVOKE.icsneocsharp_setData(swigCPtr, new global::System.Runtime.InteropServices.HandleRef(null, (System.IntPtr)bytes), value.Length))
+					throw new System.OutOfMemoryException("Unable to allocate the message data");
+			}
+		}
 	}
 %}
 
+/* data is a view of the payload in place, valid until the next poll, or until the message is changed or disposed */
 %typemap(csvarout, excode=SWIGEXCODE2) uint8_t const *data %{
 	get {
-		byte[] ret = new byte[this.length]; 
-        System.IntPtr data = $imcall; 
-        System.Runtime.InteropServices.Marshal.Copy(data, ret, 0, (int)this.length)$excode;
-		return ret; 
+		System.IntPtr data = $imcall;$excode
+		unsafe {
+			return new System.ReadOnlySpan<byte>((void*)data, (int)this.length);
+		}
 	}
 %}
 
+%typemap(cscode) neomessage_t, neomessage_can_t, neomessage_eth_t %{
+  // Copies the payload out of native memory, for keeping it after the poll it came from
+  public byte[] CopyData() {
+    return data.ToArray();
+  }
+%}
+
 %typemap(ctype) char *str "char *"
 %typemap(imtype) char *str "System.Text.StringBuilder"
 %typemap(cstype) char *str "System.Text.StringBuilder" 
 
 %{
 #include "icsneo/icsneoc.h"
+
+/* Gives the shared structs the names the C# proxies are generated from */
+#define icsneobinding_filter_t icsneocsharp_filter_t
+#define icsneobinding_listener_t icsneocsharp_listener_t
+#include "icsneobinding.h"
 %}
 
+%extend neomessage_t {
+	~neomessage_t() {
+		icsneobinding_freeData($self);
+		free($self);
+	}
+}
+
+%extend neomessage_can_t {
+	~neomessage_can_t() {
+		icsneobinding_freeData($self);
+		free($self);
+	}
+}
+
+%extend neomessage_eth_t {
+	~neomessage_eth_t() {
+		icsneobinding_freeData($self);
+		free($self);
+	}
+}
+
 %apply int *INOUT {size_t *};
 
 %ignore icsneo_addMessageCallback;
@@ -73,4 +113,156 @@ static neomessage_t* from_eth_neomessage_t_cast(neomessage_eth_t* msg) {
 
 %array_functions(neodevice_t, neodevice_t_array);
 %array_functions(neoevent_t, neoevent_t_array);
-%array_functions(neomessage_t, neomessage_t_array);
\ No newline at end of file
+%array_functions(neomessage_t, neomessage_t_array);
+
+%apply int *INOUT { int *items };
+
+/* The filters are implemented in icsneobinding.h, which icsneojava shares */
+%rename(icsneocsharp_newFilter) icsneobinding_newFilter;
+%rename(icsneocsharp_deleteFilter) icsneobinding_deleteFilter;
+%rename(icsneocsharp_clearFilter) icsneobinding_clearFilter;
+%rename(icsneocsharp_filterAddNetid) icsneobinding_filterAddNetid;
+%rename(icsneocsharp_filterAddType) icsneobinding_filterAddType;
+%rename(icsneocsharp_filterAddArbidRange) icsneobinding_filterAddArbidRange;
+%rename(icsneocsharp_getMessagesFiltered) icsneobinding_getMessagesFiltered;
+
+%inline %{
+typedef struct icsneocsharp_filter_t icsneocsharp_filter_t;
+%}
+
+icsneocsharp_filter_t* icsneobinding_newFilter(void);
+void icsneobinding_deleteFilter(icsneocsharp_filter_t* filter);
+void icsneobinding_clearFilter(icsneocsharp_filter_t* filter);
+bool icsneobinding_filterAddNetid(icsneocsharp_filter_t* filter, int netid);
+bool icsneobinding_filterAddType(icsneocsharp_filter_t* filter, int type);
+bool icsneobinding_filterAddArbidRange(icsneocsharp_filter_t* filter, uint32_t low, uint32_t high, uint32_t mask);
+bool icsneobinding_getMessagesFiltered(const neodevice_t* device, const icsneocsharp_filter_t* filter, neomessage_t* messages, int* items, uint64_t timeout);
+
+%inline %{
+/*
+ * Sets the data of a neomessage_t, neomessage_can_t or neomessage_eth_t to a copy of length bytes, see
+ * icsneobinding_setData. Returns false if the copy could not be allocated. The data setters of the message proxies call this.
+ */
+static bool icsneocsharp_setData(void* message, const void* bytes, int length) {
+	if(length < 0)
+		return false;
+	return icsneobinding_setData(message, bytes, (size_t) length);
+}
+%}
+
+%{
+/*
+ * Message listeners, see icsneobinding.h, deliver received messages to managed code as an array of neomessage_t.
+ * Each message's payload is copied into the batch's data, and each batch's context is its array of messages.
+ * The runtime attaches the delivery thread itself on its first call into managed code.
+ */
+
+/* Called with a batch of messages, whose data points into the batch. Both are only valid until it returns. */
+typedef void (*icsneocsharp_onMessages_t)(const neomessage_t* messages, int count);
+
+typedef struct {
+	icsneocsharp_onMessages_t onMessages;
+} icsneocsharp_listenerContext_t;
+
+static bool icsneocsharp_storeMessage(struct icsneocsharp_listener_t* listener, icsneobinding_batch_t* batch, const neomessage_t* message) {
+	neomessage_t* copy;
+
+	if(message->length > listener->capacity - batch->used)
+		return false;
+	copy = &((neomessage_t*) batch->context)[batch->count];
+	*copy = *message;
+	copy->data = batch->data + batch->used;
+	if(message->length != 0 && message->data != NULL)
+		memcpy(batch->data + batch->used, message->data, message->length);
+	batch->used += message->length;
+	return true;
+}
+
+static void icsneocsharp_deliverMessages(struct icsneocsharp_listener_t* listener, icsneobinding_batch_t* batch) {
+	((icsneocsharp_listenerContext_t*) listener->context)->onMessages((const neomessage_t*) batch->context, (int) batch->count);
+}
+
+static const icsneobinding_listenerOps_t icsneocsharp_listenerOps = {
+	icsneocsharp_storeMessage, icsneocsharp_deliverMessages, NULL, NULL
+};
+
+/* Stops the delivery thread, once it has delivered what is left, and frees everything the listener holds */
+static void icsneocsharp_freeListener(struct icsneocsharp_listener_t* listener) {
+	int i;
+
+	icsneobinding_stopListener(listener);
+	for(i = 0; i < 2; i++)
+		free(listener->batches[i].context);
+	free(listener->context);
+	icsneobinding_freeListener(listener);
+}
+%}
+
+/* The callback is passed as a function pointer, from Marshal.GetFunctionPointerForDelegate */
+%typemap(ctype) icsneocsharp_onMessages_t "void *"
+%typemap(imtype) icsneocsharp_onMessages_t "System.IntPtr"
+%typemap(cstype) icsneocsharp_onMessages_t "System.IntPtr"
+%typemap(csin) icsneocsharp_onMessages_t "$csinput"
+%typemap(in) icsneocsharp_onMessages_t %{
+	$1 = ($1_ltype)$input;
+%}
+
+%inline %{
+typedef struct icsneocsharp_listener_t icsneocsharp_listener_t;
+
+/*
+ * Calls onMessages with batches of received messages which pass filter, see MessageListener.cs.
+ * filter is copied, so it can be changed or deleted afterwards, and NULL passes everything.
+ * Returns NULL on failure, including when all ICSNEOBINDING_MAX_LISTENERS listeners are in use.
+ */
+static icsneocsharp_listener_t* icsneocsharp_addMessageListener(const neodevice_t* device, icsneocsharp_onMessages_t onMessages, const icsneocsharp_filter_t* filter, int batchSize, uint64_t maxDelayMicroseconds) {
+	icsneocsharp_listenerContext_t* context;
+	icsneocsharp_listener_t* result;
+	int i;
+
+	if(device == NULL || onMessages == NULL || batchSize <= 0)
+		return NULL;
+
+	context = (icsneocsharp_listenerContext_t*) malloc(sizeof(icsneocsharp_listenerContext_t));
+	if(context == NULL)
+		return NULL;
+	context->onMessages = onMessages;
+	result = icsneobinding_newListener(device, &icsneocsharp_listenerOps, context, (size_t) batchSize, (size_t) batchSize * 64, maxDelayMicroseconds, filter);
+	if(result == NULL) {
+		free(context);
+		return NULL;
+	}
+
+	for(i = 0; i < 2; i++) {
+		result->batches[i].context = malloc(result->batchSize * sizeof(neomessage_t));
+		if(result->batches[i].context == NULL) {
+			icsneocsharp_freeListener(result);
+			return NULL;
+		}
+	}
+
+	if(!icsneobinding_startListener(result)) {
+		icsneocsharp_freeListener(result);
+		return NULL;
+	}
+	return result;
+}
+
+/*
+ * Stops the callbacks, delivers the messages already collected and frees the listener.
+ * Must not be called from within onMessages. Returns false, keeping the listener, if the callback could not be removed.
+ */
+static bool icsneocsharp_removeMessageListener(icsneocsharp_listener_t* listener) {
+	if(listener == NULL)
+		return false;
+	if(!icsneobinding_removeListener(listener))
+		return false;
+	icsneocsharp_freeListener(listener);
+	return true;
+}
+%}
+
+/* The rest of the listener is implemented in icsneobinding.h, which icsneojava shares */
+%rename(icsneocsharp_getMessageListenerDropped) icsneobinding_getMessageListenerDropped;
+
+uint64_t icsneobinding_getMessageListenerDropped(icsneocsharp_listener_t* listener);
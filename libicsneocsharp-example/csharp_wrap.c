@@ -280,6 +280,23 @@ SWIGEXPORT void SWIGSTDCALL SWIGRegisterStringCallback_icsneocsharp(SWIG_CSharpS
 
 #include "icsneo/icsneoc.h"
 
+/* Gives the shared structs the names the C# proxies are generated from */
+#define icsneobinding_filter_t icsneocsharp_filter_t
+#define icsneobinding_listener_t icsneocsharp_listener_t
+#include "icsneobinding.h"
+
+SWIGINTERN void delete_neomessage_t(neomessage_t *self){
+		icsneobinding_freeData(self);
+		free(self);
+	}
+SWIGINTERN void delete_neomessage_can_t(neomessage_can_t *self){
+		icsneobinding_freeData(self);
+		free(self);
+	}
+SWIGINTERN void delete_neomessage_eth_t(neomessage_eth_t *self){
+		icsneobinding_freeData(self);
+		free(self);
+	}
 
 static neomessage_can_t* neomessage_can_t_cast(neomessage_t* msg) {
 	return (neomessage_can_t*) msg;
@@ -346,6 +363,121 @@ static void neomessage_t_array_setitem(neomessage_t *ary, int index, neomessage_
 }
 
 
+typedef struct icsneocsharp_filter_t icsneocsharp_filter_t;
+
+
+/*
+ * Sets the data of a neomessage_t, neomessage_can_t or neomessage_eth_t to a copy of length bytes, see
+ * icsneobinding_setData. Returns false if the copy could not be allocated. The data setters of the message proxies call this.
+ */
+static bool icsneocsharp_setData(void* message, const void* bytes, int length) {
+	if(length < 0)
+		return false;
+	return icsneobinding_setData(message, bytes, (size_t) length);
+}
+
+
+/*
+ * Message listeners, see icsneobinding.h, deliver received messages to managed code as an array of neomessage_t.
+ * Each message's payload is copied into the batch's data, and each batch's context is its array of messages.
+ * The runtime attaches the delivery thread itself on its first call into managed code.
+ */
+
+/* Called with a batch of messages, whose data points into the batch. Both are only valid until it returns. */
+typedef void (*icsneocsharp_onMessages_t)(const neomessage_t* messages, int count);
+
+typedef struct {
+	icsneocsharp_onMessages_t onMessages;
+} icsneocsharp_listenerContext_t;
+
+static bool icsneocsharp_storeMessage(struct icsneocsharp_listener_t* listener, icsneobinding_batch_t* batch, const neomessage_t* message) {
+	neomessage_t* copy;
+
+	if(message->length > listener->capacity - batch->used)
+		return false;
+	copy = &((neomessage_t*) batch->context)[batch->count];
+	*copy = *message;
+	copy->data = batch->data + batch->used;
+	if(message->length != 0 && message->data != NULL)
+		memcpy(batch->data + batch->used, message->data, message->length);
+	batch->used += message->length;
+	return true;
+}
+
+static void icsneocsharp_deliverMessages(struct icsneocsharp_listener_t* listener, icsneobinding_batch_t* batch) {
+	((icsneocsharp_listenerContext_t*) listener->context)->onMessages((const neomessage_t*) batch->context, (int) batch->count);
+}
+
+static const icsneobinding_listenerOps_t icsneocsharp_listenerOps = {
+	icsneocsharp_storeMessage, icsneocsharp_deliverMessages, NULL, NULL
+};
+
+/* Stops the delivery thread, once it has delivered what is left, and frees everything the listener holds */
+static void icsneocsharp_freeListener(struct icsneocsharp_listener_t* listener) {
+	int i;
+
+	icsneobinding_stopListener(listener);
+	for(i = 0; i < 2; i++)
+		free(listener->batches[i].context);
+	free(listener->context);
+	icsneobinding_freeListener(listener);
+}
+
+
+typedef struct icsneocsharp_listener_t icsneocsharp_listener_t;
+
+/*
+ * Calls onMessages with batches of received messages which pass filter, see MessageListener.cs.
+ * filter is copied, so it can be changed or deleted afterwards, and NULL passes everything.
+ * Returns NULL on failure, including when all ICSNEOBINDING_MAX_LISTENERS listeners are in use.
+ */
+static icsneocsharp_listener_t* icsneocsharp_addMessageListener(const neodevice_t* device, icsneocsharp_onMessages_t onMessages, const icsneocsharp_filter_t* filter, int batchSize, uint64_t maxDelayMicroseconds) {
+	icsneocsharp_listenerContext_t* context;
+	icsneocsharp_listener_t* result;
+	int i;
+
+	if(device == NULL || onMessages == NULL || batchSize <= 0)
+		return NULL;
+
+	context = (icsneocsharp_listenerContext_t*) malloc(sizeof(icsneocsharp_listenerContext_t));
+	if(context == NULL)
+		return NULL;
+	context->onMessages = onMessages;
+	result = icsneobinding_newListener(device, &icsneocsharp_listenerOps, context, (size_t) batchSize, (size_t) batchSize * 64, maxDelayMicroseconds, filter);
+	if(result == NULL) {
+		free(context);
+		return NULL;
+	}
+
+	for(i = 0; i < 2; i++) {
+		result->batches[i].context = malloc(result->batchSize * sizeof(neomessage_t));
+		if(result->batches[i].context == NULL) {
+			icsneocsharp_freeListener(result);
+			return NULL;
+		}
+	}
+
+	if(!icsneobinding_startListener(result)) {
+		icsneocsharp_freeListener(result);
+		return NULL;
+	}
+	return result;
+}
+
+/*
+ * Stops the callbacks, delivers the messages already collected and frees the listener.
+ * Must not be called from within onMessages. Returns false, keeping the listener, if the callback could not be removed.
+ */
+static bool icsneocsharp_removeMessageListener(icsneocsharp_listener_t* listener) {
+	if(listener == NULL)
+		return false;
+	if(!icsneobinding_removeListener(listener))
+		return false;
+	icsneocsharp_freeListener(listener);
+	return true;
+}
+
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -2517,7 +2649,7 @@ SWIGEXPORT void SWIGSTDCALL CSharp_delete_neomessage_t(void * jarg1) {
   neomessage_t *arg1 = (neomessage_t *) 0 ;
   
   arg1 = (neomessage_t *)jarg1; 
-  free((char *) arg1);
+  delete_neomessage_t(arg1);
 }
 
 
@@ -2761,7 +2893,7 @@ SWIGEXPORT void SWIGSTDCALL CSharp_delete_neomessage_can_t(void * jarg1) {
   neomessage_can_t *arg1 = (neomessage_can_t *) 0 ;
   
   arg1 = (neomessage_can_t *)jarg1; 
-  free((char *) arg1);
+  delete_neomessage_can_t(arg1);
 }
 
 
@@ -3009,7 +3141,7 @@ SWIGEXPORT void SWIGSTDCALL CSharp_delete_neomessage_eth_t(void * jarg1) {
   neomessage_eth_t *arg1 = (neomessage_eth_t *) 0 ;
   
   arg1 = (neomessage_eth_t *)jarg1; 
-  free((char *) arg1);
+  delete_neomessage_eth_t(arg1);
 }
 
 
@@ -4707,6 +4839,159 @@ SWIGEXPORT void SWIGSTDCALL CSharp_neomessage_t_array_setitem(void * jarg1, int
 }
 
 
+SWIGEXPORT void * SWIGSTDCALL CSharp_icsneocsharp_newFilter() {
+  void * jresult ;
+  icsneocsharp_filter_t *result = 0 ;
+  
+  result = (icsneocsharp_filter_t *)icsneobinding_newFilter();
+  jresult = (void *)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT void SWIGSTDCALL CSharp_icsneocsharp_deleteFilter(void * jarg1) {
+  icsneocsharp_filter_t *arg1 = (icsneocsharp_filter_t *) 0 ;
+  
+  arg1 = (icsneocsharp_filter_t *)jarg1; 
+  icsneobinding_deleteFilter(arg1);
+}
+
+
+SWIGEXPORT void SWIGSTDCALL CSharp_icsneocsharp_clearFilter(void * jarg1) {
+  icsneocsharp_filter_t *arg1 = (icsneocsharp_filter_t *) 0 ;
+  
+  arg1 = (icsneocsharp_filter_t *)jarg1; 
+  icsneobinding_clearFilter(arg1);
+}
+
+
+SWIGEXPORT unsigned int SWIGSTDCALL CSharp_icsneocsharp_filterAddNetid(void * jarg1, int jarg2) {
+  unsigned int jresult ;
+  icsneocsharp_filter_t *arg1 = (icsneocsharp_filter_t *) 0 ;
+  int arg2 ;
+  bool result;
+  
+  arg1 = (icsneocsharp_filter_t *)jarg1; 
+  arg2 = (int)jarg2; 
+  result = (bool)icsneobinding_filterAddNetid(arg1,arg2);
+  jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT unsigned int SWIGSTDCALL CSharp_icsneocsharp_filterAddType(void * jarg1, int jarg2) {
+  unsigned int jresult ;
+  icsneocsharp_filter_t *arg1 = (icsneocsharp_filter_t *) 0 ;
+  int arg2 ;
+  bool result;
+  
+  arg1 = (icsneocsharp_filter_t *)jarg1; 
+  arg2 = (int)jarg2; 
+  result = (bool)icsneobinding_filterAddType(arg1,arg2);
+  jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT unsigned int SWIGSTDCALL CSharp_icsneocsharp_filterAddArbidRange(void * jarg1, unsigned int jarg2, unsigned int jarg3, unsigned int jarg4) {
+  unsigned int jresult ;
+  icsneocsharp_filter_t *arg1 = (icsneocsharp_filter_t *) 0 ;
+  uint32_t arg2 ;
+  uint32_t arg3 ;
+  uint32_t arg4 ;
+  bool result;
+  
+  arg1 = (icsneocsharp_filter_t *)jarg1; 
+  arg2 = (uint32_t)jarg2; 
+  arg3 = (uint32_t)jarg3; 
+  arg4 = (uint32_t)jarg4; 
+  result = (bool)icsneobinding_filterAddArbidRange(arg1,arg2,arg3,arg4);
+  jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT unsigned int SWIGSTDCALL CSharp_icsneocsharp_getMessagesFiltered(void * jarg1, void * jarg2, void * jarg3, int * jarg4, unsigned long long jarg5) {
+  unsigned int jresult ;
+  neodevice_t *arg1 = (neodevice_t *) 0 ;
+  icsneocsharp_filter_t *arg2 = (icsneocsharp_filter_t *) 0 ;
+  neomessage_t *arg3 = (neomessage_t *) 0 ;
+  int *arg4 = (int *) 0 ;
+  uint64_t arg5 ;
+  bool result;
+  
+  arg1 = (neodevice_t *)jarg1; 
+  arg2 = (icsneocsharp_filter_t *)jarg2; 
+  arg3 = (neomessage_t *)jarg3; 
+  arg4 = (int *)jarg4; 
+  arg5 = (uint64_t)jarg5; 
+  result = (bool)icsneobinding_getMessagesFiltered((neodevice_t const *)arg1,(icsneocsharp_filter_t const *)arg2,arg3,arg4,arg5);
+  jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT unsigned int SWIGSTDCALL CSharp_icsneocsharp_setData(void * jarg1, void * jarg2, int jarg3) {
+  unsigned int jresult ;
+  void *arg1 = (void *) 0 ;
+  void *arg2 = (void *) 0 ;
+  int arg3 ;
+  bool result;
+  
+  arg1 = (void *)jarg1; 
+  arg2 = (void *)jarg2; 
+  arg3 = (int)jarg3; 
+  result = (bool)icsneocsharp_setData(arg1,(void const *)arg2,arg3);
+  jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT void * SWIGSTDCALL CSharp_icsneocsharp_addMessageListener(void * jarg1, void * jarg2, void * jarg3, int jarg4, unsigned long long jarg5) {
+  void * jresult ;
+  neodevice_t *arg1 = (neodevice_t *) 0 ;
+  icsneocsharp_onMessages_t arg2 ;
+  icsneocsharp_filter_t *arg3 = (icsneocsharp_filter_t *) 0 ;
+  int arg4 ;
+  uint64_t arg5 ;
+  icsneocsharp_listener_t *result = 0 ;
+  
+  arg1 = (neodevice_t *)jarg1; 
+  
+  arg2 = (icsneocsharp_onMessages_t)jarg2;
+  
+  arg3 = (icsneocsharp_filter_t *)jarg3; 
+  arg4 = (int)jarg4; 
+  arg5 = (uint64_t)jarg5; 
+  result = (icsneocsharp_listener_t *)icsneocsharp_addMessageListener((neodevice_t const *)arg1,arg2,(icsneocsharp_filter_t const *)arg3,arg4,arg5);
+  jresult = (void *)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT unsigned int SWIGSTDCALL CSharp_icsneocsharp_removeMessageListener(void * jarg1) {
+  unsigned int jresult ;
+  icsneocsharp_listener_t *arg1 = (icsneocsharp_listener_t *) 0 ;
+  bool result;
+  
+  arg1 = (icsneocsharp_listener_t *)jarg1; 
+  result = (bool)icsneocsharp_removeMessageListener(arg1);
+  jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT unsigned long long SWIGSTDCALL CSharp_icsneocsharp_getMessageListenerDropped(void * jarg1) {
+  unsigned long long jresult ;
+  icsneocsharp_listener_t *arg1 = (icsneocsharp_listener_t *) 0 ;
+  uint64_t result;
+  
+  arg1 = (icsneocsharp_listener_t *)jarg1; 
+  result = (uint64_t)icsneobinding_getMessageListenerDropped(arg1);
+  jresult = result; 
+  return jresult;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -313,6 +313,61 @@ public class icsneocsharp {
     if (icsneocsharpPINVOKE.SWIGPendingException.Pending) throw icsneocsharpPINVOKE.SWIGPendingException.Retrieve();
   }
 
+  public static SWIGTYPE_p_icsneocsharp_filter_t icsneocsharp_newFilter() {
+    global::System.IntPtr cPtr = icsneocsharpPINVOKE.icsneocsharp_newFilter();
+    SWIGTYPE_p_icsneocsharp_filter_t ret = (cPtr == global::System.IntPtr.Zero) ? null : new SWIGTYPE_p_icsneocsharp_filter_t(cPtr, false);
+    return ret;
+  }
+
+  public static void icsneocsharp_deleteFilter(SWIGTYPE_p_icsneocsharp_filter_t filter) {
+    icsneocsharpPINVOKE.icsneocsharp_deleteFilter(SWIGTYPE_p_icsneocsharp_filter_t.getCPtr(filter));
+  }
+
+  public static void icsneocsharp_clearFilter(SWIGTYPE_p_icsneocsharp_filter_t filter) {
+    icsneocsharpPINVOKE.icsneocsharp_clearFilter(SWIGTYPE_p_icsneocsharp_filter_t.getCPtr(filter));
+  }
+
+  public static bool icsneocsharp_filterAddNetid(SWIGTYPE_p_icsneocsharp_filter_t filter, int netid) {
+    bool ret = icsneocsharpPINVOKE.icsneocsharp_filterAddNetid(SWIGTYPE_p_icsneocsharp_filter_t.getCPtr(filter), netid);
+    return ret;
+  }
+
+  public static bool icsneocsharp_filterAddType(SWIGTYPE_p_icsneocsharp_filter_t filter, int type) {
+    bool ret = icsneocsharpPINVOKE.icsneocsharp_filterAddType(SWIGTYPE_p_icsneocsharp_filter_t.getCPtr(filter), type);
+    return ret;
+  }
+
+  public static bool icsneocsharp_filterAddArbidRange(SWIGTYPE_p_icsneocsharp_filter_t filter, uint low, uint high, uint mask) {
+    bool ret = icsneocsharpPINVOKE.icsneocsharp_filterAddArbidRange(SWIGTYPE_p_icsneocsharp_filter_t.getCPtr(filter), low, high, mask);
+    return ret;
+  }
+
+  public static bool icsneocsharp_getMessagesFiltered(neodevice_t device, SWIGTYPE_p_icsneocsharp_filter_t filter, neomessage_t messages, ref int items, ulong timeout) {
+    bool ret = icsneocsharpPINVOKE.icsneocsharp_getMessagesFiltered(neodevice_t.getCPtr(device), SWIGTYPE_p_icsneocsharp_filter_t.getCPtr(filter), neomessage_t.getCPtr(messages), ref items, timeout);
+    return ret;
+  }
+
+  public static bool icsneocsharp_setData(SWIGTYPE_p_void message, SWIGTYPE_p_void bytes, int length) {
+    bool ret = icsneocsharpPINVOKE.icsneocsharp_setData(SWIGTYPE_p_void.getCPtr(message), SWIGTYPE_p_void.getCPtr(bytes), length);
+    return ret;
+  }
+
+  public static SWIGTYPE_p_icsneocsharp_listener_t icsneocsharp_addMessageListener(neodevice_t device, System.IntPtr onMessages, SWIGTYPE_p_icsneocsharp_filter_t filter, int batchSize, ulong maxDelayMicroseconds) {
+    global::System.IntPtr cPtr = icsneocsharpPINVOKE.icsneocsharp_addMessageListener(neodevice_t.getCPtr(device), onMessages, SWIGTYPE_p_icsneocsharp_filter_t.getCPtr(filter), batchSize, maxDelayMicroseconds);
+    SWIGTYPE_p_icsneocsharp_listener_t ret = (cPtr == global::System.IntPtr.Zero) ? null : new SWIGTYPE_p_icsneocsharp_listener_t(cPtr, false);
+    return ret;
+  }
+
+  public static bool icsneocsharp_removeMessageListener(SWIGTYPE_p_icsneocsharp_listener_t listener) {
+    bool ret = icsneocsharpPINVOKE.icsneocsharp_removeMessageListener(SWIGTYPE_p_icsneocsharp_listener_t.getCPtr(listener));
+    return ret;
+  }
+
+  public static ulong icsneocsharp_getMessageListenerDropped(SWIGTYPE_p_icsneocsharp_listener_t listener) {
+    ulong ret = icsneocsharpPINVOKE.icsneocsharp_getMessageListenerDropped(SWIGTYPE_p_icsneocsharp_listener_t.getCPtr(listener));
+    return ret;
+  }
+
   public static readonly int ICSNEO_DEVICETYPE_LONGEST_NAME = icsneocsharpPINVOKE.ICSNEO_DEVICETYPE_LONGEST_NAME_get();
   public static readonly int ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION = icsneocsharpPINVOKE.ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION_get();
   public static readonly int ICSNEO_NETID_DEVICE = icsneocsharpPINVOKE.ICSNEO_NETID_DEVICE_get();
@@ -718,7 +718,7 @@ class icsneocsharpPINVOKE {
   public static extern ulong neomessage_t_timestampReserved_get(global::System.Runtime.InteropServices.HandleRef jarg1);
 
   [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_neomessage_t_data_set")]
-  public static extern void neomessage_t_data_set(global::System.Runtime.InteropServices.HandleRef jarg1, byte[] jarg2);
+  public static extern void neomessage_t_data_set(global::System.Runtime.InteropServices.HandleRef jarg1, System.IntPtr jarg2);
 
   [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_neomessage_t_data_get")]
   public static extern System.IntPtr neomessage_t_data_get(global::System.Runtime.InteropServices.HandleRef jarg1);
@@ -778,7 +778,7 @@ class icsneocsharpPINVOKE {
   public static extern ulong neomessage_can_t_timestampReserved_get(global::System.Runtime.InteropServices.HandleRef jarg1);
 
   [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_neomessage_can_t_data_set")]
-  public static extern void neomessage_can_t_data_set(global::System.Runtime.InteropServices.HandleRef jarg1, byte[] jarg2);
+  public static extern void neomessage_can_t_data_set(global::System.Runtime.InteropServices.HandleRef jarg1, System.IntPtr jarg2);
 
   [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_neomessage_can_t_data_get")]
   public static extern System.IntPtr neomessage_can_t_data_get(global::System.Runtime.InteropServices.HandleRef jarg1);
@@ -844,7 +844,7 @@ class icsneocsharpPINVOKE {
   public static extern ulong neomessage_eth_t_timestampReserved_get(global::System.Runtime.InteropServices.HandleRef jarg1);
 
   [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_neomessage_eth_t_data_set")]
-  public static extern void neomessage_eth_t_data_set(global::System.Runtime.InteropServices.HandleRef jarg1, byte[] jarg2);
+  public static extern void neomessage_eth_t_data_set(global::System.Runtime.InteropServices.HandleRef jarg1, System.IntPtr jarg2);
 
   [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_neomessage_eth_t_data_get")]
   public static extern System.IntPtr neomessage_eth_t_data_get(global::System.Runtime.InteropServices.HandleRef jarg1);
@@ -1358,4 +1358,37 @@ class icsneocsharpPINVOKE {
 
   [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_neomessage_t_array_setitem")]
   public static extern void neomessage_t_array_setitem(global::System.Runtime.InteropServices.HandleRef jarg1, int jarg2, global::System.Runtime.InteropServices.HandleRef jarg3);
+
+  [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_newFilter")]
+  public static extern global::System.IntPtr icsneocsharp_newFilter();
+
+  [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_deleteFilter")]
+  public static extern void icsneocsharp_deleteFilter(global::System.Runtime.InteropServices.HandleRef jarg1);
+
+  [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_clearFilter")]
+  public static extern void icsneocsharp_clearFilter(global::System.Runtime.InteropServices.HandleRef jarg1);
+
+  [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_filterAddNetid")]
+  public static extern bool icsneocsharp_filterAddNetid(global::System.Runtime.InteropServices.HandleRef jarg1, int jarg2);
+
+  [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_filterAddType")]
+  public static extern bool icsneocsharp_filterAddType(global::System.Runtime.InteropServices.HandleRef jarg1, int jarg2);
+
+  [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_filterAddArbidRange")]
+  public static extern bool icsneocsharp_filterAddArbidRange(global::System.Runtime.InteropServices.HandleRef jarg1, uint jarg2, uint jarg3, uint jarg4);
+
+  [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_getMessagesFiltered")]
+  public static extern bool icsneocsharp_getMessagesFiltered(global::System.Runtime.InteropServices.HandleRef jarg1, global::System.Runtime.InteropServices.HandleRef jarg2, global::System.Runtime.InteropServices.HandleRef jarg3, ref int jarg4, ulong jarg5);
+
+  [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_setData")]
+  public static extern bool icsneocsharp_setData(global::System.Runtime.InteropServices.HandleRef jarg1, global::System.Runtime.InteropServices.HandleRef jarg2, int jarg3);
+
+  [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_addMessageListener")]
+  public static extern global::System.IntPtr icsneocsharp_addMessageListener(global::System.Runtime.InteropServices.HandleRef jarg1, System.IntPtr jarg2, global::System.Runtime.InteropServices.HandleRef jarg3, int jarg4, ulong jarg5);
+
+  [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_removeMessageListener")]
+  public static extern bool icsneocsharp_removeMessageListener(global::System.Runtime.InteropServices.HandleRef jarg1);
+
+  [global::System.Runtime.InteropServices.DllImport("icsneocsharp.dll", EntryPoint="CSharp_icsneocsharp_getMessageListenerDropped")]
+  public static extern ulong icsneocsharp_getMessageListenerDropped(global::System.Runtime.InteropServices.HandleRef jarg1);
 }
@@ -43,6 +43,11 @@ public class neomessage_t : global::System.IDisposable {
     }
   }
 
+  // Copies the payload out of native memory, for keeping it after the poll it came from
+  public byte[] CopyData() {
+    return data.ToArray();
+  }
+
   public neomessage_statusbitfield_t status {
     set {
       icsneocsharpPINVOKE.neomessage_t_status_set(swigCPtr, neomessage_statusbitfield_t.getCPtr(value));
@@ -74,16 +79,21 @@ public class neomessage_t : global::System.IDisposable {
     } 
   }
 
-  public byte[] data {
+  public System.ReadOnlySpan<byte> data {
 	set {
-		icsneocsharpPINVOKE.neomessage_t_data_set(swigCPtr, value);
+		unsafe {
+			fixed(byte* bytes = value) {
+				if(!icsneocsharpPINVOKE.icsneocsharp_setData(swigCPtr, new global::System.Runtime.InteropServices.HandleRef(null, (System.IntPtr)bytes), value.Length))
+					throw new System.OutOfMemoryException("Unable to allocate the message data");
+			}
+		}
 	}
 
 	get {
-		byte[] ret = new byte[this.length]; 
-        System.IntPtr data = icsneocsharpPINVOKE.neomessage_t_data_get(swigCPtr); 
-        System.Runtime.InteropServices.Marshal.Copy(data, ret, 0, (int)this.length);
-		return ret; 
+		System.IntPtr data = icsneocsharpPINVOKE.neomessage_t_data_get(swigCPtr);
+		unsafe {
+			return new System.ReadOnlySpan<byte>((void*)data, (int)this.length);
+		}
 	}
 
   }
@@ -0,0 +1,121 @@
+package icsneojava.benchmarks;
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.reflect.Method;
+
+/**
+ * The SWIG generated binding lives in the default package, which can not be imported from a named package,
+ * and JMH does not allow benchmarks in the default package. So the benchmarks reach the binding through
+ * these method handles. They are static final, so the JIT inlines them just like direct calls.
+ *
+ * Every handle has its reference types erased to Object, call them with invokeExact and cast the result.
+ */
+final class Binding {
+    static final MethodHandle NEW_NEOMESSAGE_T;
+    static final MethodHandle DELETE_NEOMESSAGE_T;
+    static final MethodHandle NEOMESSAGE_T_GET_TIMESTAMP;
+    static final MethodHandle NEOMESSAGE_T_SET_TIMESTAMP;
+    static final MethodHandle NEOMESSAGE_T_GET_NETID;
+    static final MethodHandle NEOMESSAGE_T_GET_TYPE;
+    static final MethodHandle NEOMESSAGE_T_GET_LENGTH;
+    static final MethodHandle NEOMESSAGE_T_GET_DATA;
+    static final MethodHandle NEW_NEOMESSAGE_CAN_T;
+    static final MethodHandle DELETE_NEOMESSAGE_CAN_T;
+    static final MethodHandle NEOMESSAGE_CAN_T_GET_ARBID;
+    static final MethodHandle NEOMESSAGE_CAN_T_SET_ARBID;
+    static final MethodHandle NEOMESSAGE_CAN_T_SET_NETID;
+    static final MethodHandle NEOMESSAGE_CAN_T_SET_TYPE;
+    static final MethodHandle NEOMESSAGE_CAN_T_SET_LENGTH;
+    static final MethodHandle NEOMESSAGE_CAN_T_SET_DATA;
+    static final MethodHandle NEOMESSAGE_CAN_T_CAST;
+    static final MethodHandle FROM_CAN_NEOMESSAGE_T_CAST;
+    static final MethodHandle NEW_NEOMESSAGE_T_ARRAY;
+    static final MethodHandle DELETE_NEOMESSAGE_T_ARRAY;
+    static final MethodHandle NEOMESSAGE_T_ARRAY_GETITEM;
+    static final MethodHandle NEOMESSAGE_T_ARRAY_SETITEM;
+    static final MethodHandle NEW_NEODEVICE_T_ARRAY;
+    static final MethodHandle DELETE_NEODEVICE_T_ARRAY;
+    static final MethodHandle NEODEVICE_T_ARRAY_GETITEM;
+    static final MethodHandle NEODEVICE_T_GET_SERIAL;
+    static final MethodHandle FIND_ALL_DEVICES;
+    static final MethodHandle OPEN_DEVICE;
+    static final MethodHandle CLOSE_DEVICE;
+    static final MethodHandle GO_ONLINE;
+    static final MethodHandle ENABLE_MESSAGE_POLLING;
+    static final MethodHandle GET_MESSAGES;
+    static final MethodHandle TRANSMIT;
+    static final MethodHandle TRANSMIT_MESSAGES;
+    static final MethodHandle ICSNEOJAVA_TRANSMIT_MESSAGES;
+
+    static final int ICSNEO_NETID_HSCAN;
+    static final short ICSNEO_NETWORK_TYPE_CAN;
+
+    static {
+        // The binding classes do not load the native library themselves, Run.java normally does
+        System.loadLibrary("icsneojava");
+
+        try {
+            NEW_NEOMESSAGE_T = constructor("neomessage_t");
+            DELETE_NEOMESSAGE_T = method("neomessage_t", "delete");
+            NEOMESSAGE_T_GET_TIMESTAMP = method("neomessage_t", "getTimestamp");
+            NEOMESSAGE_T_SET_TIMESTAMP = method("neomessage_t", "setTimestamp");
+            NEOMESSAGE_T_GET_NETID = method("neomessage_t", "getNetid");
+            NEOMESSAGE_T_GET_TYPE = method("neomessage_t", "getType");
+            NEOMESSAGE_T_GET_LENGTH = method("neomessage_t", "getLength");
+            NEOMESSAGE_T_GET_DATA = method("neomessage_t", "getData");
+            NEW_NEOMESSAGE_CAN_T = constructor("neomessage_can_t");
+            DELETE_NEOMESSAGE_CAN_T = method("neomessage_can_t", "delete");
+            NEOMESSAGE_CAN_T_GET_ARBID = method("neomessage_can_t", "getArbid");
+            NEOMESSAGE_CAN_T_SET_ARBID = method("neomessage_can_t", "setArbid");
+            NEOMESSAGE_CAN_T_SET_NETID = method("neomessage_can_t", "setNetid");
+            NEOMESSAGE_CAN_T_SET_TYPE = method("neomessage_can_t", "setType");
+            NEOMESSAGE_CAN_T_SET_LENGTH = method("neomessage_can_t", "setLength");
+            NEOMESSAGE_CAN_T_SET_DATA = method("neomessage_can_t", "setData");
+            NEOMESSAGE_CAN_T_CAST = method("icsneojava", "neomessage_can_t_cast");
+            FROM_CAN_NEOMESSAGE_T_CAST = method("icsneojava", "from_can_neomessage_t_cast");
+            NEW_NEOMESSAGE_T_ARRAY = method("icsneojava", "new_neomessage_t_array");
+            DELETE_NEOMESSAGE_T_ARRAY = method("icsneojava", "delete_neomessage_t_array");
+            NEOMESSAGE_T_ARRAY_GETITEM = method("icsneojava", "neomessage_t_array_getitem");
+            NEOMESSAGE_T_ARRAY_SETITEM = method("icsneojava", "neomessage_t_array_setitem");
+            NEW_NEODEVICE_T_ARRAY = method("icsneojava", "new_neodevice_t_array");
+            DELETE_NEODEVICE_T_ARRAY = method("icsneojava", "delete_neodevice_t_array");
+            NEODEVICE_T_ARRAY_GETITEM = method("icsneojava", "neodevice_t_array_getitem");
+            NEODEVICE_T_GET_SERIAL = method("neodevice_t", "getSerial");
+            FIND_ALL_DEVICES = method("icsneojava", "icsneo_findAllDevices");
+            OPEN_DEVICE = method("icsneojava", "icsneo_openDevice");
+            CLOSE_DEVICE = method("icsneojava", "icsneo_closeDevice");
+            GO_ONLINE = method("icsneojava", "icsneo_goOnline");
+            ENABLE_MESSAGE_POLLING = method("icsneojava", "icsneo_enableMessagePolling");
+            GET_MESSAGES = method("icsneojava", "icsneo_getMessages");
+            TRANSMIT = method("icsneojava", "icsneo_transmit");
+            TRANSMIT_MESSAGES = method("icsneojava", "icsneo_transmitMessages");
+            ICSNEOJAVA_TRANSMIT_MESSAGES = method("icsneojava", "icsneojava_transmitMessages");
+
+            Class<?> constants = Class.forName("icsneojavaConstants");
+            ICSNEO_NETID_HSCAN = constants.getField("ICSNEO_NETID_HSCAN").getInt(null);
+            ICSNEO_NETWORK_TYPE_CAN = (short) constants.getField("ICSNEO_NETWORK_TYPE_CAN").getInt(null);
+        } catch(ReflectiveOperationException e) {
+            throw new ExceptionInInitializerError(e);
+        }
+    }
+
+    private Binding() {}
+
+    // Finds the public no argument constructor of a binding class
+    static MethodHandle constructor(String className) throws ReflectiveOperationException {
+        MethodHandle handle = MethodHandles.publicLookup().unreflectConstructor(Class.forName(className).getConstructor());
+        return handle.asType(handle.type().erase());
+    }
+
+    // Finds a public method of a binding class by name, the binding has no overloads
+    static MethodHandle method(String className, String methodName) throws ReflectiveOperationException {
+        for(Method method : Class.forName(className).getMethods()) {
+            if(method.getName().equals(methodName)) {
+                MethodHandle handle = MethodHandles.publicLookup().unreflect(method);
+                return handle.asType(handle.type().erase());
+            }
+        }
+        throw new NoSuchMethodException(className + "." + methodName);
+    }
+}
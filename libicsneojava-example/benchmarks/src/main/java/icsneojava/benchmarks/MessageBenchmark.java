@@ -0,0 +1,93 @@
+package icsneojava.benchmarks;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * Single calls on one message polled from the simulated device: the field getters, getData, which copies
+ * the payload into a new byte[], and the cast helpers, which wrap the same memory in a new proxy.
+ * Run with -prof gc, gc.alloc.rate.norm is the bytes allocated per call.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class MessageBenchmark {
+    private Object messages;
+    private Object message;
+    private Object canMessage;
+
+    @Setup
+    public void setup(SimulatedDevice sim) throws Throwable {
+        messages = (Object) Binding.NEW_NEOMESSAGE_T_ARRAY.invokeExact(1);
+        int[] items = {1, 0};
+        if(!(boolean) Binding.GET_MESSAGES.invokeExact(sim.device, messages, (Object) items, 0L) || items[0] != 1)
+            throw new IllegalStateException("The simulated device returned no message");
+        // The first element of the array itself rather than a getitem copy, its data stays valid until the next poll
+        message = messages;
+        canMessage = (Object) Binding.NEOMESSAGE_CAN_T_CAST.invokeExact(message);
+    }
+
+    @TearDown
+    public void tearDown() throws Throwable {
+        Binding.DELETE_NEOMESSAGE_T_ARRAY.invokeExact(messages);
+    }
+
+    @Benchmark
+    public int getNetid() throws Throwable {
+        return (int) Binding.NEOMESSAGE_T_GET_NETID.invokeExact(message);
+    }
+
+    @Benchmark
+    public short getType() throws Throwable {
+        return (short) Binding.NEOMESSAGE_T_GET_TYPE.invokeExact(message);
+    }
+
+    @Benchmark
+    public long getTimestamp() throws Throwable {
+        return (long) Binding.NEOMESSAGE_T_GET_TIMESTAMP.invokeExact(message);
+    }
+
+    @Benchmark
+    public long getLength() throws Throwable {
+        return (long) Binding.NEOMESSAGE_T_GET_LENGTH.invokeExact(message);
+    }
+
+    @Benchmark
+    public long getArbid() throws Throwable {
+        return (long) Binding.NEOMESSAGE_CAN_T_GET_ARBID.invokeExact(canMessage);
+    }
+
+    @Benchmark
+    public byte[] getData() throws Throwable {
+        return (byte[]) (Object) Binding.NEOMESSAGE_T_GET_DATA.invokeExact(message);
+    }
+
+    @Benchmark
+    public Object canCast() throws Throwable {
+        return (Object) Binding.NEOMESSAGE_CAN_T_CAST.invokeExact(message);
+    }
+
+    @Benchmark
+    public long canCastAndGetArbid() throws Throwable {
+        return (long) Binding.NEOMESSAGE_CAN_T_GET_ARBID.invokeExact((Object) Binding.NEOMESSAGE_CAN_T_CAST.invokeExact(message));
+    }
+
+    @Benchmark
+    public Object fromCanCast() throws Throwable {
+        return (Object) Binding.FROM_CAN_NEOMESSAGE_T_CAST.invokeExact(canMessage);
+    }
+}
@@ -0,0 +1,70 @@
+package icsneojava.benchmarks;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * Polls per second from the simulated device, which returns 100 CAN frames per poll unless
+ * ICSNEOSIM_MESSAGES_PER_POLL says otherwise. poll is icsneo_getMessages alone, pollAndRead also copies
+ * every message out with getitem and reads its fields and data, as InteractiveExample does.
+ * Run with -prof gc, gc.alloc.rate.norm is the bytes allocated per poll.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class ReceiveBenchmark {
+    private static final int CAPACITY = 1000;
+
+    private Object messages;
+    // size_t *items is mapped onto the int[], and written back as 8 bytes
+    private int[] items = new int[2];
+
+    @Setup
+    public void setup() throws Throwable {
+        messages = (Object) Binding.NEW_NEOMESSAGE_T_ARRAY.invokeExact(CAPACITY);
+    }
+
+    @TearDown
+    public void tearDown() throws Throwable {
+        Binding.DELETE_NEOMESSAGE_T_ARRAY.invokeExact(messages);
+    }
+
+    @Benchmark
+    public int poll(SimulatedDevice sim) throws Throwable {
+        items[0] = CAPACITY;
+        items[1] = 0;
+        if(!(boolean) Binding.GET_MESSAGES.invokeExact(sim.device, messages, (Object) items, 0L))
+            return -1;
+        return items[0];
+    }
+
+    @Benchmark
+    public long pollAndRead(SimulatedDevice sim) throws Throwable {
+        long sum = 0;
+        items[0] = CAPACITY;
+        items[1] = 0;
+        if(!(boolean) Binding.GET_MESSAGES.invokeExact(sim.device, messages, (Object) items, 0L))
+            return -1;
+        for(int i = 0; i < items[0]; i++) {
+            Object message = (Object) Binding.NEOMESSAGE_T_ARRAY_GETITEM.invokeExact(messages, i);
+            sum += (int) Binding.NEOMESSAGE_T_GET_NETID.invokeExact(message) + (long) Binding.NEOMESSAGE_T_GET_TIMESTAMP.invokeExact(message);
+            sum += ((byte[]) (Object) Binding.NEOMESSAGE_T_GET_DATA.invokeExact(message))[0];
+            Binding.DELETE_NEOMESSAGE_T.invokeExact(message);
+        }
+        return sum;
+    }
+}
@@ -0,0 +1,46 @@
+package icsneojava.benchmarks;
+
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+
+/**
+ * The simulated device, open, online and polling. It only exists when icsneojava is built with
+ * -DICSNEOJAVA_SIMULATED_DEVICE=ON, which links it against the top level sim/icsneoc_sim.c rather than libicsneo.
+ * A real device is refused, as the transmit benchmarks would put their frames on its bus.
+ */
+@State(Scope.Benchmark)
+public class SimulatedDevice {
+    static final String SERIAL = "SIM001";
+
+    private Object devices;
+    Object device;
+
+    @Setup(Level.Trial)
+    public void open() throws Throwable {
+        devices = (Object) Binding.NEW_NEODEVICE_T_ARRAY.invokeExact(1);
+        // size_t *count is mapped onto the int[], and written back as 8 bytes
+        int[] count = {1, 0};
+        Binding.FIND_ALL_DEVICES.invokeExact(devices, (Object) count);
+        if(count[0] == 0)
+            throw new IllegalStateException("No devices found, build icsneojava with -DICSNEOJAVA_SIMULATED_DEVICE=ON");
+
+        device = (Object) Binding.NEODEVICE_T_ARRAY_GETITEM.invokeExact(devices, 0);
+        Object serial = (Object) Binding.NEODEVICE_T_GET_SERIAL.invokeExact(device);
+        if(!SERIAL.equals(serial))
+            throw new IllegalStateException("Found " + serial + " rather than the simulated device, build icsneojava with -DICSNEOJAVA_SIMULATED_DEVICE=ON");
+
+        if(!(boolean) Binding.OPEN_DEVICE.invokeExact(device) || !(boolean) Binding.GO_ONLINE.invokeExact(device)
+                || !(boolean) Binding.ENABLE_MESSAGE_POLLING.invokeExact(device))
+            throw new IllegalStateException("Could not bring up the simulated device");
+    }
+
+    @TearDown(Level.Trial)
+    public void close() throws Throwable {
+        if(!(boolean) Binding.CLOSE_DEVICE.invokeExact(device))
+            System.err.println("Could not close the simulated device");
+        Binding.DELETE_NEODEVICE_T_ARRAY.invokeExact(devices);
+    }
+}
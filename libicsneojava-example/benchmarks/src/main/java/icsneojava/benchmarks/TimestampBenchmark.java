@@ -0,0 +1,61 @@
+package icsneojava.benchmarks;
+
+import java.math.BigInteger;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * The cost of reading a message timestamp, now that uint64_t maps to a primitive long, compared with
+ * the java.math.BigInteger the binding used to return.
+ *
+ * The BigInteger case does the same byte array and BigInteger construction the old wrapper did,
+ * but in Java. The old wrapper did it through JNI (FindClass, NewByteArray, NewObject), so this is
+ * a lower bound of what it cost. Run with -prof gc to compare gc.alloc.rate.norm.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class TimestampBenchmark {
+    private Object message;
+
+    @Setup
+    public void setup() throws Throwable {
+        message = (Object) Binding.NEW_NEOMESSAGE_T.invokeExact();
+        Binding.NEOMESSAGE_T_SET_TIMESTAMP.invokeExact(message, 0x0123456789ABCDEFL);
+    }
+
+    @TearDown
+    public void tearDown() throws Throwable {
+        Binding.DELETE_NEOMESSAGE_T.invokeExact(message);
+    }
+
+    @Benchmark
+    public long primitiveTimestamp() throws Throwable {
+        return (long) Binding.NEOMESSAGE_T_GET_TIMESTAMP.invokeExact(message);
+    }
+
+    @Benchmark
+    public BigInteger bigIntegerTimestamp() throws Throwable {
+        long value = (long) Binding.NEOMESSAGE_T_GET_TIMESTAMP.invokeExact(message);
+
+        // The conversion the old out typemap did for every read
+        byte[] bytes = new byte[9];
+        for(int i = 1; i < 9; i++)
+            bytes[i] = (byte) (value >>> 8 * (8 - i));
+        return new BigInteger(bytes);
+    }
+}
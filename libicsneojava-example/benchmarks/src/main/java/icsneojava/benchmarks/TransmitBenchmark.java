@@ -0,0 +1,106 @@
+package icsneojava.benchmarks;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * Transmits per second to the simulated device, which copies and counts each frame. transmit sends one
+ * prebuilt frame, buildAndTransmit builds it with the setters first, as InteractiveExample does.
+ * transmitMessages and transmitBatch send BATCH frames per call, from a neomessage_t array filled with
+ * setitem and from primitive arrays through icsneojava_transmitMessages.
+ * Run with -prof gc, gc.alloc.rate.norm is the bytes allocated per call.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class TransmitBenchmark {
+    private static final int BATCH = 100;
+
+    private byte[] payload = { (byte) 0xaa, (byte) 0xbb, (byte) 0xcc, (byte) 0xdd, (byte) 0xee, (byte) 0xff, 0x00, 0x11 };
+    private Object canMessage;
+    private Object message;
+    private Object messages;
+    private Object[] frames = new Object[BATCH];
+    private int[] netids = new int[BATCH];
+    private int[] arbids = new int[BATCH];
+    private int[] flags = new int[BATCH];
+    private int[] lengths = new int[BATCH];
+    private byte[] batchPayload = new byte[BATCH * 8];
+
+    @Setup
+    public void setup() throws Throwable {
+        canMessage = (Object) Binding.NEW_NEOMESSAGE_CAN_T.invokeExact();
+        fill(canMessage, 0x120);
+        message = (Object) Binding.FROM_CAN_NEOMESSAGE_T_CAST.invokeExact(canMessage);
+
+        messages = (Object) Binding.NEW_NEOMESSAGE_T_ARRAY.invokeExact(BATCH);
+        for(int i = 0; i < BATCH; i++) {
+            frames[i] = (Object) Binding.NEW_NEOMESSAGE_CAN_T.invokeExact();
+            fill(frames[i], 0x120 + i);
+            // setitem copies the struct but shares its data, which is freed with the frame, so the frames are kept
+            Binding.NEOMESSAGE_T_ARRAY_SETITEM.invokeExact(messages, i, (Object) Binding.FROM_CAN_NEOMESSAGE_T_CAST.invokeExact(frames[i]));
+        }
+
+        for(int i = 0; i < BATCH; i++) {
+            netids[i] = Binding.ICSNEO_NETID_HSCAN;
+            arbids[i] = 0x120 + i;
+            lengths[i] = payload.length;
+            System.arraycopy(payload, 0, batchPayload, i * payload.length, payload.length);
+        }
+    }
+
+    @TearDown
+    public void tearDown() throws Throwable {
+        Binding.DELETE_NEOMESSAGE_T_ARRAY.invokeExact(messages);
+        for(Object frame : frames)
+            Binding.DELETE_NEOMESSAGE_CAN_T.invokeExact(frame);
+        Binding.DELETE_NEOMESSAGE_CAN_T.invokeExact(canMessage);
+    }
+
+    private void fill(Object frame, long arbid) throws Throwable {
+        Binding.NEOMESSAGE_CAN_T_SET_ARBID.invokeExact(frame, arbid);
+        Binding.NEOMESSAGE_CAN_T_SET_NETID.invokeExact(frame, Binding.ICSNEO_NETID_HSCAN);
+        Binding.NEOMESSAGE_CAN_T_SET_TYPE.invokeExact(frame, Binding.ICSNEO_NETWORK_TYPE_CAN);
+        Binding.NEOMESSAGE_CAN_T_SET_DATA.invokeExact(frame, (Object) payload);
+        Binding.NEOMESSAGE_CAN_T_SET_LENGTH.invokeExact(frame, (long) payload.length);
+    }
+
+    @Benchmark
+    public boolean transmit(SimulatedDevice sim) throws Throwable {
+        return (boolean) Binding.TRANSMIT.invokeExact(sim.device, message);
+    }
+
+    @Benchmark
+    public boolean buildAndTransmit(SimulatedDevice sim) throws Throwable {
+        Object frame = (Object) Binding.NEW_NEOMESSAGE_CAN_T.invokeExact();
+        fill(frame, 0x120);
+        boolean result = (boolean) Binding.TRANSMIT.invokeExact(sim.device, (Object) Binding.FROM_CAN_NEOMESSAGE_T_CAST.invokeExact(frame));
+        Binding.DELETE_NEOMESSAGE_CAN_T.invokeExact(frame);
+        return result;
+    }
+
+    @Benchmark
+    public boolean transmitMessages(SimulatedDevice sim) throws Throwable {
+        return (boolean) Binding.TRANSMIT_MESSAGES.invokeExact(sim.device, messages, (long) BATCH);
+    }
+
+    @Benchmark
+    public boolean transmitBatch(SimulatedDevice sim) throws Throwable {
+        return (boolean) Binding.ICSNEOJAVA_TRANSMIT_MESSAGES.invokeExact(sim.device, (Object) netids, (Object) arbids, (Object) flags,
+            (Object) lengths, (Object) batchPayload, BATCH);
+    }
+}
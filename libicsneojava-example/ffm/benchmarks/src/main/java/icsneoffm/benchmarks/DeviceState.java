@@ -0,0 +1,60 @@
+package icsneoffm.benchmarks;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+
+import icsneoffm.Icsneo;
+import icsneoffm.NeoLayouts;
+
+import static java.lang.foreign.ValueLayout.JAVA_LONG;
+
+/**
+ * The simulated device, open, online and polling. It only exists when icsneojava is built with
+ * -DICSNEOJAVA_SIMULATED_DEVICE=ON, and a real device is refused, as TransmitBenchmark would put its frames on
+ * its bus. Both bindings load the same icsneoc, so the device is opened once through FFM and handed to the JNI
+ * binding as a neodevice_t proxy over the same memory.
+ */
+@State(Scope.Benchmark)
+public class DeviceState {
+    static final String SERIAL = "SIM001";
+
+    private Arena arena;
+    MemorySegment device;
+    Object jniDevice;
+
+    @Setup(Level.Trial)
+    public void open() throws Throwable {
+        // Load the JNI binding first, its library brings icsneoc in with it
+        Class.forName(Jni.class.getName());
+
+        arena = Arena.ofShared();
+        MemorySegment devices = arena.allocate(NeoLayouts.NEODEVICE_T);
+        MemorySegment count = arena.allocate(JAVA_LONG);
+        count.set(JAVA_LONG, 0, 1);
+        Icsneo.findAllDevices(devices, count);
+        if(count.get(JAVA_LONG, 0) == 0)
+            throw new IllegalStateException("No devices found, build icsneojava with -DICSNEOJAVA_SIMULATED_DEVICE=ON");
+
+        device = devices;
+        String serial = device.getString(NeoLayouts.NEODEVICE_SERIAL_OFFSET);
+        if(!SERIAL.equals(serial))
+            throw new IllegalStateException("Found " + serial + " rather than the simulated device, build icsneojava with -DICSNEOJAVA_SIMULATED_DEVICE=ON");
+
+        if(!Icsneo.openDevice(device) || !Icsneo.goOnline(device) || !Icsneo.enableMessagePolling(device))
+            throw new IllegalStateException("Could not bring up " + Icsneo.describeDevice(device));
+        jniDevice = (Object) Jni.WRAP_DEVICE.invokeExact(device.address(), false);
+    }
+
+    @TearDown(Level.Trial)
+    public void close() {
+        Icsneo.closeDevice(device);
+        Icsneo.freeUnconnectedDevices();
+        arena.close();
+    }
+}
@@ -0,0 +1,119 @@
+package icsneoffm.benchmarks;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OperationsPerInvocation;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+import icsneoffm.Icsneo;
+import icsneoffm.NeoLayouts;
+import icsneoffm.NeoMessageCursor;
+
+import static java.lang.foreign.ValueLayout.JAVA_BYTE;
+import static java.lang.foreign.ValueLayout.JAVA_INT;
+import static java.lang.foreign.ValueLayout.JAVA_LONG;
+import static java.lang.foreign.ValueLayout.JAVA_SHORT;
+
+/**
+ * Reading the fields of a polled neomessage_t array, per message. The array is filled in here rather than
+ * by a device, so this needs no hardware. The JNI binding copies each message out with getitem and reads
+ * every field through its own native call, the FFM binding reads them straight out of the segment.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(value = 1, jvmArgsAppend = "--enable-native-access=ALL-UNNAMED")
+@OperationsPerInvocation(FieldReadBenchmark.MESSAGES)
+public class FieldReadBenchmark {
+    static final int MESSAGES = 100;
+
+    private Arena arena;
+    private MemorySegment messages;
+    private NeoMessageCursor cursor;
+    private Object jniMessages;
+    private byte[] payload = new byte[64];
+
+    @Setup
+    public void setup() throws Throwable {
+        arena = Arena.ofShared();
+        messages = arena.allocate(NeoLayouts.NEOMESSAGE_CAN_T, MESSAGES);
+        MemorySegment data = arena.allocate(MESSAGES * 8L);
+        for(int i = 0; i < MESSAGES; i++) {
+            long position = i * NeoLayouts.NEOMESSAGE_SIZE;
+            messages.set(JAVA_LONG, position + NeoLayouts.NEOMESSAGE_TIMESTAMP_OFFSET, 1_000_000L * i);
+            messages.set(JAVA_LONG, position + NeoLayouts.NEOMESSAGE_DATA_OFFSET, data.address() + i * 8L);
+            messages.set(JAVA_LONG, position + NeoLayouts.NEOMESSAGE_LENGTH_OFFSET, 8);
+            messages.set(JAVA_INT, position + NeoLayouts.NEOMESSAGE_CAN_ARBID_OFFSET, 0x100 + i);
+            messages.set(JAVA_SHORT, position + NeoLayouts.NEOMESSAGE_NETID_OFFSET, (short) Icsneo.ICSNEO_NETID_HSCAN);
+            messages.set(JAVA_BYTE, position + NeoLayouts.NEOMESSAGE_TYPE_OFFSET, (byte) Icsneo.ICSNEO_NETWORK_TYPE_CAN);
+            data.set(JAVA_BYTE, i * 8L, (byte) i);
+        }
+        cursor = new NeoMessageCursor(messages);
+        jniMessages = (Object) Jni.WRAP_MESSAGES.invokeExact(messages.address(), false);
+    }
+
+    @TearDown
+    public void tearDown() {
+        arena.close();
+    }
+
+    @Benchmark
+    public long jniFields() throws Throwable {
+        long sum = 0;
+        for(int i = 0; i < MESSAGES; i++) {
+            Object message = (Object) Jni.GETITEM.invokeExact(jniMessages, i);
+            sum += (int) Jni.GET_NETID.invokeExact(message) + (short) Jni.GET_TYPE.invokeExact(message)
+                + (long) Jni.GET_TIMESTAMP.invokeExact(message) + (long) Jni.GET_LENGTH.invokeExact(message);
+            Jni.DELETE_NEOMESSAGE_T.invokeExact(message);
+        }
+        return sum;
+    }
+
+    @Benchmark
+    public long jniFieldsAndData() throws Throwable {
+        long sum = 0;
+        for(int i = 0; i < MESSAGES; i++) {
+            Object message = (Object) Jni.GETITEM.invokeExact(jniMessages, i);
+            sum += (int) Jni.GET_NETID.invokeExact(message) + (short) Jni.GET_TYPE.invokeExact(message)
+                + (long) Jni.GET_TIMESTAMP.invokeExact(message) + (long) Jni.GET_LENGTH.invokeExact(message);
+            sum += ((byte[]) (Object) Jni.GET_DATA.invokeExact(message))[0];
+            Jni.DELETE_NEOMESSAGE_T.invokeExact(message);
+        }
+        return sum;
+    }
+
+    @Benchmark
+    public long ffmFields() {
+        long sum = 0;
+        cursor.reset(MESSAGES);
+        while(cursor.next())
+            sum += cursor.getNetid() + cursor.getType() + cursor.getTimestamp() + cursor.getLength();
+        return sum;
+    }
+
+    @Benchmark
+    public long ffmFieldsAndData() {
+        long sum = 0;
+        cursor.reset(MESSAGES);
+        while(cursor.next()) {
+            sum += cursor.getNetid() + cursor.getType() + cursor.getTimestamp() + cursor.getLength();
+            cursor.copyData(payload, 0);
+            sum += payload[0];
+        }
+        return sum;
+    }
+}
@@ -0,0 +1,90 @@
+package icsneoffm.benchmarks;
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.reflect.Method;
+
+/**
+ * The SWIG generated JNI binding, reached through method handles since it lives in the default package,
+ * which a named package can not import. They are static final, so the JIT inlines them just like direct calls.
+ *
+ * Every handle has its reference types erased to Object, call them with invokeExact and cast the result.
+ */
+final class Jni {
+    static final MethodHandle WRAP_DEVICE;
+    static final MethodHandle WRAP_MESSAGES;
+    static final MethodHandle GET_MESSAGES;
+    static final MethodHandle GETITEM;
+    static final MethodHandle DELETE_NEOMESSAGE_T;
+    static final MethodHandle GET_NETID;
+    static final MethodHandle GET_TYPE;
+    static final MethodHandle GET_TIMESTAMP;
+    static final MethodHandle GET_LENGTH;
+    static final MethodHandle GET_DATA;
+    static final MethodHandle NEW_NEOMESSAGE_CAN_T;
+    static final MethodHandle DELETE_NEOMESSAGE_CAN_T;
+    static final MethodHandle CAN_SET_ARBID;
+    static final MethodHandle CAN_SET_LENGTH;
+    static final MethodHandle CAN_SET_NETID;
+    static final MethodHandle CAN_SET_DATA;
+    static final MethodHandle FROM_CAN_CAST;
+    static final MethodHandle TRANSMIT;
+    static final MethodHandle TRANSMIT_MESSAGES;
+
+    static {
+        // Also loads icsneoc, which the FFM binding then shares
+        System.loadLibrary("icsneojava");
+
+        try {
+            WRAP_DEVICE = pointerConstructor("neodevice_t");
+            WRAP_MESSAGES = pointerConstructor("neomessage_t");
+            // Rather than icsneo_getMessages, whose size_t *items is mapped onto a 4 byte int[] element
+            GET_MESSAGES = method("icsneojava", "icsneojava_getMessagesFiltered");
+            GETITEM = method("icsneojava", "neomessage_t_array_getitem");
+            DELETE_NEOMESSAGE_T = method("neomessage_t", "delete");
+            GET_NETID = method("neomessage_t", "getNetid");
+            GET_TYPE = method("neomessage_t", "getType");
+            GET_TIMESTAMP = method("neomessage_t", "getTimestamp");
+            GET_LENGTH = method("neomessage_t", "getLength");
+            GET_DATA = method("neomessage_t", "getData");
+            NEW_NEOMESSAGE_CAN_T = constructor("neomessage_can_t");
+            DELETE_NEOMESSAGE_CAN_T = method("neomessage_can_t", "delete");
+            CAN_SET_ARBID = method("neomessage_can_t", "setArbid");
+            CAN_SET_LENGTH = method("neomessage_can_t", "setLength");
+            CAN_SET_NETID = method("neomessage_can_t", "setNetid");
+            CAN_SET_DATA = method("neomessage_can_t", "setData");
+            FROM_CAN_CAST = method("icsneojava", "from_can_neomessage_t_cast");
+            TRANSMIT = method("icsneojava", "icsneo_transmit");
+            TRANSMIT_MESSAGES = method("icsneojava", "icsneojava_transmitMessages");
+        } catch(ReflectiveOperationException e) {
+            throw new ExceptionInInitializerError(e);
+        }
+    }
+
+    private Jni() {}
+
+    // Finds the public no argument constructor of a binding class
+    private static MethodHandle constructor(String className) throws ReflectiveOperationException {
+        MethodHandle handle = MethodHandles.publicLookup().unreflectConstructor(Class.forName(className).getConstructor());
+        return handle.asType(handle.type().erase());
+    }
+
+    // Finds the protected (long cPtr, boolean cMemoryOwn) constructor, to view native memory through a proxy
+    private static MethodHandle pointerConstructor(String className) throws ReflectiveOperationException {
+        Class<?> proxyClass = Class.forName(className);
+        MethodHandles.Lookup lookup = MethodHandles.privateLookupIn(proxyClass, MethodHandles.lookup());
+        MethodHandle handle = lookup.unreflectConstructor(proxyClass.getDeclaredConstructor(long.class, boolean.class));
+        return handle.asType(handle.type().erase());
+    }
+
+    // Finds a public method of a binding class by name, the binding has no overloads
+    private static MethodHandle method(String className, String methodName) throws ReflectiveOperationException {
+        for(Method method : Class.forName(className).getMethods()) {
+            if(method.getName().equals(methodName)) {
+                MethodHandle handle = MethodHandles.publicLookup().unreflect(method);
+                return handle.asType(handle.type().erase());
+            }
+        }
+        throw new NoSuchMethodException(className + "." + methodName);
+    }
+}
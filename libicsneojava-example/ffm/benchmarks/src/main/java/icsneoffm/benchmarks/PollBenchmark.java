@@ -0,0 +1,84 @@
+package icsneoffm.benchmarks;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+import icsneoffm.Icsneo;
+import icsneoffm.NeoLayouts;
+import icsneoffm.NeoMessageCursor;
+
+import static java.lang.foreign.ValueLayout.JAVA_LONG;
+
+/**
+ * One poll with no timeout, reading the netid and timestamp of every message it returns. The simulated
+ * device returns ICSNEOSIM_MESSAGES_PER_POLL messages on every poll, so both bindings do the same work.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(value = 1, jvmArgsAppend = "--enable-native-access=ALL-UNNAMED")
+public class PollBenchmark {
+    private static final int CAPACITY = 1000;
+
+    private Arena arena;
+    private MemorySegment messages;
+    private MemorySegment items;
+    private NeoMessageCursor cursor;
+    private Object jniMessages;
+    private int[] jniItems = new int[1];
+
+    @Setup
+    public void setup() throws Throwable {
+        arena = Arena.ofShared();
+        messages = arena.allocate(NeoLayouts.NEOMESSAGE_T, CAPACITY);
+        items = arena.allocate(JAVA_LONG);
+        cursor = new NeoMessageCursor(messages);
+        jniMessages = (Object) Jni.WRAP_MESSAGES.invokeExact(messages.address(), false);
+    }
+
+    @TearDown
+    public void tearDown() {
+        arena.close();
+    }
+
+    @Benchmark
+    public long jniPoll(DeviceState device) throws Throwable {
+        long sum = 0;
+        jniItems[0] = CAPACITY;
+        if(!(boolean) Jni.GET_MESSAGES.invokeExact(device.jniDevice, (Object) null, jniMessages, (Object) jniItems, 0L))
+            return -1;
+        for(int i = 0; i < jniItems[0]; i++) {
+            Object message = (Object) Jni.GETITEM.invokeExact(jniMessages, i);
+            sum += (int) Jni.GET_NETID.invokeExact(message) + (long) Jni.GET_TIMESTAMP.invokeExact(message);
+            Jni.DELETE_NEOMESSAGE_T.invokeExact(message);
+        }
+        return sum;
+    }
+
+    @Benchmark
+    public long ffmPoll(DeviceState device) {
+        long sum = 0;
+        items.set(JAVA_LONG, 0, CAPACITY);
+        if(!Icsneo.getMessages(device.device, messages, items, 0))
+            return -1;
+        cursor.reset(items.get(JAVA_LONG, 0));
+        while(cursor.next())
+            sum += cursor.getNetid() + cursor.getTimestamp();
+        return sum;
+    }
+}
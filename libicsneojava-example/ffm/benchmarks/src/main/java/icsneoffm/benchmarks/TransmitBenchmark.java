@@ -0,0 +1,110 @@
+package icsneoffm.benchmarks;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+import icsneoffm.Icsneo;
+import icsneoffm.NeoLayouts;
+import icsneoffm.TransmitBatch;
+
+import static java.lang.foreign.ValueLayout.JAVA_BYTE;
+import static java.lang.foreign.ValueLayout.JAVA_INT;
+import static java.lang.foreign.ValueLayout.JAVA_LONG;
+import static java.lang.foreign.ValueLayout.JAVA_SHORT;
+
+/**
+ * Building and queueing CAN frames for transmit, one at a time and as a batch of BATCH, on HS CAN of the
+ * simulated device. DeviceState refuses a real one, where every frame would really go out on the bus.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(value = 1, jvmArgsAppend = "--enable-native-access=ALL-UNNAMED")
+public class TransmitBenchmark {
+    private static final int BATCH = 100;
+
+    private Arena arena;
+    private byte[] payload = { (byte) 0xaa, (byte) 0xbb, (byte) 0xcc, (byte) 0xdd, (byte) 0xee, (byte) 0xff, 0x00, 0x11 };
+    private MemorySegment message;
+    private MemorySegment messageData;
+    private TransmitBatch batch;
+    private int[] netids = new int[BATCH];
+    private int[] arbids = new int[BATCH];
+    private int[] flags = new int[BATCH];
+    private int[] lengths = new int[BATCH];
+    private byte[] batchPayload = new byte[BATCH * 8];
+
+    @Setup
+    public void setup() {
+        arena = Arena.ofShared();
+        message = arena.allocate(NeoLayouts.NEOMESSAGE_CAN_T);
+        messageData = arena.allocate(payload.length);
+        batch = new TransmitBatch(arena, BATCH, BATCH * 8);
+        for(int i = 0; i < BATCH; i++)
+            System.arraycopy(payload, 0, batchPayload, i * 8, 8);
+    }
+
+    @TearDown
+    public void tearDown() {
+        arena.close();
+    }
+
+    @Benchmark
+    public boolean jniTransmit(DeviceState device) throws Throwable {
+        Object message = (Object) Jni.NEW_NEOMESSAGE_CAN_T.invokeExact();
+        Jni.CAN_SET_ARBID.invokeExact(message, 0x120L);
+        Jni.CAN_SET_LENGTH.invokeExact(message, (long) payload.length);
+        Jni.CAN_SET_NETID.invokeExact(message, Icsneo.ICSNEO_NETID_HSCAN);
+        Jni.CAN_SET_DATA.invokeExact(message, (Object) payload);
+        boolean result = (boolean) Jni.TRANSMIT.invokeExact(device.jniDevice, (Object) Jni.FROM_CAN_CAST.invokeExact(message));
+        Jni.DELETE_NEOMESSAGE_CAN_T.invokeExact(message);
+        return result;
+    }
+
+    @Benchmark
+    public boolean ffmTransmit(DeviceState device) {
+        MemorySegment.copy(payload, 0, messageData, JAVA_BYTE, 0, payload.length);
+        message.set(JAVA_LONG, NeoLayouts.NEOMESSAGE_DATA_OFFSET, messageData.address());
+        message.set(JAVA_LONG, NeoLayouts.NEOMESSAGE_LENGTH_OFFSET, payload.length);
+        message.set(JAVA_INT, NeoLayouts.NEOMESSAGE_CAN_ARBID_OFFSET, 0x120);
+        message.set(JAVA_SHORT, NeoLayouts.NEOMESSAGE_NETID_OFFSET, (short) Icsneo.ICSNEO_NETID_HSCAN);
+        message.set(JAVA_BYTE, NeoLayouts.NEOMESSAGE_TYPE_OFFSET, (byte) Icsneo.ICSNEO_NETWORK_TYPE_CAN);
+        return Icsneo.transmit(device.device, message);
+    }
+
+    @Benchmark
+    public boolean jniTransmitMessages(DeviceState device) throws Throwable {
+        // Filled every time, as the FFM batch is
+        for(int i = 0; i < BATCH; i++) {
+            netids[i] = Icsneo.ICSNEO_NETID_HSCAN;
+            arbids[i] = 0x120 + i;
+            flags[i] = 0;
+            lengths[i] = 8;
+        }
+        return (boolean) Jni.TRANSMIT_MESSAGES.invokeExact(device.jniDevice, (Object) netids, (Object) arbids, (Object) flags,
+            (Object) lengths, (Object) batchPayload, BATCH);
+    }
+
+    @Benchmark
+    public boolean ffmTransmitMessages(DeviceState device) {
+        batch.clear();
+        for(int i = 0; i < BATCH; i++)
+            batch.add(Icsneo.ICSNEO_NETID_HSCAN, 0x120 + i, 0, batchPayload, i * 8, 8);
+        return batch.transmit(device.device);
+    }
+}
@@ -0,0 +1,244 @@
+package icsneoffm;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.FunctionDescriptor;
+import java.lang.foreign.Linker;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.SegmentAllocator;
+import java.lang.foreign.SymbolLookup;
+import java.lang.invoke.MethodHandle;
+
+import static java.lang.foreign.ValueLayout.ADDRESS;
+import static java.lang.foreign.ValueLayout.JAVA_BOOLEAN;
+import static java.lang.foreign.ValueLayout.JAVA_LONG;
+import static java.lang.foreign.ValueLayout.JAVA_SHORT;
+
+/**
+ * Calls into icsneoc through the Foreign Function & Memory API, with no generated glue library.
+ *
+ * Every function takes the same arguments as its C counterpart, with pointers passed as MemorySegments
+ * laid out by NeoLayouts. Structs are read in place, see NeoMessageCursor, so nothing is copied into
+ * Java objects unless asked for. The handles are static final, so the JIT inlines them into the caller.
+ *
+ * Run with --enable-native-access=ALL-UNNAMED to allow the downcalls without a warning.
+ */
+public final class Icsneo {
+    public static final int ICSNEO_NETWORK_TYPE_CAN = 2;
+    public static final int ICSNEO_NETID_HSCAN = 1;
+    public static final int ICSNEO_NETID_MSCAN = 2;
+    public static final int ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION = 42;
+
+    private static final MethodHandle FIND_ALL_DEVICES;
+    private static final MethodHandle FREE_UNCONNECTED_DEVICES;
+    private static final MethodHandle DESCRIBE_DEVICE;
+    private static final MethodHandle OPEN_DEVICE;
+    private static final MethodHandle CLOSE_DEVICE;
+    private static final MethodHandle GO_ONLINE;
+    private static final MethodHandle GO_OFFLINE;
+    private static final MethodHandle ENABLE_MESSAGE_POLLING;
+    private static final MethodHandle DISABLE_MESSAGE_POLLING;
+    private static final MethodHandle GET_MESSAGES;
+    private static final MethodHandle TRANSMIT;
+    private static final MethodHandle TRANSMIT_MESSAGES;
+    private static final MethodHandle SET_BAUDRATE;
+    private static final MethodHandle GET_LAST_ERROR;
+    private static final MethodHandle GET_VERSION;
+
+    static {
+        System.loadLibrary("icsneoc");
+        Linker linker = Linker.nativeLinker();
+        SymbolLookup icsneoc = SymbolLookup.loaderLookup();
+
+        FIND_ALL_DEVICES = downcall(linker, icsneoc, "icsneo_findAllDevices", FunctionDescriptor.ofVoid(ADDRESS, ADDRESS));
+        FREE_UNCONNECTED_DEVICES = downcall(linker, icsneoc, "icsneo_freeUnconnectedDevices", FunctionDescriptor.ofVoid());
+        DESCRIBE_DEVICE = downcall(linker, icsneoc, "icsneo_describeDevice", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS, ADDRESS, ADDRESS));
+        OPEN_DEVICE = downcall(linker, icsneoc, "icsneo_openDevice", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS));
+        CLOSE_DEVICE = downcall(linker, icsneoc, "icsneo_closeDevice", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS));
+        GO_ONLINE = downcall(linker, icsneoc, "icsneo_goOnline", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS));
+        GO_OFFLINE = downcall(linker, icsneoc, "icsneo_goOffline", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS));
+        ENABLE_MESSAGE_POLLING = downcall(linker, icsneoc, "icsneo_enableMessagePolling", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS));
+        DISABLE_MESSAGE_POLLING = downcall(linker, icsneoc, "icsneo_disableMessagePolling", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS));
+        GET_MESSAGES = downcall(linker, icsneoc, "icsneo_getMessages", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS, ADDRESS, ADDRESS, JAVA_LONG));
+        TRANSMIT = downcall(linker, icsneoc, "icsneo_transmit", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS, ADDRESS));
+        TRANSMIT_MESSAGES = downcall(linker, icsneoc, "icsneo_transmitMessages", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS, ADDRESS, JAVA_LONG));
+        SET_BAUDRATE = downcall(linker, icsneoc, "icsneo_setBaudrate", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS, JAVA_SHORT, JAVA_LONG));
+        GET_LAST_ERROR = downcall(linker, icsneoc, "icsneo_getLastError", FunctionDescriptor.of(JAVA_BOOLEAN, ADDRESS));
+        GET_VERSION = downcall(linker, icsneoc, "icsneo_getVersion", FunctionDescriptor.of(NeoLayouts.NEOVERSION_T));
+    }
+
+    private Icsneo() {}
+
+    private static MethodHandle downcall(Linker linker, SymbolLookup lookup, String name, FunctionDescriptor descriptor) {
+        MemorySegment symbol = lookup.find(name).orElseThrow(() -> new UnsatisfiedLinkError("icsneoc does not export " + name));
+        return linker.downcallHandle(symbol, descriptor);
+    }
+
+    /**
+     * @param devices an array of NeoLayouts.NEODEVICE_T
+     * @param count a size_t, the capacity of devices going in and the number found coming out
+     */
+    public static void findAllDevices(MemorySegment devices, MemorySegment count) {
+        try {
+            FIND_ALL_DEVICES.invokeExact(devices, count);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    public static void freeUnconnectedDevices() {
+        try {
+            FREE_UNCONNECTED_DEVICES.invokeExact();
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    /**
+     * @param description a char buffer, ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION + 1 bytes holds any description
+     * @param maxLength a size_t, the size of description going in and the length written coming out
+     */
+    public static boolean describeDevice(MemorySegment device, MemorySegment description, MemorySegment maxLength) {
+        try {
+            return (boolean) DESCRIBE_DEVICE.invokeExact(device, description, maxLength);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    public static boolean openDevice(MemorySegment device) {
+        try {
+            return (boolean) OPEN_DEVICE.invokeExact(device);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    public static boolean closeDevice(MemorySegment device) {
+        try {
+            return (boolean) CLOSE_DEVICE.invokeExact(device);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    public static boolean goOnline(MemorySegment device) {
+        try {
+            return (boolean) GO_ONLINE.invokeExact(device);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    public static boolean goOffline(MemorySegment device) {
+        try {
+            return (boolean) GO_OFFLINE.invokeExact(device);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    public static boolean enableMessagePolling(MemorySegment device) {
+        try {
+            return (boolean) ENABLE_MESSAGE_POLLING.invokeExact(device);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    public static boolean disableMessagePolling(MemorySegment device) {
+        try {
+            return (boolean) DISABLE_MESSAGE_POLLING.invokeExact(device);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    /**
+     * @param messages an array of NeoLayouts.NEOMESSAGE_T, read it with a NeoMessageCursor
+     * @param items a size_t, the capacity of messages going in and the number received coming out
+     * @param timeout in milliseconds, 0 returns straight away (unsigned)
+     */
+    public static boolean getMessages(MemorySegment device, MemorySegment messages, MemorySegment items, long timeout) {
+        try {
+            return (boolean) GET_MESSAGES.invokeExact(device, messages, items, timeout);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    /**
+     * @param message a NeoLayouts.NEOMESSAGE_T or NEOMESSAGE_CAN_T, its data must point at native memory
+     */
+    public static boolean transmit(MemorySegment device, MemorySegment message) {
+        try {
+            return (boolean) TRANSMIT.invokeExact(device, message);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    /**
+     * @param messages an array of count NeoLayouts.NEOMESSAGE_T or NEOMESSAGE_CAN_T
+     */
+    public static boolean transmitMessages(MemorySegment device, MemorySegment messages, long count) {
+        try {
+            return (boolean) TRANSMIT_MESSAGES.invokeExact(device, messages, count);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    public static boolean setBaudrate(MemorySegment device, int netid, long baudrate) {
+        try {
+            return (boolean) SET_BAUDRATE.invokeExact(device, (short) netid, baudrate);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    /**
+     * @param error a NeoLayouts.NEOEVENT_T to fill in
+     * @return false if there was no error
+     */
+    public static boolean getLastError(MemorySegment error) {
+        try {
+            return (boolean) GET_LAST_ERROR.invokeExact(error);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    /**
+     * @return a NeoLayouts.NEOVERSION_T allocated from allocator
+     */
+    public static MemorySegment getVersion(SegmentAllocator allocator) {
+        try {
+            return (MemorySegment) GET_VERSION.invokeExact(allocator);
+        } catch(Throwable t) {
+            throw new AssertionError(t);
+        }
+    }
+
+    /**
+     * Reads a NUL terminated string which a struct points to, such as neoevent_t.description
+     */
+    public static String getString(MemorySegment pointer) {
+        if(pointer.equals(MemorySegment.NULL))
+            return null;
+        return pointer.reinterpret(Long.MAX_VALUE).getString(0);
+    }
+
+    /**
+     * Describes the device as "Type Serial", returning null on failure
+     */
+    public static String describeDevice(MemorySegment device) {
+        try(Arena arena = Arena.ofConfined()) {
+            MemorySegment description = arena.allocate(ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION + 1);
+            MemorySegment maxLength = arena.allocate(JAVA_LONG);
+            maxLength.set(JAVA_LONG, 0, ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION); // The extra byte stays 0 to terminate it
+            if(!describeDevice(device, description, maxLength))
+                return null;
+            return description.getString(0);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+package icsneoffm;
+
+import java.lang.foreign.MemoryLayout;
+import java.lang.foreign.MemoryLayout.PathElement;
+import java.lang.foreign.StructLayout;
+
+import static java.lang.foreign.ValueLayout.ADDRESS;
+import static java.lang.foreign.ValueLayout.JAVA_BYTE;
+import static java.lang.foreign.ValueLayout.JAVA_INT;
+import static java.lang.foreign.ValueLayout.JAVA_LONG;
+import static java.lang.foreign.ValueLayout.JAVA_SHORT;
+
+/**
+ * The structs of the icsneoc API, as laid out by a 64-bit C compiler. They follow the headers in
+ * third-party/libicsneo/include/icsneo, keep the two in sync.
+ *
+ * size_t and time_t are 64-bit on every platform the Foreign Function & Memory API supports, so they are
+ * JAVA_LONG here. neomessage_statusbitfield_t is a union of bitfields, it is kept as four raw 32-bit words.
+ */
+public final class NeoLayouts {
+    public static final StructLayout NEODEVICE_T = MemoryLayout.structLayout(
+        ADDRESS.withName("device"),
+        JAVA_INT.withName("handle"),
+        JAVA_INT.withName("type"),
+        MemoryLayout.sequenceLayout(7, JAVA_BYTE).withName("serial"),
+        MemoryLayout.paddingLayout(1)
+    ).withName("neodevice_t");
+
+    public static final StructLayout NEOMESSAGE_T = MemoryLayout.structLayout(
+        MemoryLayout.sequenceLayout(4, JAVA_INT).withName("status"),
+        JAVA_LONG.withName("timestamp"),
+        JAVA_LONG.withName("timestampReserved"),
+        ADDRESS.withName("data"),
+        JAVA_LONG.withName("length"),
+        MemoryLayout.sequenceLayout(4, JAVA_BYTE).withName("header"),
+        JAVA_SHORT.withName("netid"),
+        JAVA_BYTE.withName("type"),
+        MemoryLayout.sequenceLayout(17, JAVA_BYTE).withName("reserved")
+    ).withName("neomessage_t");
+
+    // neomessage_t with the CAN specific header
+    public static final StructLayout NEOMESSAGE_CAN_T = MemoryLayout.structLayout(
+        MemoryLayout.sequenceLayout(4, JAVA_INT).withName("status"),
+        JAVA_LONG.withName("timestamp"),
+        JAVA_LONG.withName("timestampReserved"),
+        ADDRESS.withName("data"),
+        JAVA_LONG.withName("length"),
+        JAVA_INT.withName("arbid"),
+        JAVA_SHORT.withName("netid"),
+        JAVA_BYTE.withName("type"),
+        JAVA_BYTE.withName("dlcOnWire"),
+        MemoryLayout.sequenceLayout(16, JAVA_BYTE).withName("reserved")
+    ).withName("neomessage_can_t");
+
+    public static final StructLayout NEOEVENT_T = MemoryLayout.structLayout(
+        ADDRESS.withName("description"),
+        JAVA_LONG.withName("timestamp"),
+        JAVA_INT.withName("eventNumber"),
+        JAVA_BYTE.withName("severity"),
+        MemoryLayout.sequenceLayout(7, JAVA_BYTE).withName("serial"),
+        MemoryLayout.sequenceLayout(16, JAVA_BYTE).withName("reserved"),
+        MemoryLayout.paddingLayout(4)
+    ).withName("neoevent_t");
+
+    public static final StructLayout NEOVERSION_T = MemoryLayout.structLayout(
+        JAVA_SHORT.withName("major"),
+        JAVA_SHORT.withName("minor"),
+        JAVA_SHORT.withName("patch"),
+        MemoryLayout.paddingLayout(2),
+        ADDRESS.withName("metadata"),
+        ADDRESS.withName("buildBranch"),
+        ADDRESS.withName("buildTag"),
+        MemoryLayout.sequenceLayout(32, JAVA_BYTE).withName("reserved")
+    ).withName("neoversion_t");
+
+    public static final long NEODEVICE_SIZE = NEODEVICE_T.byteSize();
+    public static final long NEODEVICE_TYPE_OFFSET = offset(NEODEVICE_T, "type");
+    public static final long NEODEVICE_SERIAL_OFFSET = offset(NEODEVICE_T, "serial");
+
+    public static final long NEOMESSAGE_SIZE = NEOMESSAGE_T.byteSize();
+    public static final long NEOMESSAGE_STATUS_OFFSET = offset(NEOMESSAGE_T, "status");
+    public static final long NEOMESSAGE_TIMESTAMP_OFFSET = offset(NEOMESSAGE_T, "timestamp");
+    public static final long NEOMESSAGE_DATA_OFFSET = offset(NEOMESSAGE_T, "data");
+    public static final long NEOMESSAGE_LENGTH_OFFSET = offset(NEOMESSAGE_T, "length");
+    public static final long NEOMESSAGE_NETID_OFFSET = offset(NEOMESSAGE_T, "netid");
+    public static final long NEOMESSAGE_TYPE_OFFSET = offset(NEOMESSAGE_T, "type");
+    public static final long NEOMESSAGE_CAN_ARBID_OFFSET = offset(NEOMESSAGE_CAN_T, "arbid");
+
+    public static final long NEOEVENT_SIZE = NEOEVENT_T.byteSize();
+    public static final long NEOEVENT_DESCRIPTION_OFFSET = offset(NEOEVENT_T, "description");
+    public static final long NEOEVENT_EVENT_NUMBER_OFFSET = offset(NEOEVENT_T, "eventNumber");
+
+    // Bits of the first word of neomessage_statusbitfield_t
+    public static final int STATUS_GLOBAL_ERROR = 0x01;
+    public static final int STATUS_TRANSMIT_MESSAGE = 0x02;
+    public static final int STATUS_EXTENDED_FRAME = 0x04;
+    public static final int STATUS_REMOTE_FRAME = 0x08;
+
+    // Bits of the fourth word of neomessage_statusbitfield_t
+    public static final int STATUS_CANFD_FDF = 0x10;
+    public static final int STATUS_CANFD_BRS = 0x20;
+
+    static {
+        if(ADDRESS.byteSize() != 8)
+            throw new ExceptionInInitializerError("icsneoffm only supports 64-bit platforms");
+    }
+
+    private NeoLayouts() {}
+
+    private static long offset(StructLayout layout, String field) {
+        return layout.byteOffset(PathElement.groupElement(field));
+    }
+}
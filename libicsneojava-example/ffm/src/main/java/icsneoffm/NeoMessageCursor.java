@@ -0,0 +1,140 @@
+package icsneoffm;
+
+import java.lang.foreign.MemorySegment;
+
+import static java.lang.foreign.ValueLayout.ADDRESS;
+import static java.lang.foreign.ValueLayout.JAVA_BYTE;
+import static java.lang.foreign.ValueLayout.JAVA_INT;
+import static java.lang.foreign.ValueLayout.JAVA_LONG;
+import static java.lang.foreign.ValueLayout.JAVA_SHORT;
+
+/**
+ * Reads the messages in a native neomessage_t array, as filled by Icsneo.getMessages, in place.
+ *
+ * The cursor points at one message at a time and reads each field straight out of the segment when asked,
+ * so going through a batch creates no objects and makes no native calls. Reuse one cursor for every poll.
+ */
+public class NeoMessageCursor {
+    private static final MemorySegment EVERYTHING = MemorySegment.NULL.reinterpret(Long.MAX_VALUE);
+
+    private final MemorySegment messages;
+    private final long capacity;
+    private long count;
+    private long index;
+    private long position;
+
+    /**
+     * @param messages an array of NeoLayouts.NEOMESSAGE_T
+     */
+    public NeoMessageCursor(MemorySegment messages) {
+        this.messages = messages;
+        capacity = messages.byteSize() / NeoLayouts.NEOMESSAGE_SIZE;
+        reset(0);
+    }
+
+    /**
+     * Starts over after a poll, call next() to move to the first message
+     * @param count the number of messages Icsneo.getMessages returned
+     */
+    public NeoMessageCursor reset(long count) {
+        this.count = Math.max(0, Math.min(count, capacity));
+        index = -1;
+        position = -NeoLayouts.NEOMESSAGE_SIZE;
+        return this;
+    }
+
+    /**
+     * Moves to the next message
+     * @return false once every message has been visited
+     */
+    public boolean next() {
+        if(index + 1 >= count)
+            return false;
+        index++;
+        position += NeoLayouts.NEOMESSAGE_SIZE;
+        return true;
+    }
+
+    /**
+     * Moves to a message
+     * @param index from 0 to the count passed to reset()
+     */
+    public NeoMessageCursor moveTo(long index) {
+        if(index < 0 || index >= count)
+            throw new IndexOutOfBoundsException("Message " + index + " of " + count);
+        this.index = index;
+        position = index * NeoLayouts.NEOMESSAGE_SIZE;
+        return this;
+    }
+
+    public long getIndex() {
+        return index;
+    }
+
+    public int getNetid() {
+        return messages.get(JAVA_SHORT, position + NeoLayouts.NEOMESSAGE_NETID_OFFSET) & 0xFFFF;
+    }
+
+    public int getType() {
+        return messages.get(JAVA_BYTE, position + NeoLayouts.NEOMESSAGE_TYPE_OFFSET) & 0xFF;
+    }
+
+    /**
+     * The timestamp in nanoseconds since 1/1/2007 (unsigned)
+     */
+    public long getTimestamp() {
+        return messages.get(JAVA_LONG, position + NeoLayouts.NEOMESSAGE_TIMESTAMP_OFFSET);
+    }
+
+    public int getLength() {
+        return (int) messages.get(JAVA_LONG, position + NeoLayouts.NEOMESSAGE_LENGTH_OFFSET);
+    }
+
+    /**
+     * The arbitration ID, only meaningful when getType() is Icsneo.ICSNEO_NETWORK_TYPE_CAN
+     */
+    public long getArbid() {
+        return messages.get(JAVA_INT, position + NeoLayouts.NEOMESSAGE_CAN_ARBID_OFFSET) & 0xFFFFFFFFL;
+    }
+
+    /**
+     * One of the four 32-bit words of the raw neomessage_statusbitfield_t
+     * @param word from 0 to 3
+     */
+    public int getStatus(int word) {
+        return messages.get(JAVA_INT, position + NeoLayouts.NEOMESSAGE_STATUS_OFFSET + word * 4L);
+    }
+
+    public boolean isTransmitted() {
+        return (getStatus(0) & NeoLayouts.STATUS_TRANSMIT_MESSAGE) != 0;
+    }
+
+    public boolean isExtended() {
+        return (getStatus(0) & NeoLayouts.STATUS_EXTENDED_FRAME) != 0;
+    }
+
+    public boolean isCANFD() {
+        return (getStatus(3) & NeoLayouts.STATUS_CANFD_FDF) != 0;
+    }
+
+    /**
+     * The payload, as a segment over the library's own buffer. It is only valid until the next poll.
+     */
+    public MemorySegment getData() {
+        return messages.get(ADDRESS, position + NeoLayouts.NEOMESSAGE_DATA_OFFSET).reinterpret(getLength());
+    }
+
+    /**
+     * Copies the payload into destination at offset
+     * @return the number of bytes copied, or -1 if they did not fit
+     */
+    public int copyData(byte[] destination, int offset) {
+        int length = getLength();
+        if(offset < 0 || destination.length - offset < length)
+            return -1;
+        // Through a segment spanning all of memory, as making one over the payload would allocate
+        long address = messages.get(JAVA_LONG, position + NeoLayouts.NEOMESSAGE_DATA_OFFSET);
+        MemorySegment.copy(EVERYTHING, JAVA_BYTE, address, destination, offset, length);
+        return length;
+    }
+}
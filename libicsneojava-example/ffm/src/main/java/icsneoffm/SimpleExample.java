@@ -0,0 +1,113 @@
+package icsneoffm;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+
+import static java.lang.foreign.ValueLayout.ADDRESS;
+import static java.lang.foreign.ValueLayout.JAVA_INT;
+import static java.lang.foreign.ValueLayout.JAVA_LONG;
+import static java.lang.foreign.ValueLayout.JAVA_SHORT;
+
+/**
+ * Opens the first device found, receives for a few seconds, then transmits a batch of CAN frames
+ */
+public class SimpleExample {
+    private static final int MAX_DEVICES = 10;
+    private static final int MAX_MESSAGES = 20000;
+
+    public static void main(String[] args) throws InterruptedException {
+        try(Arena arena = Arena.ofConfined()) {
+            // major, minor and patch are the first three fields of neoversion_t
+            MemorySegment version = Icsneo.getVersion(arena);
+            System.out.println("ICS icsneoc version " + version.get(JAVA_SHORT, 0) + "." + version.get(JAVA_SHORT, 2) + "." + version.get(JAVA_SHORT, 4));
+
+            MemorySegment devices = arena.allocate(NeoLayouts.NEODEVICE_T, MAX_DEVICES);
+            MemorySegment count = arena.allocate(JAVA_LONG);
+            count.set(JAVA_LONG, 0, MAX_DEVICES);
+            Icsneo.findAllDevices(devices, count);
+            if(count.get(JAVA_LONG, 0) == 0) {
+                System.out.println("No devices found!");
+                return;
+            }
+
+            MemorySegment device = devices.asSlice(0, NeoLayouts.NEODEVICE_SIZE);
+            String description = Icsneo.describeDevice(device);
+            System.out.println("Opening " + description);
+            if(!Icsneo.openDevice(device)) {
+                printLastError(arena);
+                return;
+            }
+
+            if(Icsneo.goOnline(device) && Icsneo.enableMessagePolling(device)) {
+                receive(arena, device);
+                transmit(arena, device);
+            } else {
+                printLastError(arena);
+            }
+
+            Icsneo.closeDevice(device);
+            Icsneo.freeUnconnectedDevices();
+        }
+    }
+
+    private static void receive(Arena arena, MemorySegment device) throws InterruptedException {
+        MemorySegment messages = arena.allocate(NeoLayouts.NEOMESSAGE_T, MAX_MESSAGES);
+        MemorySegment items = arena.allocate(JAVA_LONG);
+        NeoMessageCursor cursor = new NeoMessageCursor(messages);
+        byte[] payload = new byte[64];
+
+        System.out.println("Receiving for 5 seconds");
+        for(int second = 0; second < 5; second++) {
+            Thread.sleep(1000);
+            items.set(JAVA_LONG, 0, MAX_MESSAGES);
+            if(!Icsneo.getMessages(device, messages, items, 0)) {
+                printLastError(arena);
+                return;
+            }
+
+            long canMessages = 0;
+            cursor.reset(items.get(JAVA_LONG, 0));
+            while(cursor.next()) {
+                if(cursor.getType() != Icsneo.ICSNEO_NETWORK_TYPE_CAN)
+                    continue;
+                canMessages++;
+                // Show the first CAN message of each poll
+                if(canMessages == 1) {
+                    int length = cursor.copyData(payload, 0);
+                    StringBuilder data = new StringBuilder();
+                    for(int i = 0; i < length; i++)
+                        data.append(String.format(" %02x", payload[i]));
+                    System.out.println("\t0x" + Long.toHexString(cursor.getArbid()) + " [" + length + "]" + data);
+                }
+            }
+            System.out.println("Received " + items.get(JAVA_LONG, 0) + " messages, " + canMessages + " of them CAN");
+        }
+    }
+
+    private static void transmit(Arena arena, MemorySegment device) {
+        TransmitBatch batch = new TransmitBatch(arena, 100, 100 * 8);
+        byte[] payload = new byte[8];
+
+        // Arbids 0x120 to 0x183 on HS CAN, each carrying its index as an 8 byte counter
+        for(int i = 0; i < 100; i++) {
+            for(int j = 0; j < 8; j++)
+                payload[j] = (byte) ((long) i >>> 8 * (7 - j));
+            batch.add(Icsneo.ICSNEO_NETID_HSCAN, 0x120 + i, 0, payload, 0, payload.length);
+        }
+
+        if(batch.transmit(device))
+            System.out.println("Transmitted " + batch.size() + " messages");
+        else
+            printLastError(arena);
+    }
+
+    private static void printLastError(Arena arena) {
+        MemorySegment error = arena.allocate(NeoLayouts.NEOEVENT_T);
+        if(Icsneo.getLastError(error)) {
+            System.out.println("Error 0x" + Integer.toHexString(error.get(JAVA_INT, NeoLayouts.NEOEVENT_EVENT_NUMBER_OFFSET)) + ": "
+                + Icsneo.getString(error.get(ADDRESS, NeoLayouts.NEOEVENT_DESCRIPTION_OFFSET)));
+        } else {
+            System.out.println("No errors found!");
+        }
+    }
+}
@@ -0,0 +1,99 @@
+package icsneoffm;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+
+import static java.lang.foreign.ValueLayout.JAVA_BYTE;
+import static java.lang.foreign.ValueLayout.JAVA_INT;
+import static java.lang.foreign.ValueLayout.JAVA_LONG;
+import static java.lang.foreign.ValueLayout.JAVA_SHORT;
+
+/**
+ * Builds CAN frames directly in a native neomessage_can_t array and transmits them all with a single
+ * Icsneo.transmitMessages call. The array and the payloads live in segments allocated once, so adding
+ * frames only writes native memory. Create one batch and clear() it between sends.
+ */
+public class TransmitBatch {
+    // The same bits as the JNI binding's MessageRecordReader.FLAG_ constants
+    public static final int FLAG_EXTENDED = 0x02;
+    public static final int FLAG_REMOTE = 0x04;
+    public static final int FLAG_CANFD = 0x08;
+    public static final int FLAG_BRS = 0x10;
+
+    private static final long SIZE = NeoLayouts.NEOMESSAGE_CAN_T.byteSize();
+    private static final long STATUS_OFFSET = NeoLayouts.NEOMESSAGE_STATUS_OFFSET;
+    private static final long DATA_OFFSET = NeoLayouts.NEOMESSAGE_DATA_OFFSET;
+    private static final long LENGTH_OFFSET = NeoLayouts.NEOMESSAGE_LENGTH_OFFSET;
+    private static final long ARBID_OFFSET = NeoLayouts.NEOMESSAGE_CAN_ARBID_OFFSET;
+    private static final long NETID_OFFSET = NeoLayouts.NEOMESSAGE_NETID_OFFSET;
+    private static final long TYPE_OFFSET = NeoLayouts.NEOMESSAGE_TYPE_OFFSET;
+
+    private final MemorySegment messages;
+    private final MemorySegment payload;
+    private final int maxFrames;
+    private int count;
+    private long payloadUsed;
+
+    /**
+     * @param arena where the batch is allocated, it is valid until the arena is closed
+     * @param maxFrames the number of frames the batch holds
+     * @param maxPayloadBytes the total payload of those frames, 64 bytes per frame covers CAN FD
+     */
+    public TransmitBatch(Arena arena, int maxFrames, int maxPayloadBytes) {
+        messages = arena.allocate(NeoLayouts.NEOMESSAGE_CAN_T, maxFrames);
+        payload = arena.allocate(Math.max(1, maxPayloadBytes));
+        this.maxFrames = maxFrames;
+    }
+
+    /**
+     * Adds a frame to the batch
+     * @param flags FLAG_EXTENDED, FLAG_REMOTE, FLAG_CANFD and FLAG_BRS, or 0
+     * @return false if the batch is full, in which case nothing was added
+     */
+    public boolean add(int netid, int arbid, int flags, byte[] data, int offset, int length) {
+        if(count == maxFrames || length > payload.byteSize() - payloadUsed)
+            return false;
+        long position = count * SIZE;
+        MemorySegment.copy(data, offset, payload, JAVA_BYTE, payloadUsed, length);
+
+        // Every field is written, as a cleared batch is reused without zeroing it
+        messages.set(JAVA_INT, position + STATUS_OFFSET,
+            ((flags & FLAG_EXTENDED) != 0 ? NeoLayouts.STATUS_EXTENDED_FRAME : 0) | ((flags & FLAG_REMOTE) != 0 ? NeoLayouts.STATUS_REMOTE_FRAME : 0));
+        messages.set(JAVA_INT, position + STATUS_OFFSET + 4, 0);
+        messages.set(JAVA_INT, position + STATUS_OFFSET + 8, 0);
+        messages.set(JAVA_INT, position + STATUS_OFFSET + 12,
+            ((flags & FLAG_CANFD) != 0 ? NeoLayouts.STATUS_CANFD_FDF : 0) | ((flags & FLAG_BRS) != 0 ? NeoLayouts.STATUS_CANFD_BRS : 0));
+        // A raw address rather than a slice of payload, which would allocate
+        messages.set(JAVA_LONG, position + DATA_OFFSET, payload.address() + payloadUsed);
+        messages.set(JAVA_LONG, position + LENGTH_OFFSET, length);
+        messages.set(JAVA_INT, position + ARBID_OFFSET, arbid);
+        messages.set(JAVA_SHORT, position + NETID_OFFSET, (short) netid);
+        messages.set(JAVA_BYTE, position + TYPE_OFFSET, (byte) Icsneo.ICSNEO_NETWORK_TYPE_CAN);
+
+        payloadUsed += length;
+        count++;
+        return true;
+    }
+
+    public int size() {
+        return count;
+    }
+
+    /**
+     * Removes every frame, so the batch can be filled again
+     */
+    public TransmitBatch clear() {
+        count = 0;
+        payloadUsed = 0;
+        return this;
+    }
+
+    /**
+     * Queues every frame in the batch for transmit. The batch is left as it is, call clear() to start a new one.
+     */
+    public boolean transmit(MemorySegment device) {
+        if(count == 0)
+            return true;
+        return Icsneo.transmitMessages(device, messages, count);
+    }
+}
@@ -9,6 +9,14 @@
 
 #define DLLExport
 
+/*
+ * Timestamps and timeouts are uint64_t, which SWIG maps to java.math.BigInteger by default. That allocates
+ * on every timestamp read and every poll, so map them to a primitive long instead. The values are unsigned,
+ * use Long.toUnsignedString() and Long.compareUnsigned() where the top bit matters. Timestamps, in
+ * nanoseconds since 1/1/2007, do not reach it until the year 2299.
+ */
+%apply long long { uint64_t };
+
 %typemap(jni) uint8_t const *data "jbyteArray"
 %typemap(jtype) uint8_t const *data "byte[]"
 %typemap(jstype) uint8_t const *data "byte[]"
@@ -23,9 +31,11 @@
     (*jenv)->SetByteArrayRegion(jenv, $result, 0, (int) arg1->length, $1);
 %}
 
+/* setData copies the payload into memory the message owns, see icsneojava_setData */
 %typemap(in) uint8_t const *data %{
-    bool isCopy;
-    arg2 = (*jenv)->GetByteArrayElements(jenv, jarg2, &isCopy);
+    $1 = icsneojava_setData(jenv, arg1, $input);
+    if($1 == NULL && (*jenv)->ExceptionCheck(jenv))
+        return $null;
 %}
 
 %typemap(jni) char *str "jobject"
@@ -85,8 +95,63 @@
 
 %{
 #include "icsneo/icsneoc.h"
+
+/* Gives the shared structs the names the Java proxies are generated from */
+#define icsneobinding_filter_t icsneojava_filter_t
+#define icsneobinding_listener_t icsneojava_listener_t
+#include "icsneobinding.h"
 %}
 
+%{
+/*
+ * Returns the copy of data which message now owns, see icsneobinding_setData, or NULL if data is NULL or empty.
+ * Throws OutOfMemoryError if the copy could not be allocated.
+ */
+static uint8_t* icsneojava_setData(JNIEnv* jenv, void* message, jbyteArray data) {
+	void* bytes = NULL;
+	jsize length = 0;
+	bool set;
+
+	if(message == NULL)
+		return NULL;
+	if(data != NULL) {
+		length = (*jenv)->GetArrayLength(jenv, data);
+		bytes = (*jenv)->GetPrimitiveArrayCritical(jenv, data, NULL);
+		if(bytes == NULL)
+			return NULL;
+	}
+	set = icsneobinding_setData(message, bytes, (size_t) length);
+	if(bytes != NULL)
+		(*jenv)->ReleasePrimitiveArrayCritical(jenv, data, bytes, JNI_ABORT);
+	if(!set) {
+		SWIG_JavaThrowException(jenv, SWIG_JavaOutOfMemoryError, "Unable to allocate the message data");
+		return NULL;
+	}
+	return (uint8_t*) ((neomessage_t*) message)->data;
+}
+%}
+
+%extend neomessage_t {
+	~neomessage_t() {
+		icsneobinding_freeData($self);
+		free($self);
+	}
+}
+
+%extend neomessage_can_t {
+	~neomessage_can_t() {
+		icsneobinding_freeData($self);
+		free($self);
+	}
+}
+
+%extend neomessage_eth_t {
+	~neomessage_eth_t() {
+		icsneobinding_freeData($self);
+		free($self);
+	}
+}
+
 %apply int *INOUT {size_t *};
 
 %ignore icsneo_addMessageCallback;
@@ -122,4 +187,682 @@ static neomessage_t* from_eth_neomessage_t_cast(neomessage_eth_t* msg) {
 
 %array_functions(neodevice_t, neodevice_t_array);
 %array_functions(neoevent_t, neoevent_t_array);
-%array_functions(neomessage_t, neomessage_t_array);
\ No newline at end of file
+%array_functions(neomessage_t, neomessage_t_array);
+
+%{
+/*
+ * icsneojava_getMessagesPacked writes each message as a record into a direct ByteBuffer, so a whole
+ * batch crosses JNI at once. All fields are in native byte order, and each record starts 8 byte aligned.
+ *
+ * Offset  Size  Field
+ *      0     4  Record length, including the header and padding, add it to the offset to find the next record
+ *      4     2  Network ID
+ *      6     1  Network type
+ *      7     1  Flags, see ICSNEOJAVA_RECORD_FLAG_*
+ *      8     8  Timestamp, in nanoseconds since 1/1/2007 (unsigned)
+ *     16     4  Arbitration ID for CAN, otherwise 0
+ *     20     4  Payload length
+ *     24    16  The raw neomessage_statusbitfield_t
+ *     40     n  Payload
+ *
+ * MessageRecordReader.java reads this layout, keep the two in sync.
+ */
+#define ICSNEOJAVA_RECORD_HEADER_SIZE 40
+#define ICSNEOJAVA_RECORD_ALIGNMENT 8
+
+#define ICSNEOJAVA_RECORD_FLAG_TRANSMITTED 0x01
+#define ICSNEOJAVA_RECORD_FLAG_EXTENDED 0x02
+#define ICSNEOJAVA_RECORD_FLAG_REMOTE 0x04
+#define ICSNEOJAVA_RECORD_FLAG_CANFD 0x08
+#define ICSNEOJAVA_RECORD_FLAG_BRS 0x10
+#define ICSNEOJAVA_RECORD_FLAG_ERROR 0x20
+
+/*
+ * Holds the messages taken from the device by the last poll. Messages which did not fit in the
+ * caller's buffer stay here and are written first on the next call, so none are lost.
+ *
+ * icsneoc's payloads are only valid until the device is next polled, by anything, so the payloads of the
+ * messages left over are copied into the poller before the call returns.
+ */
+struct icsneojava_poller_t {
+	neomessage_t* messages;
+	size_t capacity;
+	size_t count; /* Messages returned by the last icsneo_getMessages call */
+	size_t next; /* The first of those which has not been written out yet */
+	struct icsneojava_filter_t* filter; /* Messages which do not pass are skipped, NULL passes everything */
+	uint8_t* payloads; /* The copies of the leftover payloads */
+	size_t payloadsCapacity;
+	bool kept; /* Whether the leftover payloads already point into payloads */
+};
+
+static size_t icsneojava_recordSize(size_t length) {
+	return (ICSNEOJAVA_RECORD_HEADER_SIZE + length + ICSNEOJAVA_RECORD_ALIGNMENT - 1) & ~(size_t)(ICSNEOJAVA_RECORD_ALIGNMENT - 1);
+}
+
+static void icsneojava_writeRecord(unsigned char* record, const neomessage_t* message, size_t size) {
+	uint32_t recordLength = (uint32_t) size;
+	uint32_t arbid = message->type == ICSNEO_NETWORK_TYPE_CAN ? ((const neomessage_can_t*) message)->arbid : 0;
+	uint32_t length = (uint32_t) message->length;
+	uint8_t flags = 0;
+
+	if(message->status.transmitMessage)
+		flags |= ICSNEOJAVA_RECORD_FLAG_TRANSMITTED;
+	if(message->status.extendedFrame)
+		flags |= ICSNEOJAVA_RECORD_FLAG_EXTENDED;
+	if(message->status.remoteFrame)
+		flags |= ICSNEOJAVA_RECORD_FLAG_REMOTE;
+	if(message->status.canfdFDF)
+		flags |= ICSNEOJAVA_RECORD_FLAG_CANFD;
+	if(message->status.canfdBRS)
+		flags |= ICSNEOJAVA_RECORD_FLAG_BRS;
+	if(message->status.globalError)
+		flags |= ICSNEOJAVA_RECORD_FLAG_ERROR;
+
+	memcpy(record, &recordLength, 4);
+	memcpy(record + 4, &message->netid, 2);
+	record[6] = message->type;
+	record[7] = flags;
+	memcpy(record + 8, &message->timestamp, 8);
+	memcpy(record + 16, &arbid, 4);
+	memcpy(record + 20, &length, 4);
+	memcpy(record + 24, &message->status, 16);
+	if(message->length != 0)
+		memcpy(record + ICSNEOJAVA_RECORD_HEADER_SIZE, message->data, message->length);
+	memset(record + ICSNEOJAVA_RECORD_HEADER_SIZE + message->length, 0, size - ICSNEOJAVA_RECORD_HEADER_SIZE - message->length);
+}
+%}
+
+%{
+/* Copies the payloads of the messages not written out yet into the poller, so they outlive the next poll of the device */
+static bool icsneojava_keepPayloads(struct icsneojava_poller_t* poller) {
+	size_t total = 0;
+	size_t i;
+
+	if(poller->kept)
+		return true;
+	for(i = poller->next; i < poller->count; i++)
+		total += poller->messages[i].length;
+	if(total > poller->payloadsCapacity) {
+		uint8_t* payloads = (uint8_t*) realloc(poller->payloads, total);
+		if(payloads == NULL)
+			return false;
+		poller->payloads = payloads;
+		poller->payloadsCapacity = total;
+	}
+
+	total = 0;
+	for(i = poller->next; i < poller->count; i++) {
+		neomessage_t* message = &poller->messages[i];
+		if(message->length == 0)
+			continue;
+		memcpy(poller->payloads + total, message->data, message->length);
+		message->data = poller->payloads + total;
+		total += message->length;
+	}
+	poller->kept = true;
+	return true;
+}
+
+/*
+ * The address of a direct ByteBuffer, with capacity clamped to the buffer's size so nothing is written past its end.
+ * Throws and returns NULL if the buffer is not direct.
+ */
+static unsigned char* icsneojava_directBuffer(JNIEnv* jenv, jobject buffer, size_t* capacity) {
+	unsigned char* address = buffer == NULL ? NULL : (unsigned char*) (*jenv)->GetDirectBufferAddress(jenv, buffer);
+	jlong size = buffer == NULL ? -1 : (*jenv)->GetDirectBufferCapacity(jenv, buffer);
+	if(address == NULL || size < 0) {
+		SWIG_JavaThrowException(jenv, SWIG_JavaRuntimeException, "Unable to get address of a java.nio.ByteBuffer direct byte buffer. Buffer must be a direct buffer and not a non-direct buffer.");
+		return NULL;
+	}
+	if(*capacity > (size_t) size)
+		*capacity = (size_t) size;
+	return address;
+}
+%}
+
+%typemap(jtype) jobject buffer "java.nio.ByteBuffer"
+%typemap(jstype) jobject buffer "java.nio.ByteBuffer"
+%typemap(jtype) jobject records "java.nio.ByteBuffer"
+%typemap(jstype) jobject records "java.nio.ByteBuffer"
+
+%inline %{
+typedef struct icsneojava_poller_t icsneojava_poller_t;
+
+/* Creates a poller which takes up to maxMessages from the device at a time */
+static icsneojava_poller_t* icsneojava_newPoller(size_t maxMessages) {
+	icsneojava_poller_t* poller = (icsneojava_poller_t*) calloc(1, sizeof(icsneojava_poller_t));
+	if(poller == NULL)
+		return NULL;
+	poller->messages = (neomessage_t*) calloc(maxMessages, sizeof(neomessage_t));
+	if(poller->messages == NULL) {
+		free(poller);
+		return NULL;
+	}
+	poller->capacity = maxMessages;
+	return poller;
+}
+
+static void icsneojava_deletePoller(icsneojava_poller_t* poller) {
+	if(poller == NULL)
+		return;
+	icsneobinding_freeFilter(poller->filter);
+	free(poller->messages);
+	free(poller->payloads);
+	free(poller);
+}
+
+/* Drops the messages the poller is holding, such as before it is used for another device, returning how many there were */
+static int icsneojava_clearPoller(icsneojava_poller_t* poller) {
+	int dropped;
+	if(poller == NULL)
+		return 0;
+	dropped = (int) (poller->count - poller->next);
+	poller->count = 0;
+	poller->next = 0;
+	return dropped;
+}
+
+/*
+ * Writes as many messages as fit into the direct ByteBuffer records as packed records, returning how many were written
+ * or -1 on failure. capacity is clamped to the size of the buffer.
+ * The device is only polled once the messages from the previous poll have all been written out, and the messages held
+ * until then are those of the device last polled, call icsneojava_clearPoller before using the poller for another.
+ * A message too large to ever fit in the buffer is skipped, so the buffer should hold at least one full size frame.
+ * Messages which do not pass the filter set with icsneojava_setPollerFilter are skipped too, so 0 may be returned
+ * while the device still has messages.
+ */
+static int icsneojava_getMessagesPacked(JNIEnv* jenv, icsneojava_poller_t* poller, const neodevice_t* device, jobject records, size_t capacity, uint64_t timeout) {
+	size_t used = 0;
+	int written = 0;
+	unsigned char* buffer;
+
+	if(poller == NULL)
+		return -1;
+	buffer = icsneojava_directBuffer(jenv, records, &capacity);
+	if(buffer == NULL)
+		return -1;
+
+	if(poller->next == poller->count) {
+		poller->next = 0;
+		poller->count = poller->capacity;
+		poller->kept = false;
+		if(!icsneo_getMessages(device, poller->messages, &poller->count, timeout)) {
+			poller->count = 0;
+			return -1;
+		}
+	}
+
+	while(poller->next < poller->count) {
+		const neomessage_t* message = &poller->messages[poller->next];
+		size_t size = icsneojava_recordSize(message->length);
+		if(size > capacity || !icsneobinding_filterMatches(poller->filter, message)) {
+			poller->next++;
+			continue;
+		}
+		if(used + size > capacity)
+			break;
+		icsneojava_writeRecord(buffer + used, message, size);
+		used += size;
+		written++;
+		poller->next++;
+	}
+	if(poller->next < poller->count && !icsneojava_keepPayloads(poller)) {
+		/* The leftovers cannot be kept safely, drop them rather than read freed payloads later */
+		poller->next = poller->count;
+	}
+	return written;
+}
+%}
+
+%{
+/*
+ * Message listeners, see icsneobinding.h, deliver received messages to Java as the packed records described above.
+ * The delivery thread is attached to the JVM once when it starts, and hands each batch to the Java listener's
+ * onMessages as a direct ByteBuffer over the batch.
+ */
+typedef struct {
+	JavaVM* vm;
+	JNIEnv* env; /* The delivery thread's, once it is attached */
+	jobject listener;
+	jmethodID onMessages;
+} icsneojava_listenerContext_t;
+
+static bool icsneojava_storeRecord(struct icsneojava_listener_t* listener, icsneobinding_batch_t* batch, const neomessage_t* message) {
+	size_t size = icsneojava_recordSize(message->length);
+	if(batch->used + size > listener->capacity)
+		return false;
+	icsneojava_writeRecord(batch->data + batch->used, message, size);
+	batch->used += size;
+	return true;
+}
+
+static void icsneojava_deliverRecords(struct icsneojava_listener_t* listener, icsneobinding_batch_t* batch) {
+	icsneojava_listenerContext_t* context = (icsneojava_listenerContext_t*) listener->context;
+	JNIEnv* env = context->env;
+
+	(*env)->CallVoidMethod(env, context->listener, context->onMessages, (jobject) batch->context, (jint) batch->count);
+	if((*env)->ExceptionCheck(env)) {
+		(*env)->ExceptionDescribe(env);
+		(*env)->ExceptionClear(env);
+	}
+}
+
+static bool icsneojava_attachDelivery(struct icsneojava_listener_t* listener) {
+	icsneojava_listenerContext_t* context = (icsneojava_listenerContext_t*) listener->context;
+	return (*context->vm)->AttachCurrentThreadAsDaemon(context->vm, (void**) &context->env, NULL) == JNI_OK;
+}
+
+static void icsneojava_detachDelivery(struct icsneojava_listener_t* listener) {
+	icsneojava_listenerContext_t* context = (icsneojava_listenerContext_t*) listener->context;
+	(*context->vm)->DetachCurrentThread(context->vm);
+}
+
+static const icsneobinding_listenerOps_t icsneojava_listenerOps = {
+	icsneojava_storeRecord, icsneojava_deliverRecords, icsneojava_attachDelivery, icsneojava_detachDelivery
+};
+
+/* Stops the delivery thread, once it has delivered what is left, and frees everything the listener holds */
+static void icsneojava_freeListener(JNIEnv* jenv, struct icsneojava_listener_t* listener) {
+	icsneojava_listenerContext_t* context = (icsneojava_listenerContext_t*) listener->context;
+	int i;
+
+	icsneobinding_stopListener(listener);
+	for(i = 0; i < 2; i++) {
+		if(listener->batches[i].context != NULL)
+			(*jenv)->DeleteGlobalRef(jenv, (jobject) listener->batches[i].context);
+	}
+	if(context->listener != NULL)
+		(*jenv)->DeleteGlobalRef(jenv, context->listener);
+	free(context);
+	icsneobinding_freeListener(listener);
+}
+%}
+
+%typemap(in, numinputs=0) JNIEnv *jenv "$1 = jenv;"
+%typemap(jtype) jobject listener "MessageListener"
+%typemap(jstype) jobject listener "MessageListener"
+
+%inline %{
+typedef struct icsneojava_listener_t icsneojava_listener_t;
+
+/*
+ * Calls listener.onMessages(ByteBuffer buffer, int records) with batches of received messages, see MessageListener.java.
+ * Returns NULL on failure, including when all ICSNEOBINDING_MAX_LISTENERS listeners are in use.
+ */
+static icsneojava_listener_t* icsneojava_addMessageListener(JNIEnv* jenv, const neodevice_t* device, jobject listener, size_t batchSize, uint64_t maxDelayMicroseconds) {
+	icsneojava_listenerContext_t* context;
+	icsneojava_listener_t* result;
+	jclass listenerClass;
+	int i;
+
+	if(device == NULL || listener == NULL || batchSize == 0)
+		return NULL;
+
+	context = (icsneojava_listenerContext_t*) calloc(1, sizeof(icsneojava_listenerContext_t));
+	if(context == NULL)
+		return NULL;
+	result = icsneobinding_newListener(device, &icsneojava_listenerOps, context, batchSize, batchSize * icsneojava_recordSize(64), maxDelayMicroseconds, NULL);
+	if(result == NULL) {
+		free(context);
+		return NULL;
+	}
+
+	listenerClass = (*jenv)->GetObjectClass(jenv, listener);
+	context->onMessages = (*jenv)->GetMethodID(jenv, listenerClass, "onMessages", "(Ljava/nio/ByteBuffer;I)V");
+	(*jenv)->DeleteLocalRef(jenv, listenerClass);
+	if((*jenv)->GetJavaVM(jenv, &context->vm) != JNI_OK || context->onMessages == NULL) {
+		icsneojava_freeListener(jenv, result);
+		return NULL;
+	}
+	context->listener = (*jenv)->NewGlobalRef(jenv, listener);
+
+	for(i = 0; i < 2; i++) {
+		jobject buffer = (*jenv)->NewDirectByteBuffer(jenv, result->batches[i].data, (jlong) result->capacity);
+		if(buffer == NULL) {
+			icsneojava_freeListener(jenv, result);
+			return NULL;
+		}
+		result->batches[i].context = (*jenv)->NewGlobalRef(jenv, buffer);
+		(*jenv)->DeleteLocalRef(jenv, buffer);
+	}
+
+	if(!icsneobinding_startListener(result)) {
+		icsneojava_freeListener(jenv, result);
+		return NULL;
+	}
+	return result;
+}
+
+/*
+ * Stops the callbacks, delivers the messages already collected and frees the listener.
+ * Must not be called from within onMessages. Returns false, keeping the listener, if the callback could not be removed.
+ */
+static bool icsneojava_removeMessageListener(JNIEnv* jenv, icsneojava_listener_t* listener) {
+	if(listener == NULL)
+		return false;
+	if(!icsneobinding_removeListener(listener))
+		return false;
+	icsneojava_freeListener(jenv, listener);
+	return true;
+}
+%}
+
+/* The rest of the listener is implemented in icsneobinding.h, which icsneocsharp shares */
+%rename(icsneojava_getMessageListenerDropped) icsneobinding_getMessageListenerDropped;
+
+uint64_t icsneobinding_getMessageListenerDropped(icsneojava_listener_t* listener);
+
+%{
+/*
+ * Where the fields of neomessage_t are, for NeoMessageCursor.java to read a polled array in place.
+ * They depend on the platform's pointer size, so they are read from here rather than hardcoded.
+ */
+#include <stddef.h>
+
+#define ICSNEOJAVA_NEOMESSAGE_SIZE sizeof(neomessage_t)
+#define ICSNEOJAVA_NEOMESSAGE_STATUS_OFFSET offsetof(neomessage_t, status)
+#define ICSNEOJAVA_NEOMESSAGE_TIMESTAMP_OFFSET offsetof(neomessage_t, timestamp)
+#define ICSNEOJAVA_NEOMESSAGE_LENGTH_OFFSET offsetof(neomessage_t, length)
+#define ICSNEOJAVA_NEOMESSAGE_LENGTH_SIZE sizeof(size_t)
+#define ICSNEOJAVA_NEOMESSAGE_NETID_OFFSET offsetof(neomessage_t, netid)
+#define ICSNEOJAVA_NEOMESSAGE_TYPE_OFFSET offsetof(neomessage_t, type)
+#define ICSNEOJAVA_NEOMESSAGE_CAN_ARBID_OFFSET offsetof(neomessage_can_t, arbid)
+%}
+
+%constant int ICSNEOJAVA_NEOMESSAGE_SIZE = ICSNEOJAVA_NEOMESSAGE_SIZE;
+%constant int ICSNEOJAVA_NEOMESSAGE_STATUS_OFFSET = ICSNEOJAVA_NEOMESSAGE_STATUS_OFFSET;
+%constant int ICSNEOJAVA_NEOMESSAGE_TIMESTAMP_OFFSET = ICSNEOJAVA_NEOMESSAGE_TIMESTAMP_OFFSET;
+%constant int ICSNEOJAVA_NEOMESSAGE_LENGTH_OFFSET = ICSNEOJAVA_NEOMESSAGE_LENGTH_OFFSET;
+%constant int ICSNEOJAVA_NEOMESSAGE_LENGTH_SIZE = ICSNEOJAVA_NEOMESSAGE_LENGTH_SIZE;
+%constant int ICSNEOJAVA_NEOMESSAGE_NETID_OFFSET = ICSNEOJAVA_NEOMESSAGE_NETID_OFFSET;
+%constant int ICSNEOJAVA_NEOMESSAGE_TYPE_OFFSET = ICSNEOJAVA_NEOMESSAGE_TYPE_OFFSET;
+%constant int ICSNEOJAVA_NEOMESSAGE_CAN_ARBID_OFFSET = ICSNEOJAVA_NEOMESSAGE_CAN_ARBID_OFFSET;
+
+%typemap(jtype) jobject icsneojava_wrapMessages "java.nio.ByteBuffer"
+%typemap(jstype) jobject icsneojava_wrapMessages "java.nio.ByteBuffer"
+
+%inline %{
+/* Returns a direct ByteBuffer over the first count messages of a neomessage_t array, it is only valid while the array is */
+static jobject icsneojava_wrapMessages(JNIEnv* jenv, neomessage_t* messages, size_t count) {
+	if(messages == NULL)
+		return NULL;
+	return (*jenv)->NewDirectByteBuffer(jenv, messages, (jlong)(count * sizeof(neomessage_t)));
+}
+
+/*
+ * Copies the payload of messages[index] into destination at offset, returning its length, or -1 if it does not fit
+ * or index is not within the capacity messages the array holds
+ */
+static int icsneojava_copyMessageData(JNIEnv* jenv, const neomessage_t* messages, size_t capacity, size_t index, jbyteArray destination, int offset) {
+	const neomessage_t* message;
+	jsize length;
+
+	if(messages == NULL || index >= capacity || destination == NULL || offset < 0)
+		return -1;
+	message = &messages[index];
+	length = (jsize) message->length;
+	if((*jenv)->GetArrayLength(jenv, destination) - offset < length)
+		return -1;
+	if(length != 0)
+		(*jenv)->SetByteArrayRegion(jenv, destination, offset, length, (const jbyte*) message->data);
+	return length;
+}
+%}
+
+%{
+/*
+ * Where the fields of neodevice_t and neoevent_t are, for NeoDeviceCursor.java and NeoEventCursor.java
+ * to read found devices and events in place.
+ */
+#define ICSNEOJAVA_NEODEVICE_SIZE sizeof(neodevice_t)
+#define ICSNEOJAVA_NEODEVICE_HANDLE_OFFSET offsetof(neodevice_t, handle)
+#define ICSNEOJAVA_NEODEVICE_TYPE_OFFSET offsetof(neodevice_t, type)
+#define ICSNEOJAVA_NEODEVICE_SERIAL_OFFSET offsetof(neodevice_t, serial)
+#define ICSNEOJAVA_NEOEVENT_SIZE sizeof(neoevent_t)
+#define ICSNEOJAVA_NEOEVENT_TIMESTAMP_OFFSET offsetof(neoevent_t, timestamp)
+#define ICSNEOJAVA_NEOEVENT_TIMESTAMP_SIZE sizeof(time_t)
+#define ICSNEOJAVA_NEOEVENT_EVENTNUMBER_OFFSET offsetof(neoevent_t, eventNumber)
+#define ICSNEOJAVA_NEOEVENT_SEVERITY_OFFSET offsetof(neoevent_t, severity)
+#define ICSNEOJAVA_NEOEVENT_SERIAL_OFFSET offsetof(neoevent_t, serial)
+%}
+
+%constant int ICSNEOJAVA_NEODEVICE_SIZE = ICSNEOJAVA_NEODEVICE_SIZE;
+%constant int ICSNEOJAVA_NEODEVICE_HANDLE_OFFSET = ICSNEOJAVA_NEODEVICE_HANDLE_OFFSET;
+%constant int ICSNEOJAVA_NEODEVICE_TYPE_OFFSET = ICSNEOJAVA_NEODEVICE_TYPE_OFFSET;
+%constant int ICSNEOJAVA_NEODEVICE_SERIAL_OFFSET = ICSNEOJAVA_NEODEVICE_SERIAL_OFFSET;
+%constant int ICSNEOJAVA_NEOEVENT_SIZE = ICSNEOJAVA_NEOEVENT_SIZE;
+%constant int ICSNEOJAVA_NEOEVENT_TIMESTAMP_OFFSET = ICSNEOJAVA_NEOEVENT_TIMESTAMP_OFFSET;
+%constant int ICSNEOJAVA_NEOEVENT_TIMESTAMP_SIZE = ICSNEOJAVA_NEOEVENT_TIMESTAMP_SIZE;
+%constant int ICSNEOJAVA_NEOEVENT_EVENTNUMBER_OFFSET = ICSNEOJAVA_NEOEVENT_EVENTNUMBER_OFFSET;
+%constant int ICSNEOJAVA_NEOEVENT_SEVERITY_OFFSET = ICSNEOJAVA_NEOEVENT_SEVERITY_OFFSET;
+%constant int ICSNEOJAVA_NEOEVENT_SERIAL_OFFSET = ICSNEOJAVA_NEOEVENT_SERIAL_OFFSET;
+
+%typemap(jtype) jobject icsneojava_wrapDevices "java.nio.ByteBuffer"
+%typemap(jstype) jobject icsneojava_wrapDevices "java.nio.ByteBuffer"
+%typemap(jtype) jobject icsneojava_wrapEvents "java.nio.ByteBuffer"
+%typemap(jstype) jobject icsneojava_wrapEvents "java.nio.ByteBuffer"
+
+%inline %{
+/* Returns a direct ByteBuffer over the first count devices of a neodevice_t array, it is only valid while the array is */
+static jobject icsneojava_wrapDevices(JNIEnv* jenv, neodevice_t* devices, size_t count) {
+	if(devices == NULL)
+		return NULL;
+	return (*jenv)->NewDirectByteBuffer(jenv, devices, (jlong)(count * sizeof(neodevice_t)));
+}
+
+/* Returns a direct ByteBuffer over the first count events of a neoevent_t array, it is only valid while the array is */
+static jobject icsneojava_wrapEvents(JNIEnv* jenv, neoevent_t* events, size_t count) {
+	if(events == NULL)
+		return NULL;
+	return (*jenv)->NewDirectByteBuffer(jenv, events, (jlong)(count * sizeof(neoevent_t)));
+}
+
+/*
+ * icsneo_findAllDevices into an array of capacity devices, returning how many were found.
+ * The count is passed to icsneoc as a size_t here, rather than through an int[] it would write past.
+ */
+static int icsneojava_findAllDevices(neodevice_t* devices, int capacity) {
+	size_t count;
+
+	if(devices == NULL || capacity <= 0)
+		return 0;
+	count = (size_t) capacity;
+	icsneo_findAllDevices(devices, &count);
+	return (int) count;
+}
+
+/* icsneo_getEvents into an array of capacity events, returning how many there were, or -1 if it failed */
+static int icsneojava_getEvents(neoevent_t* events, int capacity) {
+	size_t count;
+
+	if(events == NULL || capacity < 0)
+		return -1;
+	count = (size_t) capacity;
+	if(!icsneo_getEvents(events, &count))
+		return -1;
+	return (int) count;
+}
+
+/* icsneo_getDeviceEvents into an array of capacity events, returning how many there were, or -1 if it failed */
+static int icsneojava_getDeviceEvents(const neodevice_t* device, neoevent_t* events, int capacity) {
+	size_t count;
+
+	if(events == NULL || capacity < 0)
+		return -1;
+	count = (size_t) capacity;
+	if(!icsneo_getDeviceEvents(device, events, &count))
+		return -1;
+	return (int) count;
+}
+
+/* The description of events[index], a string icsneoc keeps for as long as it is loaded */
+static const char* icsneojava_getEventDescription(const neoevent_t* events, size_t index) {
+	if(events == NULL)
+		return NULL;
+	return events[index].description;
+}
+%}
+
+%apply int *INOUT { int *items };
+
+/* The filters are implemented in icsneobinding.h, which icsneocsharp shares */
+%rename(icsneojava_newFilter) icsneobinding_newFilter;
+%rename(icsneojava_deleteFilter) icsneobinding_deleteFilter;
+%rename(icsneojava_clearFilter) icsneobinding_clearFilter;
+%rename(icsneojava_filterAddNetid) icsneobinding_filterAddNetid;
+%rename(icsneojava_filterAddType) icsneobinding_filterAddType;
+%rename(icsneojava_filterAddArbidRange) icsneobinding_filterAddArbidRange;
+%rename(icsneojava_getMessagesFiltered) icsneobinding_getMessagesFiltered;
+
+%inline %{
+typedef struct icsneojava_filter_t icsneojava_filter_t;
+%}
+
+icsneojava_filter_t* icsneobinding_newFilter(void);
+void icsneobinding_deleteFilter(icsneojava_filter_t* filter);
+void icsneobinding_clearFilter(icsneojava_filter_t* filter);
+bool icsneobinding_filterAddNetid(icsneojava_filter_t* filter, int netid);
+bool icsneobinding_filterAddType(icsneojava_filter_t* filter, int type);
+bool icsneobinding_filterAddArbidRange(icsneojava_filter_t* filter, uint32_t low, uint32_t high, uint32_t mask);
+bool icsneobinding_getMessagesFiltered(const neodevice_t* device, const icsneojava_filter_t* filter, neomessage_t* messages, int* items, uint64_t timeout);
+
+%inline %{
+/* Only passes messages which pass filter on to the poller's buffer. The filter is copied, change it and call again to update. NULL passes everything. */
+static bool icsneojava_setPollerFilter(icsneojava_poller_t* poller, const icsneojava_filter_t* filter) {
+	struct icsneojava_filter_t* copy = NULL;
+
+	if(poller == NULL)
+		return false;
+	if(filter != NULL && (copy = icsneobinding_duplicateFilter(filter)) == NULL)
+		return false;
+	icsneobinding_freeFilter(poller->filter);
+	poller->filter = copy;
+	return true;
+}
+
+/* Only passes messages which pass filter on to the listener. The filter is copied, change it and call again to update. NULL passes everything. */
+static bool icsneojava_setMessageListenerFilter(icsneojava_listener_t* listener, const icsneojava_filter_t* filter) {
+	struct icsneojava_filter_t* copy = NULL;
+	struct icsneojava_filter_t* previous;
+
+	if(listener == NULL)
+		return false;
+	if(filter != NULL && (copy = icsneobinding_duplicateFilter(filter)) == NULL)
+		return false;
+	icsneobinding_lock(&listener->mutex);
+	previous = listener->filter;
+	listener->filter = copy;
+	icsneobinding_unlock(&listener->mutex);
+	icsneobinding_freeFilter(previous);
+	return true;
+}
+%}
+%{
+/* Returns this thread's scratch array, see icsneobinding_scratch, cleared and with room for count frames, or NULL on failure */
+static neomessage_can_t* icsneojava_scratchMessages(size_t count) {
+	neomessage_can_t* messages = (neomessage_can_t*) icsneobinding_scratch(count * sizeof(neomessage_can_t));
+
+	if(messages != NULL)
+		memset(messages, 0, count * sizeof(neomessage_can_t));
+	return messages;
+}
+
+/*
+ * Transmits count CAN frames with a single icsneo_transmitMessages call, from parallel arrays rather than a
+ * neomessage_can_t for each. Frame i goes out on netids[i] with arbids[i], flags[i] and lengths[i] bytes of payload,
+ * the payloads following each other from the start of payloadArray, or of payload if payloadArray is NULL.
+ * flags[i] is made of MessageRecordReader.FLAG_EXTENDED, FLAG_REMOTE, FLAG_CANFD and FLAG_BRS.
+ *
+ * The arrays are pinned with GetPrimitiveArrayCritical, which avoids copying them, only while the frames are built
+ * and icsneo_transmitMessages copies the payloads. Nothing in that window allocates or calls back into the JVM.
+ */
+static bool icsneojava_transmitFrames(JNIEnv* jenv, const neodevice_t* device, jintArray netids, jintArray arbids, jintArray flags, jintArray lengths,
+	jbyteArray payloadArray, const uint8_t* payload, size_t payloadSize, int count) {
+	jintArray arrays[4];
+	jint* elements[4] = { NULL, NULL, NULL, NULL };
+	void* pinnedPayload = NULL;
+	neomessage_can_t* messages;
+	size_t offset = 0;
+	bool result = false;
+	int pinned;
+	int i;
+
+	if(count < 0)
+		return false;
+	if(count == 0)
+		return true;
+	arrays[0] = netids;
+	arrays[1] = arbids;
+	arrays[2] = flags;
+	arrays[3] = lengths;
+	for(i = 0; i < 4; i++) {
+		if(arrays[i] == NULL || (*jenv)->GetArrayLength(jenv, arrays[i]) < count)
+			return false;
+	}
+	if(payloadArray != NULL)
+		payloadSize = (size_t) (*jenv)->GetArrayLength(jenv, payloadArray);
+	messages = icsneojava_scratchMessages((size_t) count);
+	if(messages == NULL)
+		return false;
+
+	for(pinned = 0; pinned < 4; pinned++) {
+		elements[pinned] = (jint*) (*jenv)->GetPrimitiveArrayCritical(jenv, arrays[pinned], NULL);
+		if(elements[pinned] == NULL)
+			break;
+	}
+	if(pinned == 4 && payloadArray != NULL)
+		payload = (const uint8_t*) (pinnedPayload = (*jenv)->GetPrimitiveArrayCritical(jenv, payloadArray, NULL));
+
+	if(pinned == 4 && (payload != NULL || payloadSize == 0)) {
+		for(i = 0; i < count; i++) {
+			neomessage_can_t* message = &messages[i];
+			jint frameFlags = elements[2][i];
+			jint length = elements[3][i];
+			if(length < 0 || (size_t) length > payloadSize - offset)
+				break;
+			message->netid = (uint16_t) elements[0][i];
+			message->type = ICSNEO_NETWORK_TYPE_CAN;
+			message->arbid = (uint32_t) elements[1][i];
+			message->length = (size_t) length;
+			message->data = payload + offset;
+			message->status.extendedFrame = (frameFlags & ICSNEOJAVA_RECORD_FLAG_EXTENDED) != 0;
+			message->status.remoteFrame = (frameFlags & ICSNEOJAVA_RECORD_FLAG_REMOTE) != 0;
+			message->status.canfdFDF = (frameFlags & ICSNEOJAVA_RECORD_FLAG_CANFD) != 0;
+			message->status.canfdBRS = (frameFlags & ICSNEOJAVA_RECORD_FLAG_BRS) != 0;
+			offset += (size_t) length;
+		}
+		/* icsneo_transmitMessages copies the payloads, so the arrays can be released as soon as it returns */
+		if(i == count)
+			result = icsneo_transmitMessages(device, (const neomessage_t*) messages, (size_t) count);
+	}
+
+	/* Nothing was written, so JNI_ABORT releases without copying back */
+	if(pinnedPayload != NULL)
+		(*jenv)->ReleasePrimitiveArrayCritical(jenv, payloadArray, pinnedPayload, JNI_ABORT);
+	while(pinned-- > 0) {
+		if(elements[pinned] != NULL)
+			(*jenv)->ReleasePrimitiveArrayCritical(jenv, arrays[pinned], elements[pinned], JNI_ABORT);
+	}
+	return result;
+}
+%}
+
+%inline %{
+/* icsneojava_transmitFrames with the payloads in a byte[] */
+static bool icsneojava_transmitMessages(JNIEnv* jenv, const neodevice_t* device, jintArray netids, jintArray arbids, jintArray flags, jintArray lengths, jbyteArray payload, int count) {
+	if(payload == NULL)
+		return false;
+	return icsneojava_transmitFrames(jenv, device, netids, arbids, flags, lengths, payload, NULL, 0, count);
+}
+
+/*
+ * icsneojava_transmitFrames with the payloads in the first capacity bytes of a direct ByteBuffer, which needs no pinning.
+ * capacity is clamped to the size of the buffer.
+ */
+static bool icsneojava_transmitMessagesDirect(JNIEnv* jenv, const neodevice_t* device, jintArray netids, jintArray arbids, jintArray flags, jintArray lengths, jobject buffer, size_t capacity, int count) {
+	unsigned char* address = icsneojava_directBuffer(jenv, buffer, &capacity);
+	if(address == NULL)
+		return false;
+	return icsneojava_transmitFrames(jenv, device, netids, arbids, flags, lengths, NULL, address, capacity, count);
+}
+%}
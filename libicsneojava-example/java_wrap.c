@@ -781,6 +781,51 @@ static jdoubleArray SWIG_JavaArrayOutDouble (JNIEnv *jenv, double *result, jsize
 
 #include "icsneo/icsneoc.h"
 
+/* Gives the shared structs the names the Java proxies are generated from */
+#define icsneobinding_filter_t icsneojava_filter_t
+#define icsneobinding_listener_t icsneojava_listener_t
+#include "icsneobinding.h"
+
+
+/*
+ * Returns the copy of data which message now owns, see icsneobinding_setData, or NULL if data is NULL or empty.
+ * Throws OutOfMemoryError if the copy could not be allocated.
+ */
+static uint8_t* icsneojava_setData(JNIEnv* jenv, void* message, jbyteArray data) {
+	void* bytes = NULL;
+	jsize length = 0;
+	bool set;
+
+	if(message == NULL)
+		return NULL;
+	if(data != NULL) {
+		length = (*jenv)->GetArrayLength(jenv, data);
+		bytes = (*jenv)->GetPrimitiveArrayCritical(jenv, data, NULL);
+		if(bytes == NULL)
+			return NULL;
+	}
+	set = icsneobinding_setData(message, bytes, (size_t) length);
+	if(bytes != NULL)
+		(*jenv)->ReleasePrimitiveArrayCritical(jenv, data, bytes, JNI_ABORT);
+	if(!set) {
+		SWIG_JavaThrowException(jenv, SWIG_JavaOutOfMemoryError, "Unable to allocate the message data");
+		return NULL;
+	}
+	return (uint8_t*) ((neomessage_t*) message)->data;
+}
+
+SWIGINTERN void delete_neomessage_t(neomessage_t *self){
+		icsneobinding_freeData(self);
+		free(self);
+	}
+SWIGINTERN void delete_neomessage_can_t(neomessage_can_t *self){
+		icsneobinding_freeData(self);
+		free(self);
+	}
+SWIGINTERN void delete_neomessage_eth_t(neomessage_eth_t *self){
+		icsneobinding_freeData(self);
+		free(self);
+	}
 
 static neomessage_can_t* neomessage_can_t_cast(neomessage_t* msg) {
 	return (neomessage_can_t*) msg;
@@ -847,6 +892,611 @@ static void neomessage_t_array_setitem(neomessage_t *ary, int index, neomessage_
 }
 
 
+/*
+ * icsneojava_getMessagesPacked writes each message as a record into a direct ByteBuffer, so a whole
+ * batch crosses JNI at once. All fields are in native byte order, and each record starts 8 byte aligned.
+ *
+ * Offset  Size  Field
+ *      0     4  Record length, including the header and padding, add it to the offset to find the next record
+ *      4     2  Network ID
+ *      6     1  Network type
+ *      7     1  Flags, see ICSNEOJAVA_RECORD_FLAG_*
+ *      8     8  Timestamp, in nanoseconds since 1/1/2007 (unsigned)
+ *     16     4  Arbitration ID for CAN, otherwise 0
+ *     20     4  Payload length
+ *     24    16  The raw neomessage_statusbitfield_t
+ *     40     n  Payload
+ *
+ * MessageRecordReader.java reads this layout, keep the two in sync.
+ */
+#define ICSNEOJAVA_RECORD_HEADER_SIZE 40
+#define ICSNEOJAVA_RECORD_ALIGNMENT 8
+
+#define ICSNEOJAVA_RECORD_FLAG_TRANSMITTED 0x01
+#define ICSNEOJAVA_RECORD_FLAG_EXTENDED 0x02
+#define ICSNEOJAVA_RECORD_FLAG_REMOTE 0x04
+#define ICSNEOJAVA_RECORD_FLAG_CANFD 0x08
+#define ICSNEOJAVA_RECORD_FLAG_BRS 0x10
+#define ICSNEOJAVA_RECORD_FLAG_ERROR 0x20
+
+/*
+ * Holds the messages taken from the device by the last poll. Messages which did not fit in the
+ * caller's buffer stay here and are written first on the next call, so none are lost.
+ *
+ * icsneoc's payloads are only valid until the device is next polled, by anything, so the payloads of the
+ * messages left over are copied into the poller before the call returns.
+ */
+struct icsneojava_poller_t {
+	neomessage_t* messages;
+	size_t capacity;
+	size_t count; /* Messages returned by the last icsneo_getMessages call */
+	size_t next; /* The first of those which has not been written out yet */
+	struct icsneojava_filter_t* filter; /* Messages which do not pass are skipped, NULL passes everything */
+	uint8_t* payloads; /* The copies of the leftover payloads */
+	size_t payloadsCapacity;
+	bool kept; /* Whether the leftover payloads already point into payloads */
+};
+
+static size_t icsneojava_recordSize(size_t length) {
+	return (ICSNEOJAVA_RECORD_HEADER_SIZE + length + ICSNEOJAVA_RECORD_ALIGNMENT - 1) & ~(size_t)(ICSNEOJAVA_RECORD_ALIGNMENT - 1);
+}
+
+static void icsneojava_writeRecord(unsigned char* record, const neomessage_t* message, size_t size) {
+	uint32_t recordLength = (uint32_t) size;
+	uint32_t arbid = message->type == ICSNEO_NETWORK_TYPE_CAN ? ((const neomessage_can_t*) message)->arbid : 0;
+	uint32_t length = (uint32_t) message->length;
+	uint8_t flags = 0;
+
+	if(message->status.transmitMessage)
+		flags |= ICSNEOJAVA_RECORD_FLAG_TRANSMITTED;
+	if(message->status.extendedFrame)
+		flags |= ICSNEOJAVA_RECORD_FLAG_EXTENDED;
+	if(message->status.remoteFrame)
+		flags |= ICSNEOJAVA_RECORD_FLAG_REMOTE;
+	if(message->status.canfdFDF)
+		flags |= ICSNEOJAVA_RECORD_FLAG_CANFD;
+	if(message->status.canfdBRS)
+		flags |= ICSNEOJAVA_RECORD_FLAG_BRS;
+	if(message->status.globalError)
+		flags |= ICSNEOJAVA_RECORD_FLAG_ERROR;
+
+	memcpy(record, &recordLength, 4);
+	memcpy(record + 4, &message->netid, 2);
+	record[6] = message->type;
+	record[7] = flags;
+	memcpy(record + 8, &message->timestamp, 8);
+	memcpy(record + 16, &arbid, 4);
+	memcpy(record + 20, &length, 4);
+	memcpy(record + 24, &message->status, 16);
+	if(message->length != 0)
+		memcpy(record + ICSNEOJAVA_RECORD_HEADER_SIZE, message->data, message->length);
+	memset(record + ICSNEOJAVA_RECORD_HEADER_SIZE + message->length, 0, size - ICSNEOJAVA_RECORD_HEADER_SIZE - message->length);
+}
+
+
+/* Copies the payloads of the messages not written out yet into the poller, so they outlive the next poll of the device */
+static bool icsneojava_keepPayloads(struct icsneojava_poller_t* poller) {
+	size_t total = 0;
+	size_t i;
+
+	if(poller->kept)
+		return true;
+	for(i = poller->next; i < poller->count; i++)
+		total += poller->messages[i].length;
+	if(total > poller->payloadsCapacity) {
+		uint8_t* payloads = (uint8_t*) realloc(poller->payloads, total);
+		if(payloads == NULL)
+			return false;
+		poller->payloads = payloads;
+		poller->payloadsCapacity = total;
+	}
+
+	total = 0;
+	for(i = poller->next; i < poller->count; i++) {
+		neomessage_t* message = &poller->messages[i];
+		if(message->length == 0)
+			continue;
+		memcpy(poller->payloads + total, message->data, message->length);
+		message->data = poller->payloads + total;
+		total += message->length;
+	}
+	poller->kept = true;
+	return true;
+}
+
+/*
+ * The address of a direct ByteBuffer, with capacity clamped to the buffer's size so nothing is written past its end.
+ * Throws and returns NULL if the buffer is not direct.
+ */
+static unsigned char* icsneojava_directBuffer(JNIEnv* jenv, jobject buffer, size_t* capacity) {
+	unsigned char* address = buffer == NULL ? NULL : (unsigned char*) (*jenv)->GetDirectBufferAddress(jenv, buffer);
+	jlong size = buffer == NULL ? -1 : (*jenv)->GetDirectBufferCapacity(jenv, buffer);
+	if(address == NULL || size < 0) {
+		SWIG_JavaThrowException(jenv, SWIG_JavaRuntimeException, "Unable to get address of a java.nio.ByteBuffer direct byte buffer. Buffer must be a direct buffer and not a non-direct buffer.");
+		return NULL;
+	}
+	if(*capacity > (size_t) size)
+		*capacity = (size_t) size;
+	return address;
+}
+
+
+typedef struct icsneojava_poller_t icsneojava_poller_t;
+
+/* Creates a poller which takes up to maxMessages from the device at a time */
+static icsneojava_poller_t* icsneojava_newPoller(size_t maxMessages) {
+	icsneojava_poller_t* poller = (icsneojava_poller_t*) calloc(1, sizeof(icsneojava_poller_t));
+	if(poller == NULL)
+		return NULL;
+	poller->messages = (neomessage_t*) calloc(maxMessages, sizeof(neomessage_t));
+	if(poller->messages == NULL) {
+		free(poller);
+		return NULL;
+	}
+	poller->capacity = maxMessages;
+	return poller;
+}
+
+static void icsneojava_deletePoller(icsneojava_poller_t* poller) {
+	if(poller == NULL)
+		return;
+	icsneobinding_freeFilter(poller->filter);
+	free(poller->messages);
+	free(poller->payloads);
+	free(poller);
+}
+
+/* Drops the messages the poller is holding, such as before it is used for another device, returning how many there were */
+static int icsneojava_clearPoller(icsneojava_poller_t* poller) {
+	int dropped;
+	if(poller == NULL)
+		return 0;
+	dropped = (int) (poller->count - poller->next);
+	poller->count = 0;
+	poller->next = 0;
+	return dropped;
+}
+
+/*
+ * Writes as many messages as fit into the direct ByteBuffer records as packed records, returning how many were written
+ * or -1 on failure. capacity is clamped to the size of the buffer.
+ * The device is only polled once the messages from the previous poll have all been written out, and the messages held
+ * until then are those of the device last polled, call icsneojava_clearPoller before using the poller for another.
+ * A message too large to ever fit in the buffer is skipped, so the buffer should hold at least one full size frame.
+ * Messages which do not pass the filter set with icsneojava_setPollerFilter are skipped too, so 0 may be returned
+ * while the device still has messages.
+ */
+static int icsneojava_getMessagesPacked(JNIEnv* jenv, icsneojava_poller_t* poller, const neodevice_t* device, jobject records, size_t capacity, uint64_t timeout) {
+	size_t used = 0;
+	int written = 0;
+	unsigned char* buffer;
+
+	if(poller == NULL)
+		return -1;
+	buffer = icsneojava_directBuffer(jenv, records, &capacity);
+	if(buffer == NULL)
+		return -1;
+
+	if(poller->next == poller->count) {
+		poller->next = 0;
+		poller->count = poller->capacity;
+		poller->kept = false;
+		if(!icsneo_getMessages(device, poller->messages, &poller->count, timeout)) {
+			poller->count = 0;
+			return -1;
+		}
+	}
+
+	while(poller->next < poller->count) {
+		const neomessage_t* message = &poller->messages[poller->next];
+		size_t size = icsneojava_recordSize(message->length);
+		if(size > capacity || !icsneobinding_filterMatches(poller->filter, message)) {
+			poller->next++;
+			continue;
+		}
+		if(used + size > capacity)
+			break;
+		icsneojava_writeRecord(buffer + used, message, size);
+		used += size;
+		written++;
+		poller->next++;
+	}
+	if(poller->next < poller->count && !icsneojava_keepPayloads(poller)) {
+		/* The leftovers cannot be kept safely, drop them rather than read freed payloads later */
+		poller->next = poller->count;
+	}
+	return written;
+}
+
+
+/*
+ * Message listeners, see icsneobinding.h, deliver received messages to Java as the packed records described above.
+ * The delivery thread is attached to the JVM once when it starts, and hands each batch to the Java listener's
+ * onMessages as a direct ByteBuffer over the batch.
+ */
+typedef struct {
+	JavaVM* vm;
+	JNIEnv* env; /* The delivery thread's, once it is attached */
+	jobject listener;
+	jmethodID onMessages;
+} icsneojava_listenerContext_t;
+
+static bool icsneojava_storeRecord(struct icsneojava_listener_t* listener, icsneobinding_batch_t* batch, const neomessage_t* message) {
+	size_t size = icsneojava_recordSize(message->length);
+	if(batch->used + size > listener->capacity)
+		return false;
+	icsneojava_writeRecord(batch->data + batch->used, message, size);
+	batch->used += size;
+	return true;
+}
+
+static void icsneojava_deliverRecords(struct icsneojava_listener_t* listener, icsneobinding_batch_t* batch) {
+	icsneojava_listenerContext_t* context = (icsneojava_listenerContext_t*) listener->context;
+	JNIEnv* env = context->env;
+
+	(*env)->CallVoidMethod(env, context->listener, context->onMessages, (jobject) batch->context, (jint) batch->count);
+	if((*env)->ExceptionCheck(env)) {
+		(*env)->ExceptionDescribe(env);
+		(*env)->ExceptionClear(env);
+	}
+}
+
+static bool icsneojava_attachDelivery(struct icsneojava_listener_t* listener) {
+	icsneojava_listenerContext_t* context = (icsneojava_listenerContext_t*) listener->context;
+	return (*context->vm)->AttachCurrentThreadAsDaemon(context->vm, (void**) &context->env, NULL) == JNI_OK;
+}
+
+static void icsneojava_detachDelivery(struct icsneojava_listener_t* listener) {
+	icsneojava_listenerContext_t* context = (icsneojava_listenerContext_t*) listener->context;
+	(*context->vm)->DetachCurrentThread(context->vm);
+}
+
+static const icsneobinding_listenerOps_t icsneojava_listenerOps = {
+	icsneojava_storeRecord, icsneojava_deliverRecords, icsneojava_attachDelivery, icsneojava_detachDelivery
+};
+
+/* Stops the delivery thread, once it has delivered what is left, and frees everything the listener holds */
+static void icsneojava_freeListener(JNIEnv* jenv, struct icsneojava_listener_t* listener) {
+	icsneojava_listenerContext_t* context = (icsneojava_listenerContext_t*) listener->context;
+	int i;
+
+	icsneobinding_stopListener(listener);
+	for(i = 0; i < 2; i++) {
+		if(listener->batches[i].context != NULL)
+			(*jenv)->DeleteGlobalRef(jenv, (jobject) listener->batches[i].context);
+	}
+	if(context->listener != NULL)
+		(*jenv)->DeleteGlobalRef(jenv, context->listener);
+	free(context);
+	icsneobinding_freeListener(listener);
+}
+
+
+typedef struct icsneojava_listener_t icsneojava_listener_t;
+
+/*
+ * Calls listener.onMessages(ByteBuffer buffer, int records) with batches of received messages, see MessageListener.java.
+ * Returns NULL on failure, including when all ICSNEOBINDING_MAX_LISTENERS listeners are in use.
+ */
+static icsneojava_listener_t* icsneojava_addMessageListener(JNIEnv* jenv, const neodevice_t* device, jobject listener, size_t batchSize, uint64_t maxDelayMicroseconds) {
+	icsneojava_listenerContext_t* context;
+	icsneojava_listener_t* result;
+	jclass listenerClass;
+	int i;
+
+	if(device == NULL || listener == NULL || batchSize == 0)
+		return NULL;
+
+	context = (icsneojava_listenerContext_t*) calloc(1, sizeof(icsneojava_listenerContext_t));
+	if(context == NULL)
+		return NULL;
+	result = icsneobinding_newListener(device, &icsneojava_listenerOps, context, batchSize, batchSize * icsneojava_recordSize(64), maxDelayMicroseconds, NULL);
+	if(result == NULL) {
+		free(context);
+		return NULL;
+	}
+
+	listenerClass = (*jenv)->GetObjectClass(jenv, listener);
+	context->onMessages = (*jenv)->GetMethodID(jenv, listenerClass, "onMessages", "(Ljava/nio/ByteBuffer;I)V");
+	(*jenv)->DeleteLocalRef(jenv, listenerClass);
+	if((*jenv)->GetJavaVM(jenv, &context->vm) != JNI_OK || context->onMessages == NULL) {
+		icsneojava_freeListener(jenv, result);
+		return NULL;
+	}
+	context->listener = (*jenv)->NewGlobalRef(jenv, listener);
+
+	for(i = 0; i < 2; i++) {
+		jobject buffer = (*jenv)->NewDirectByteBuffer(jenv, result->batches[i].data, (jlong) result->capacity);
+		if(buffer == NULL) {
+			icsneojava_freeListener(jenv, result);
+			return NULL;
+		}
+		result->batches[i].context = (*jenv)->NewGlobalRef(jenv, buffer);
+		(*jenv)->DeleteLocalRef(jenv, buffer);
+	}
+
+	if(!icsneobinding_startListener(result)) {
+		icsneojava_freeListener(jenv, result);
+		return NULL;
+	}
+	return result;
+}
+
+/*
+ * Stops the callbacks, delivers the messages already collected and frees the listener.
+ * Must not be called from within onMessages. Returns false, keeping the listener, if the callback could not be removed.
+ */
+static bool icsneojava_removeMessageListener(JNIEnv* jenv, icsneojava_listener_t* listener) {
+	if(listener == NULL)
+		return false;
+	if(!icsneobinding_removeListener(listener))
+		return false;
+	icsneojava_freeListener(jenv, listener);
+	return true;
+}
+
+
+/*
+ * Where the fields of neomessage_t are, for NeoMessageCursor.java to read a polled array in place.
+ * They depend on the platform's pointer size, so they are read from here rather than hardcoded.
+ */
+#include <stddef.h>
+
+#define ICSNEOJAVA_NEOMESSAGE_SIZE sizeof(neomessage_t)
+#define ICSNEOJAVA_NEOMESSAGE_STATUS_OFFSET offsetof(neomessage_t, status)
+#define ICSNEOJAVA_NEOMESSAGE_TIMESTAMP_OFFSET offsetof(neomessage_t, timestamp)
+#define ICSNEOJAVA_NEOMESSAGE_LENGTH_OFFSET offsetof(neomessage_t, length)
+#define ICSNEOJAVA_NEOMESSAGE_LENGTH_SIZE sizeof(size_t)
+#define ICSNEOJAVA_NEOMESSAGE_NETID_OFFSET offsetof(neomessage_t, netid)
+#define ICSNEOJAVA_NEOMESSAGE_TYPE_OFFSET offsetof(neomessage_t, type)
+#define ICSNEOJAVA_NEOMESSAGE_CAN_ARBID_OFFSET offsetof(neomessage_can_t, arbid)
+
+
+/* Returns a direct ByteBuffer over the first count messages of a neomessage_t array, it is only valid while the array is */
+static jobject icsneojava_wrapMessages(JNIEnv* jenv, neomessage_t* messages, size_t count) {
+	if(messages == NULL)
+		return NULL;
+	return (*jenv)->NewDirectByteBuffer(jenv, messages, (jlong)(count * sizeof(neomessage_t)));
+}
+
+/*
+ * Copies the payload of messages[index] into destination at offset, returning its length, or -1 if it does not fit
+ * or index is not within the capacity messages the array holds
+ */
+static int icsneojava_copyMessageData(JNIEnv* jenv, const neomessage_t* messages, size_t capacity, size_t index, jbyteArray destination, int offset) {
+	const neomessage_t* message;
+	jsize length;
+
+	if(messages == NULL || index >= capacity || destination == NULL || offset < 0)
+		return -1;
+	message = &messages[index];
+	length = (jsize) message->length;
+	if((*jenv)->GetArrayLength(jenv, destination) - offset < length)
+		return -1;
+	if(length != 0)
+		(*jenv)->SetByteArrayRegion(jenv, destination, offset, length, (const jbyte*) message->data);
+	return length;
+}
+
+
+/*
+ * Where the fields of neodevice_t and neoevent_t are, for NeoDeviceCursor.java and NeoEventCursor.java
+ * to read found devices and events in place.
+ */
+#define ICSNEOJAVA_NEODEVICE_SIZE sizeof(neodevice_t)
+#define ICSNEOJAVA_NEODEVICE_HANDLE_OFFSET offsetof(neodevice_t, handle)
+#define ICSNEOJAVA_NEODEVICE_TYPE_OFFSET offsetof(neodevice_t, type)
+#define ICSNEOJAVA_NEODEVICE_SERIAL_OFFSET offsetof(neodevice_t, serial)
+#define ICSNEOJAVA_NEOEVENT_SIZE sizeof(neoevent_t)
+#define ICSNEOJAVA_NEOEVENT_TIMESTAMP_OFFSET offsetof(neoevent_t, timestamp)
+#define ICSNEOJAVA_NEOEVENT_TIMESTAMP_SIZE sizeof(time_t)
+#define ICSNEOJAVA_NEOEVENT_EVENTNUMBER_OFFSET offsetof(neoevent_t, eventNumber)
+#define ICSNEOJAVA_NEOEVENT_SEVERITY_OFFSET offsetof(neoevent_t, severity)
+#define ICSNEOJAVA_NEOEVENT_SERIAL_OFFSET offsetof(neoevent_t, serial)
+
+
+/* Returns a direct ByteBuffer over the first count devices of a neodevice_t array, it is only valid while the array is */
+static jobject icsneojava_wrapDevices(JNIEnv* jenv, neodevice_t* devices, size_t count) {
+	if(devices == NULL)
+		return NULL;
+	return (*jenv)->NewDirectByteBuffer(jenv, devices, (jlong)(count * sizeof(neodevice_t)));
+}
+
+/* Returns a direct ByteBuffer over the first count events of a neoevent_t array, it is only valid while the array is */
+static jobject icsneojava_wrapEvents(JNIEnv* jenv, neoevent_t* events, size_t count) {
+	if(events == NULL)
+		return NULL;
+	return (*jenv)->NewDirectByteBuffer(jenv, events, (jlong)(count * sizeof(neoevent_t)));
+}
+
+/*
+ * icsneo_findAllDevices into an array of capacity devices, returning how many were found.
+ * The count is passed to icsneoc as a size_t here, rather than through an int[] it would write past.
+ */
+static int icsneojava_findAllDevices(neodevice_t* devices, int capacity) {
+	size_t count;
+
+	if(devices == NULL || capacity <= 0)
+		return 0;
+	count = (size_t) capacity;
+	icsneo_findAllDevices(devices, &count);
+	return (int) count;
+}
+
+/* icsneo_getEvents into an array of capacity events, returning how many there were, or -1 if it failed */
+static int icsneojava_getEvents(neoevent_t* events, int capacity) {
+	size_t count;
+
+	if(events == NULL || capacity < 0)
+		return -1;
+	count = (size_t) capacity;
+	if(!icsneo_getEvents(events, &count))
+		return -1;
+	return (int) count;
+}
+
+/* icsneo_getDeviceEvents into an array of capacity events, returning how many there were, or -1 if it failed */
+static int icsneojava_getDeviceEvents(const neodevice_t* device, neoevent_t* events, int capacity) {
+	size_t count;
+
+	if(events == NULL || capacity < 0)
+		return -1;
+	count = (size_t) capacity;
+	if(!icsneo_getDeviceEvents(device, events, &count))
+		return -1;
+	return (int) count;
+}
+
+/* The description of events[index], a string icsneoc keeps for as long as it is loaded */
+static const char* icsneojava_getEventDescription(const neoevent_t* events, size_t index) {
+	if(events == NULL)
+		return NULL;
+	return events[index].description;
+}
+
+
+typedef struct icsneojava_filter_t icsneojava_filter_t;
+
+
+/* Only passes messages which pass filter on to the poller's buffer. The filter is copied, change it and call again to update. NULL passes everything. */
+static bool icsneojava_setPollerFilter(icsneojava_poller_t* poller, const icsneojava_filter_t* filter) {
+	struct icsneojava_filter_t* copy = NULL;
+
+	if(poller == NULL)
+		return false;
+	if(filter != NULL && (copy = icsneobinding_duplicateFilter(filter)) == NULL)
+		return false;
+	icsneobinding_freeFilter(poller->filter);
+	poller->filter = copy;
+	return true;
+}
+
+/* Only passes messages which pass filter on to the listener. The filter is copied, change it and call again to update. NULL passes everything. */
+static bool icsneojava_setMessageListenerFilter(icsneojava_listener_t* listener, const icsneojava_filter_t* filter) {
+	struct icsneojava_filter_t* copy = NULL;
+	struct icsneojava_filter_t* previous;
+
+	if(listener == NULL)
+		return false;
+	if(filter != NULL && (copy = icsneobinding_duplicateFilter(filter)) == NULL)
+		return false;
+	icsneobinding_lock(&listener->mutex);
+	previous = listener->filter;
+	listener->filter = copy;
+	icsneobinding_unlock(&listener->mutex);
+	icsneobinding_freeFilter(previous);
+	return true;
+}
+
+
+/* Returns this thread's scratch array, see icsneobinding_scratch, cleared and with room for count frames, or NULL on failure */
+static neomessage_can_t* icsneojava_scratchMessages(size_t count) {
+	neomessage_can_t* messages = (neomessage_can_t*) icsneobinding_scratch(count * sizeof(neomessage_can_t));
+
+	if(messages != NULL)
+		memset(messages, 0, count * sizeof(neomessage_can_t));
+	return messages;
+}
+
+/*
+ * Transmits count CAN frames with a single icsneo_transmitMessages call, from parallel arrays rather than a
+ * neomessage_can_t for each. Frame i goes out on netids[i] with arbids[i], flags[i] and lengths[i] bytes of payload,
+ * the payloads following each other from the start of payloadArray, or of payload if payloadArray is NULL.
+ * flags[i] is made of MessageRecordReader.FLAG_EXTENDED, FLAG_REMOTE, FLAG_CANFD and FLAG_BRS.
+ *
+ * The arrays are pinned with GetPrimitiveArrayCritical, which avoids copying them, only while the frames are built
+ * and icsneo_transmitMessages copies the payloads. Nothing in that window allocates or calls back into the JVM.
+ */
+static bool icsneojava_transmitFrames(JNIEnv* jenv, const neodevice_t* device, jintArray netids, jintArray arbids, jintArray flags, jintArray lengths,
+	jbyteArray payloadArray, const uint8_t* payload, size_t payloadSize, int count) {
+	jintArray arrays[4];
+	jint* elements[4] = { NULL, NULL, NULL, NULL };
+	void* pinnedPayload = NULL;
+	neomessage_can_t* messages;
+	size_t offset = 0;
+	bool result = false;
+	int pinned;
+	int i;
+
+	if(count < 0)
+		return false;
+	if(count == 0)
+		return true;
+	arrays[0] = netids;
+	arrays[1] = arbids;
+	arrays[2] = flags;
+	arrays[3] = lengths;
+	for(i = 0; i < 4; i++) {
+		if(arrays[i] == NULL || (*jenv)->GetArrayLength(jenv, arrays[i]) < count)
+			return false;
+	}
+	if(payloadArray != NULL)
+		payloadSize = (size_t) (*jenv)->GetArrayLength(jenv, payloadArray);
+	messages = icsneojava_scratchMessages((size_t) count);
+	if(messages == NULL)
+		return false;
+
+	for(pinned = 0; pinned < 4; pinned++) {
+		elements[pinned] = (jint*) (*jenv)->GetPrimitiveArrayCritical(jenv, arrays[pinned], NULL);
+		if(elements[pinned] == NULL)
+			break;
+	}
+	if(pinned == 4 && payloadArray != NULL)
+		payload = (const uint8_t*) (pinnedPayload = (*jenv)->GetPrimitiveArrayCritical(jenv, payloadArray, NULL));
+
+	if(pinned == 4 && (payload != NULL || payloadSize == 0)) {
+		for(i = 0; i < count; i++) {
+			neomessage_can_t* message = &messages[i];
+			jint frameFlags = elements[2][i];
+			jint length = elements[3][i];
+			if(length < 0 || (size_t) length > payloadSize - offset)
+				break;
+			message->netid = (uint16_t) elements[0][i];
+			message->type = ICSNEO_NETWORK_TYPE_CAN;
+			message->arbid = (uint32_t) elements[1][i];
+			message->length = (size_t) length;
+			message->data = payload + offset;
+			message->status.extendedFrame = (frameFlags & ICSNEOJAVA_RECORD_FLAG_EXTENDED) != 0;
+			message->status.remoteFrame = (frameFlags & ICSNEOJAVA_RECORD_FLAG_REMOTE) != 0;
+			message->status.canfdFDF = (frameFlags & ICSNEOJAVA_RECORD_FLAG_CANFD) != 0;
+			message->status.canfdBRS = (frameFlags & ICSNEOJAVA_RECORD_FLAG_BRS) != 0;
+			offset += (size_t) length;
+		}
+		/* icsneo_transmitMessages copies the payloads, so the arrays can be released as soon as it returns */
+		if(i == count)
+			result = icsneo_transmitMessages(device, (const neomessage_t*) messages, (size_t) count);
+	}
+
+	/* Nothing was written, so JNI_ABORT releases without copying back */
+	if(pinnedPayload != NULL)
+		(*jenv)->ReleasePrimitiveArrayCritical(jenv, payloadArray, pinnedPayload, JNI_ABORT);
+	while(pinned-- > 0) {
+		if(elements[pinned] != NULL)
+			(*jenv)->ReleasePrimitiveArrayCritical(jenv, arrays[pinned], elements[pinned], JNI_ABORT);
+	}
+	return result;
+}
+
+
+/* icsneojava_transmitFrames with the payloads in a byte[] */
+static bool icsneojava_transmitMessages(JNIEnv* jenv, const neodevice_t* device, jintArray netids, jintArray arbids, jintArray flags, jintArray lengths, jbyteArray payload, int count) {
+	if(payload == NULL)
+		return false;
+	return icsneojava_transmitFrames(jenv, device, netids, arbids, flags, lengths, payload, NULL, 0, count);
+}
+
+/*
+ * icsneojava_transmitFrames with the payloads in the first capacity bytes of a direct ByteBuffer, which needs no pinning.
+ * capacity is clamped to the size of the buffer.
+ */
+static bool icsneojava_transmitMessagesDirect(JNIEnv* jenv, const neodevice_t* device, jintArray netids, jintArray arbids, jintArray flags, jintArray lengths, jobject buffer, size_t capacity, int count) {
+	unsigned char* address = icsneojava_directBuffer(jenv, buffer, &capacity);
+	if(address == NULL)
+		return false;
+	return icsneojava_transmitFrames(jenv, device, netids, arbids, flags, lengths, NULL, address, capacity, count);
+}
+
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -1159,7 +1809,7 @@ SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneo_1isMessagePollingEnabled(J
 }
 
 
-SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneo_1getMessages(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jlong jarg2, jobject jarg2_, jintArray jarg3, jobject jarg4) {
+SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneo_1getMessages(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jlong jarg2, jobject jarg2_, jintArray jarg3, jlong jarg4) {
   jboolean jresult = 0 ;
   neodevice_t *arg1 = (neodevice_t *) 0 ;
   neomessage_t *arg2 = (neomessage_t *) 0 ;
@@ -1184,32 +1834,7 @@ SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneo_1getMessages(JNIEnv *jenv,
     }
     arg3 = (size_t *) (*jenv)->GetIntArrayElements(jenv, jarg3, 0); 
   }
-  {
-    jclass clazz;
-    jmethodID mid;
-    jbyteArray ba;
-    jbyte* bae;
-    jsize sz;
-    int i;
-    
-    if (!jarg4) {
-      SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "BigInteger null");
-      return 0;
-    }
-    clazz = (*jenv)->GetObjectClass(jenv, jarg4);
-    mid = (*jenv)->GetMethodID(jenv, clazz, "toByteArray", "()[B");
-    ba = (jbyteArray)(*jenv)->CallObjectMethod(jenv, jarg4, mid);
-    bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    sz = (*jenv)->GetArrayLength(jenv, ba);
-    arg4 = 0;
-    if (sz > 0) {
-      arg4 = (uint64_t)(signed char)bae[0];
-      for(i=1; i<sz; i++) {
-        arg4 = (arg4 << 8) | (uint64_t)(unsigned char)bae[i];
-      }
-    }
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-  }
+  arg4 = (uint64_t)jarg4; 
   result = (bool)icsneo_getMessages((neodevice_t const *)arg1,arg2,arg3,arg4);
   jresult = (jboolean)result; 
   {
@@ -3682,7 +4307,7 @@ SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_neomessage_1t_1status_1get(JNIEnv *j
 }
 
 
-SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1t_1timestamp_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jobject jarg2) {
+SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1t_1timestamp_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jlong jarg2) {
   neomessage_t *arg1 = (neomessage_t *) 0 ;
   uint64_t arg2 ;
   
@@ -3690,38 +4315,13 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1t_1timestamp_1set(JNIEnv
   (void)jcls;
   (void)jarg1_;
   arg1 = *(neomessage_t **)&jarg1; 
-  {
-    jclass clazz;
-    jmethodID mid;
-    jbyteArray ba;
-    jbyte* bae;
-    jsize sz;
-    int i;
-    
-    if (!jarg2) {
-      SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "BigInteger null");
-      return ;
-    }
-    clazz = (*jenv)->GetObjectClass(jenv, jarg2);
-    mid = (*jenv)->GetMethodID(jenv, clazz, "toByteArray", "()[B");
-    ba = (jbyteArray)(*jenv)->CallObjectMethod(jenv, jarg2, mid);
-    bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    sz = (*jenv)->GetArrayLength(jenv, ba);
-    arg2 = 0;
-    if (sz > 0) {
-      arg2 = (uint64_t)(signed char)bae[0];
-      for(i=1; i<sz; i++) {
-        arg2 = (arg2 << 8) | (uint64_t)(unsigned char)bae[i];
-      }
-    }
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-  }
+  arg2 = (uint64_t)jarg2; 
   if (arg1) (arg1)->timestamp = arg2;
 }
 
 
-SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1t_1timestamp_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
-  jobject jresult = 0 ;
+SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_neomessage_1t_1timestamp_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
+  jlong jresult = 0 ;
   neomessage_t *arg1 = (neomessage_t *) 0 ;
   uint64_t result;
   
@@ -3730,29 +4330,12 @@ SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1t_1timestamp_1get(JNIE
   (void)jarg1_;
   arg1 = *(neomessage_t **)&jarg1; 
   result = (uint64_t) ((arg1)->timestamp);
-  {
-    jbyteArray ba = (*jenv)->NewByteArray(jenv, 9);
-    jbyte* bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    jclass clazz = (*jenv)->FindClass(jenv, "java/math/BigInteger");
-    jmethodID mid = (*jenv)->GetMethodID(jenv, clazz, "<init>", "([B)V");
-    jobject bigint;
-    int i;
-    
-    bae[0] = 0;
-    for(i=1; i<9; i++ ) {
-      bae[i] = (jbyte)(result>>8*(8-i));
-    }
-    
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-    bigint = (*jenv)->NewObject(jenv, clazz, mid, ba);
-    (*jenv)->DeleteLocalRef(jenv, ba);
-    jresult = bigint;
-  }
+  jresult = (jlong)result; 
   return jresult;
 }
 
 
-SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1t_1timestampReserved_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jobject jarg2) {
+SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1t_1timestampReserved_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jlong jarg2) {
   neomessage_t *arg1 = (neomessage_t *) 0 ;
   uint64_t arg2 ;
   
@@ -3760,38 +4343,13 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1t_1timestampReserved_1set
   (void)jcls;
   (void)jarg1_;
   arg1 = *(neomessage_t **)&jarg1; 
-  {
-    jclass clazz;
-    jmethodID mid;
-    jbyteArray ba;
-    jbyte* bae;
-    jsize sz;
-    int i;
-    
-    if (!jarg2) {
-      SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "BigInteger null");
-      return ;
-    }
-    clazz = (*jenv)->GetObjectClass(jenv, jarg2);
-    mid = (*jenv)->GetMethodID(jenv, clazz, "toByteArray", "()[B");
-    ba = (jbyteArray)(*jenv)->CallObjectMethod(jenv, jarg2, mid);
-    bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    sz = (*jenv)->GetArrayLength(jenv, ba);
-    arg2 = 0;
-    if (sz > 0) {
-      arg2 = (uint64_t)(signed char)bae[0];
-      for(i=1; i<sz; i++) {
-        arg2 = (arg2 << 8) | (uint64_t)(unsigned char)bae[i];
-      }
-    }
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-  }
+  arg2 = (uint64_t)jarg2; 
   if (arg1) (arg1)->timestampReserved = arg2;
 }
 
 
-SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1t_1timestampReserved_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
-  jobject jresult = 0 ;
+SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_neomessage_1t_1timestampReserved_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
+  jlong jresult = 0 ;
   neomessage_t *arg1 = (neomessage_t *) 0 ;
   uint64_t result;
   
@@ -3800,24 +4358,7 @@ SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1t_1timestampReserved_1
   (void)jarg1_;
   arg1 = *(neomessage_t **)&jarg1; 
   result = (uint64_t) ((arg1)->timestampReserved);
-  {
-    jbyteArray ba = (*jenv)->NewByteArray(jenv, 9);
-    jbyte* bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    jclass clazz = (*jenv)->FindClass(jenv, "java/math/BigInteger");
-    jmethodID mid = (*jenv)->GetMethodID(jenv, clazz, "<init>", "([B)V");
-    jobject bigint;
-    int i;
-    
-    bae[0] = 0;
-    for(i=1; i<9; i++ ) {
-      bae[i] = (jbyte)(result>>8*(8-i));
-    }
-    
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-    bigint = (*jenv)->NewObject(jenv, clazz, mid, ba);
-    (*jenv)->DeleteLocalRef(jenv, ba);
-    jresult = bigint;
-  }
+  jresult = (jlong)result; 
   return jresult;
 }
 
@@ -3831,8 +4372,9 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1t_1data_1set(JNIEnv *jenv
   (void)jarg1_;
   arg1 = *(neomessage_t **)&jarg1; 
   
-  bool isCopy;
-  arg2 = (*jenv)->GetByteArrayElements(jenv, jarg2, &isCopy);
+  arg2 = icsneojava_setData(jenv, arg1, jarg2);
+  if(arg2 == NULL && (*jenv)->ExceptionCheck(jenv))
+    return ;
   
   if (arg1) (arg1)->data = (uint8_t const *)arg2;
 }
@@ -4036,7 +4578,7 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_delete_1neomessage_1t(JNIEnv *jenv, j
   (void)jenv;
   (void)jcls;
   arg1 = *(neomessage_t **)&jarg1; 
-  free((char *) arg1);
+  delete_neomessage_t(arg1);
 }
 
 
@@ -4069,7 +4611,7 @@ SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1status_1get(JNIE
 }
 
 
-SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestamp_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jobject jarg2) {
+SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestamp_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jlong jarg2) {
   neomessage_can_t *arg1 = (neomessage_can_t *) 0 ;
   uint64_t arg2 ;
   
@@ -4077,38 +4619,13 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestamp_1set(JN
   (void)jcls;
   (void)jarg1_;
   arg1 = *(neomessage_can_t **)&jarg1; 
-  {
-    jclass clazz;
-    jmethodID mid;
-    jbyteArray ba;
-    jbyte* bae;
-    jsize sz;
-    int i;
-    
-    if (!jarg2) {
-      SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "BigInteger null");
-      return ;
-    }
-    clazz = (*jenv)->GetObjectClass(jenv, jarg2);
-    mid = (*jenv)->GetMethodID(jenv, clazz, "toByteArray", "()[B");
-    ba = (jbyteArray)(*jenv)->CallObjectMethod(jenv, jarg2, mid);
-    bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    sz = (*jenv)->GetArrayLength(jenv, ba);
-    arg2 = 0;
-    if (sz > 0) {
-      arg2 = (uint64_t)(signed char)bae[0];
-      for(i=1; i<sz; i++) {
-        arg2 = (arg2 << 8) | (uint64_t)(unsigned char)bae[i];
-      }
-    }
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-  }
+  arg2 = (uint64_t)jarg2; 
   if (arg1) (arg1)->timestamp = arg2;
 }
 
 
-SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestamp_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
-  jobject jresult = 0 ;
+SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestamp_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
+  jlong jresult = 0 ;
   neomessage_can_t *arg1 = (neomessage_can_t *) 0 ;
   uint64_t result;
   
@@ -4117,29 +4634,12 @@ SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestamp_1get
   (void)jarg1_;
   arg1 = *(neomessage_can_t **)&jarg1; 
   result = (uint64_t) ((arg1)->timestamp);
-  {
-    jbyteArray ba = (*jenv)->NewByteArray(jenv, 9);
-    jbyte* bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    jclass clazz = (*jenv)->FindClass(jenv, "java/math/BigInteger");
-    jmethodID mid = (*jenv)->GetMethodID(jenv, clazz, "<init>", "([B)V");
-    jobject bigint;
-    int i;
-    
-    bae[0] = 0;
-    for(i=1; i<9; i++ ) {
-      bae[i] = (jbyte)(result>>8*(8-i));
-    }
-    
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-    bigint = (*jenv)->NewObject(jenv, clazz, mid, ba);
-    (*jenv)->DeleteLocalRef(jenv, ba);
-    jresult = bigint;
-  }
+  jresult = (jlong)result; 
   return jresult;
 }
 
 
-SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestampReserved_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jobject jarg2) {
+SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestampReserved_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jlong jarg2) {
   neomessage_can_t *arg1 = (neomessage_can_t *) 0 ;
   uint64_t arg2 ;
   
@@ -4147,38 +4647,13 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestampReserved
   (void)jcls;
   (void)jarg1_;
   arg1 = *(neomessage_can_t **)&jarg1; 
-  {
-    jclass clazz;
-    jmethodID mid;
-    jbyteArray ba;
-    jbyte* bae;
-    jsize sz;
-    int i;
-    
-    if (!jarg2) {
-      SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "BigInteger null");
-      return ;
-    }
-    clazz = (*jenv)->GetObjectClass(jenv, jarg2);
-    mid = (*jenv)->GetMethodID(jenv, clazz, "toByteArray", "()[B");
-    ba = (jbyteArray)(*jenv)->CallObjectMethod(jenv, jarg2, mid);
-    bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    sz = (*jenv)->GetArrayLength(jenv, ba);
-    arg2 = 0;
-    if (sz > 0) {
-      arg2 = (uint64_t)(signed char)bae[0];
-      for(i=1; i<sz; i++) {
-        arg2 = (arg2 << 8) | (uint64_t)(unsigned char)bae[i];
-      }
-    }
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-  }
+  arg2 = (uint64_t)jarg2; 
   if (arg1) (arg1)->timestampReserved = arg2;
 }
 
 
-SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestampReserved_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
-  jobject jresult = 0 ;
+SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestampReserved_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
+  jlong jresult = 0 ;
   neomessage_can_t *arg1 = (neomessage_can_t *) 0 ;
   uint64_t result;
   
@@ -4187,24 +4662,7 @@ SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1timestampReser
   (void)jarg1_;
   arg1 = *(neomessage_can_t **)&jarg1; 
   result = (uint64_t) ((arg1)->timestampReserved);
-  {
-    jbyteArray ba = (*jenv)->NewByteArray(jenv, 9);
-    jbyte* bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    jclass clazz = (*jenv)->FindClass(jenv, "java/math/BigInteger");
-    jmethodID mid = (*jenv)->GetMethodID(jenv, clazz, "<init>", "([B)V");
-    jobject bigint;
-    int i;
-    
-    bae[0] = 0;
-    for(i=1; i<9; i++ ) {
-      bae[i] = (jbyte)(result>>8*(8-i));
-    }
-    
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-    bigint = (*jenv)->NewObject(jenv, clazz, mid, ba);
-    (*jenv)->DeleteLocalRef(jenv, ba);
-    jresult = bigint;
-  }
+  jresult = (jlong)result; 
   return jresult;
 }
 
@@ -4218,8 +4676,9 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1can_1t_1data_1set(JNIEnv
   (void)jarg1_;
   arg1 = *(neomessage_can_t **)&jarg1; 
   
-  bool isCopy;
-  arg2 = (*jenv)->GetByteArrayElements(jenv, jarg2, &isCopy);
+  arg2 = icsneojava_setData(jenv, arg1, jarg2);
+  if(arg2 == NULL && (*jenv)->ExceptionCheck(jenv))
+    return ;
   
   if (arg1) (arg1)->data = (uint8_t const *)arg2;
 }
@@ -4440,7 +4899,7 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_delete_1neomessage_1can_1t(JNIEnv *je
   (void)jenv;
   (void)jcls;
   arg1 = *(neomessage_can_t **)&jarg1; 
-  free((char *) arg1);
+  delete_neomessage_can_t(arg1);
 }
 
 
@@ -4473,7 +4932,7 @@ SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1status_1get(JNIE
 }
 
 
-SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestamp_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jobject jarg2) {
+SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestamp_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jlong jarg2) {
   neomessage_eth_t *arg1 = (neomessage_eth_t *) 0 ;
   uint64_t arg2 ;
   
@@ -4481,38 +4940,13 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestamp_1set(JN
   (void)jcls;
   (void)jarg1_;
   arg1 = *(neomessage_eth_t **)&jarg1; 
-  {
-    jclass clazz;
-    jmethodID mid;
-    jbyteArray ba;
-    jbyte* bae;
-    jsize sz;
-    int i;
-    
-    if (!jarg2) {
-      SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "BigInteger null");
-      return ;
-    }
-    clazz = (*jenv)->GetObjectClass(jenv, jarg2);
-    mid = (*jenv)->GetMethodID(jenv, clazz, "toByteArray", "()[B");
-    ba = (jbyteArray)(*jenv)->CallObjectMethod(jenv, jarg2, mid);
-    bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    sz = (*jenv)->GetArrayLength(jenv, ba);
-    arg2 = 0;
-    if (sz > 0) {
-      arg2 = (uint64_t)(signed char)bae[0];
-      for(i=1; i<sz; i++) {
-        arg2 = (arg2 << 8) | (uint64_t)(unsigned char)bae[i];
-      }
-    }
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-  }
+  arg2 = (uint64_t)jarg2; 
   if (arg1) (arg1)->timestamp = arg2;
 }
 
 
-SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestamp_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
-  jobject jresult = 0 ;
+SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestamp_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
+  jlong jresult = 0 ;
   neomessage_eth_t *arg1 = (neomessage_eth_t *) 0 ;
   uint64_t result;
   
@@ -4521,29 +4955,12 @@ SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestamp_1get
   (void)jarg1_;
   arg1 = *(neomessage_eth_t **)&jarg1; 
   result = (uint64_t) ((arg1)->timestamp);
-  {
-    jbyteArray ba = (*jenv)->NewByteArray(jenv, 9);
-    jbyte* bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    jclass clazz = (*jenv)->FindClass(jenv, "java/math/BigInteger");
-    jmethodID mid = (*jenv)->GetMethodID(jenv, clazz, "<init>", "([B)V");
-    jobject bigint;
-    int i;
-    
-    bae[0] = 0;
-    for(i=1; i<9; i++ ) {
-      bae[i] = (jbyte)(result>>8*(8-i));
-    }
-    
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-    bigint = (*jenv)->NewObject(jenv, clazz, mid, ba);
-    (*jenv)->DeleteLocalRef(jenv, ba);
-    jresult = bigint;
-  }
+  jresult = (jlong)result; 
   return jresult;
 }
 
 
-SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestampReserved_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jobject jarg2) {
+SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestampReserved_1set(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jlong jarg2) {
   neomessage_eth_t *arg1 = (neomessage_eth_t *) 0 ;
   uint64_t arg2 ;
   
@@ -4551,38 +4968,13 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestampReserved
   (void)jcls;
   (void)jarg1_;
   arg1 = *(neomessage_eth_t **)&jarg1; 
-  {
-    jclass clazz;
-    jmethodID mid;
-    jbyteArray ba;
-    jbyte* bae;
-    jsize sz;
-    int i;
-    
-    if (!jarg2) {
-      SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "BigInteger null");
-      return ;
-    }
-    clazz = (*jenv)->GetObjectClass(jenv, jarg2);
-    mid = (*jenv)->GetMethodID(jenv, clazz, "toByteArray", "()[B");
-    ba = (jbyteArray)(*jenv)->CallObjectMethod(jenv, jarg2, mid);
-    bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    sz = (*jenv)->GetArrayLength(jenv, ba);
-    arg2 = 0;
-    if (sz > 0) {
-      arg2 = (uint64_t)(signed char)bae[0];
-      for(i=1; i<sz; i++) {
-        arg2 = (arg2 << 8) | (uint64_t)(unsigned char)bae[i];
-      }
-    }
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-  }
+  arg2 = (uint64_t)jarg2; 
   if (arg1) (arg1)->timestampReserved = arg2;
 }
 
 
-SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestampReserved_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
-  jobject jresult = 0 ;
+SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestampReserved_1get(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_) {
+  jlong jresult = 0 ;
   neomessage_eth_t *arg1 = (neomessage_eth_t *) 0 ;
   uint64_t result;
   
@@ -4591,24 +4983,7 @@ SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1timestampReser
   (void)jarg1_;
   arg1 = *(neomessage_eth_t **)&jarg1; 
   result = (uint64_t) ((arg1)->timestampReserved);
-  {
-    jbyteArray ba = (*jenv)->NewByteArray(jenv, 9);
-    jbyte* bae = (*jenv)->GetByteArrayElements(jenv, ba, 0);
-    jclass clazz = (*jenv)->FindClass(jenv, "java/math/BigInteger");
-    jmethodID mid = (*jenv)->GetMethodID(jenv, clazz, "<init>", "([B)V");
-    jobject bigint;
-    int i;
-    
-    bae[0] = 0;
-    for(i=1; i<9; i++ ) {
-      bae[i] = (jbyte)(result>>8*(8-i));
-    }
-    
-    (*jenv)->ReleaseByteArrayElements(jenv, ba, bae, 0);
-    bigint = (*jenv)->NewObject(jenv, clazz, mid, ba);
-    (*jenv)->DeleteLocalRef(jenv, ba);
-    jresult = bigint;
-  }
+  jresult = (jlong)result; 
   return jresult;
 }
 
@@ -4622,8 +4997,9 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1eth_1t_1data_1set(JNIEnv
   (void)jarg1_;
   arg1 = *(neomessage_eth_t **)&jarg1; 
   
-  bool isCopy;
-  arg2 = (*jenv)->GetByteArrayElements(jenv, jarg2, &isCopy);
+  arg2 = icsneojava_setData(jenv, arg1, jarg2);
+  if(arg2 == NULL && (*jenv)->ExceptionCheck(jenv))
+    return ;
   
   if (arg1) (arg1)->data = (uint8_t const *)arg2;
 }
@@ -4855,7 +5231,7 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_delete_1neomessage_1eth_1t(JNIEnv *je
   (void)jenv;
   (void)jcls;
   arg1 = *(neomessage_eth_t **)&jarg1; 
-  free((char *) arg1);
+  delete_neomessage_eth_t(arg1);
 }
 
 
@@ -6946,6 +7322,705 @@ SWIGEXPORT void JNICALL Java_icsneojavaJNI_neomessage_1t_1array_1setitem(JNIEnv
 }
 
 
+SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_icsneojava_1newPoller(JNIEnv *jenv, jclass jcls, jlong jarg1) {
+  jlong jresult = 0 ;
+  size_t arg1 ;
+  icsneojava_poller_t *result = 0 ;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = (size_t)jarg1; 
+  result = (icsneojava_poller_t *)icsneojava_newPoller(arg1);
+  *(icsneojava_poller_t **)&jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT void JNICALL Java_icsneojavaJNI_icsneojava_1deletePoller(JNIEnv *jenv, jclass jcls, jlong jarg1) {
+  icsneojava_poller_t *arg1 = (icsneojava_poller_t *) 0 ;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = *(icsneojava_poller_t **)&jarg1; 
+  icsneojava_deletePoller(arg1);
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_icsneojava_1clearPoller(JNIEnv *jenv, jclass jcls, jlong jarg1) {
+  jint jresult = 0 ;
+  icsneojava_poller_t *arg1 = (icsneojava_poller_t *) 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = *(icsneojava_poller_t **)&jarg1; 
+  result = (int)icsneojava_clearPoller(arg1);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_icsneojava_1getMessagesPacked(JNIEnv *jenv, jclass jcls, jlong jarg2, jlong jarg3, jobject jarg3_, jobject jarg4, jlong jarg5, jlong jarg6) {
+  jint jresult = 0 ;
+  JNIEnv *arg1 = (JNIEnv *) 0 ;
+  icsneojava_poller_t *arg2 = (icsneojava_poller_t *) 0 ;
+  neodevice_t *arg3 = (neodevice_t *) 0 ;
+  jobject arg4 ;
+  size_t arg5 ;
+  uint64_t arg6 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg3_;
+  arg1 = jenv;
+  arg2 = *(icsneojava_poller_t **)&jarg2; 
+  arg3 = *(neodevice_t **)&jarg3; 
+  arg4 = jarg4; 
+  arg5 = (size_t)jarg5; 
+  arg6 = (uint64_t)jarg6; 
+  result = (int)icsneojava_getMessagesPacked(arg1,arg2,(neodevice_t const *)arg3,arg4,arg5,arg6);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_icsneojava_1addMessageListener(JNIEnv *jenv, jclass jcls, jlong jarg2, jobject jarg2_, jobject jarg3, jlong jarg4, jlong jarg5) {
+  jlong jresult = 0 ;
+  JNIEnv *arg1 = (JNIEnv *) 0 ;
+  neodevice_t *arg2 = (neodevice_t *) 0 ;
+  jobject arg3 ;
+  size_t arg4 ;
+  uint64_t arg5 ;
+  icsneojava_listener_t *result = 0 ;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg2_;
+  arg1 = jenv;
+  arg2 = *(neodevice_t **)&jarg2; 
+  arg3 = jarg3; 
+  arg4 = (size_t)jarg4; 
+  arg5 = (uint64_t)jarg5; 
+  result = (icsneojava_listener_t *)icsneojava_addMessageListener(arg1,(neodevice_t const *)arg2,arg3,arg4,arg5);
+  *(icsneojava_listener_t **)&jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneojava_1removeMessageListener(JNIEnv *jenv, jclass jcls, jlong jarg2) {
+  jboolean jresult = 0 ;
+  JNIEnv *arg1 = (JNIEnv *) 0 ;
+  icsneojava_listener_t *arg2 = (icsneojava_listener_t *) 0 ;
+  bool result;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = jenv;
+  arg2 = *(icsneojava_listener_t **)&jarg2; 
+  result = (bool)icsneojava_removeMessageListener(arg1,arg2);
+  jresult = (jboolean)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_icsneojava_1getMessageListenerDropped(JNIEnv *jenv, jclass jcls, jlong jarg1) {
+  jlong jresult = 0 ;
+  icsneojava_listener_t *arg1 = (icsneojava_listener_t *) 0 ;
+  uint64_t result;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = *(icsneojava_listener_t **)&jarg1; 
+  result = (uint64_t)icsneobinding_getMessageListenerDropped(arg1);
+  jresult = (jlong)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOMESSAGE_1SIZE_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOMESSAGE_SIZE);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOMESSAGE_1STATUS_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOMESSAGE_STATUS_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOMESSAGE_1TIMESTAMP_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOMESSAGE_TIMESTAMP_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOMESSAGE_1LENGTH_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOMESSAGE_LENGTH_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOMESSAGE_1LENGTH_1SIZE_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOMESSAGE_LENGTH_SIZE);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOMESSAGE_1NETID_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOMESSAGE_NETID_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOMESSAGE_1TYPE_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOMESSAGE_TYPE_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOMESSAGE_1CAN_1ARBID_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOMESSAGE_CAN_ARBID_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_icsneojava_1wrapMessages(JNIEnv *jenv, jclass jcls, jlong jarg2, jobject jarg2_, jlong jarg3) {
+  jobject jresult = 0 ;
+  JNIEnv *arg1 = (JNIEnv *) 0 ;
+  neomessage_t *arg2 = (neomessage_t *) 0 ;
+  size_t arg3 ;
+  jobject result;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg2_;
+  arg1 = jenv;
+  arg2 = *(neomessage_t **)&jarg2; 
+  arg3 = (size_t)jarg3; 
+  result = (jobject)icsneojava_wrapMessages(arg1,arg2,arg3);
+  jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_icsneojava_1copyMessageData(JNIEnv *jenv, jclass jcls, jlong jarg2, jobject jarg2_, jlong jarg3, jlong jarg4, jbyteArray jarg5, jint jarg6) {
+  jint jresult = 0 ;
+  JNIEnv *arg1 = (JNIEnv *) 0 ;
+  neomessage_t *arg2 = (neomessage_t *) 0 ;
+  size_t arg3 ;
+  size_t arg4 ;
+  jbyteArray arg5 ;
+  int arg6 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg2_;
+  arg1 = jenv;
+  arg2 = *(neomessage_t **)&jarg2; 
+  arg3 = (size_t)jarg3; 
+  arg4 = (size_t)jarg4; 
+  arg5 = jarg5; 
+  arg6 = (int)jarg6; 
+  result = (int)icsneojava_copyMessageData(arg1,(neomessage_t const *)arg2,arg3,arg4,arg5,arg6);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEODEVICE_1SIZE_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEODEVICE_SIZE);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEODEVICE_1HANDLE_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEODEVICE_HANDLE_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEODEVICE_1TYPE_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEODEVICE_TYPE_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEODEVICE_1SERIAL_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEODEVICE_SERIAL_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOEVENT_1SIZE_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOEVENT_SIZE);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOEVENT_1TIMESTAMP_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOEVENT_TIMESTAMP_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOEVENT_1TIMESTAMP_1SIZE_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOEVENT_TIMESTAMP_SIZE);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOEVENT_1EVENTNUMBER_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOEVENT_EVENTNUMBER_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOEVENT_1SEVERITY_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOEVENT_SEVERITY_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_ICSNEOJAVA_1NEOEVENT_1SERIAL_1OFFSET_1get(JNIEnv *jenv, jclass jcls) {
+  jint jresult = 0 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (int)(ICSNEOJAVA_NEOEVENT_SERIAL_OFFSET);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_icsneojava_1wrapDevices(JNIEnv *jenv, jclass jcls, jlong jarg2, jobject jarg2_, jlong jarg3) {
+  jobject jresult = 0 ;
+  JNIEnv *arg1 = (JNIEnv *) 0 ;
+  neodevice_t *arg2 = (neodevice_t *) 0 ;
+  size_t arg3 ;
+  jobject result;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg2_;
+  arg1 = jenv;
+  arg2 = *(neodevice_t **)&jarg2; 
+  arg3 = (size_t)jarg3; 
+  result = (jobject)icsneojava_wrapDevices(arg1,arg2,arg3);
+  jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jobject JNICALL Java_icsneojavaJNI_icsneojava_1wrapEvents(JNIEnv *jenv, jclass jcls, jlong jarg2, jobject jarg2_, jlong jarg3) {
+  jobject jresult = 0 ;
+  JNIEnv *arg1 = (JNIEnv *) 0 ;
+  neoevent_t *arg2 = (neoevent_t *) 0 ;
+  size_t arg3 ;
+  jobject result;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg2_;
+  arg1 = jenv;
+  arg2 = *(neoevent_t **)&jarg2; 
+  arg3 = (size_t)jarg3; 
+  result = (jobject)icsneojava_wrapEvents(arg1,arg2,arg3);
+  jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_icsneojava_1findAllDevices(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jint jarg2) {
+  jint jresult = 0 ;
+  neodevice_t *arg1 = (neodevice_t *) 0 ;
+  int arg2 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg1_;
+  arg1 = *(neodevice_t **)&jarg1; 
+  arg2 = (int)jarg2; 
+  result = (int)icsneojava_findAllDevices(arg1,arg2);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_icsneojava_1getEvents(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jint jarg2) {
+  jint jresult = 0 ;
+  neoevent_t *arg1 = (neoevent_t *) 0 ;
+  int arg2 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg1_;
+  arg1 = *(neoevent_t **)&jarg1; 
+  arg2 = (int)jarg2; 
+  result = (int)icsneojava_getEvents(arg1,arg2);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jint JNICALL Java_icsneojavaJNI_icsneojava_1getDeviceEvents(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jlong jarg2, jobject jarg2_, jint jarg3) {
+  jint jresult = 0 ;
+  neodevice_t *arg1 = (neodevice_t *) 0 ;
+  neoevent_t *arg2 = (neoevent_t *) 0 ;
+  int arg3 ;
+  int result;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg1_;
+  (void)jarg2_;
+  arg1 = *(neodevice_t **)&jarg1; 
+  arg2 = *(neoevent_t **)&jarg2; 
+  arg3 = (int)jarg3; 
+  result = (int)icsneojava_getDeviceEvents((neodevice_t const *)arg1,arg2,arg3);
+  jresult = (jint)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jstring JNICALL Java_icsneojavaJNI_icsneojava_1getEventDescription(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jlong jarg2) {
+  jstring jresult = 0 ;
+  neoevent_t *arg1 = (neoevent_t *) 0 ;
+  size_t arg2 ;
+  char *result = 0 ;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg1_;
+  arg1 = *(neoevent_t **)&jarg1; 
+  arg2 = (size_t)jarg2; 
+  result = (char *)icsneojava_getEventDescription((neoevent_t const *)arg1,arg2);
+  if (result) jresult = (*jenv)->NewStringUTF(jenv, (const char *)result);
+  return jresult;
+}
+
+
+SWIGEXPORT jlong JNICALL Java_icsneojavaJNI_icsneojava_1newFilter(JNIEnv *jenv, jclass jcls) {
+  jlong jresult = 0 ;
+  icsneojava_filter_t *result = 0 ;
+  
+  (void)jenv;
+  (void)jcls;
+  result = (icsneojava_filter_t *)icsneobinding_newFilter();
+  *(icsneojava_filter_t **)&jresult = result; 
+  return jresult;
+}
+
+
+SWIGEXPORT void JNICALL Java_icsneojavaJNI_icsneojava_1deleteFilter(JNIEnv *jenv, jclass jcls, jlong jarg1) {
+  icsneojava_filter_t *arg1 = (icsneojava_filter_t *) 0 ;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = *(icsneojava_filter_t **)&jarg1; 
+  icsneobinding_deleteFilter(arg1);
+}
+
+
+SWIGEXPORT void JNICALL Java_icsneojavaJNI_icsneojava_1clearFilter(JNIEnv *jenv, jclass jcls, jlong jarg1) {
+  icsneojava_filter_t *arg1 = (icsneojava_filter_t *) 0 ;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = *(icsneojava_filter_t **)&jarg1; 
+  icsneobinding_clearFilter(arg1);
+}
+
+
+SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneojava_1filterAddNetid(JNIEnv *jenv, jclass jcls, jlong jarg1, jint jarg2) {
+  jboolean jresult = 0 ;
+  icsneojava_filter_t *arg1 = (icsneojava_filter_t *) 0 ;
+  int arg2 ;
+  bool result;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = *(icsneojava_filter_t **)&jarg1; 
+  arg2 = (int)jarg2; 
+  result = (bool)icsneobinding_filterAddNetid(arg1,arg2);
+  jresult = (jboolean)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneojava_1filterAddType(JNIEnv *jenv, jclass jcls, jlong jarg1, jint jarg2) {
+  jboolean jresult = 0 ;
+  icsneojava_filter_t *arg1 = (icsneojava_filter_t *) 0 ;
+  int arg2 ;
+  bool result;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = *(icsneojava_filter_t **)&jarg1; 
+  arg2 = (int)jarg2; 
+  result = (bool)icsneobinding_filterAddType(arg1,arg2);
+  jresult = (jboolean)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneojava_1filterAddArbidRange(JNIEnv *jenv, jclass jcls, jlong jarg1, jlong jarg2, jlong jarg3, jlong jarg4) {
+  jboolean jresult = 0 ;
+  icsneojava_filter_t *arg1 = (icsneojava_filter_t *) 0 ;
+  uint32_t arg2 ;
+  uint32_t arg3 ;
+  uint32_t arg4 ;
+  bool result;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = *(icsneojava_filter_t **)&jarg1; 
+  arg2 = (uint32_t)jarg2; 
+  arg3 = (uint32_t)jarg3; 
+  arg4 = (uint32_t)jarg4; 
+  result = (bool)icsneobinding_filterAddArbidRange(arg1,arg2,arg3,arg4);
+  jresult = (jboolean)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneojava_1getMessagesFiltered(JNIEnv *jenv, jclass jcls, jlong jarg1, jobject jarg1_, jlong jarg2, jlong jarg3, jobject jarg3_, jintArray jarg4, jlong jarg5) {
+  jboolean jresult = 0 ;
+  neodevice_t *arg1 = (neodevice_t *) 0 ;
+  icsneojava_filter_t *arg2 = (icsneojava_filter_t *) 0 ;
+  neomessage_t *arg3 = (neomessage_t *) 0 ;
+  int *arg4 = (int *) 0 ;
+  uint64_t arg5 ;
+  bool result;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg1_;
+  (void)jarg3_;
+  arg1 = *(neodevice_t **)&jarg1; 
+  arg2 = *(icsneojava_filter_t **)&jarg2; 
+  arg3 = *(neomessage_t **)&jarg3; 
+  {
+    if (!jarg4) {
+      SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "array null");
+      return 0;
+    }
+    if ((*jenv)->GetArrayLength(jenv, jarg4) == 0) {
+      SWIG_JavaThrowException(jenv, SWIG_JavaIndexOutOfBoundsException, "Array must contain at least 1 element");
+      return 0;
+    }
+    arg4 = (int *) (*jenv)->GetIntArrayElements(jenv, jarg4, 0); 
+  }
+  arg5 = (uint64_t)jarg5; 
+  result = (bool)icsneobinding_getMessagesFiltered((neodevice_t const *)arg1,(icsneojava_filter_t const *)arg2,arg3,arg4,arg5);
+  jresult = (jboolean)result; 
+  {
+    (*jenv)->ReleaseIntArrayElements(jenv, jarg4, (jint *)arg4, 0); 
+  }
+  
+  return jresult;
+}
+
+
+SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneojava_1setPollerFilter(JNIEnv *jenv, jclass jcls, jlong jarg1, jlong jarg2) {
+  jboolean jresult = 0 ;
+  icsneojava_poller_t *arg1 = (icsneojava_poller_t *) 0 ;
+  icsneojava_filter_t *arg2 = (icsneojava_filter_t *) 0 ;
+  bool result;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = *(icsneojava_poller_t **)&jarg1; 
+  arg2 = *(icsneojava_filter_t **)&jarg2; 
+  result = (bool)icsneojava_setPollerFilter(arg1,(icsneojava_filter_t const *)arg2);
+  jresult = (jboolean)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneojava_1setMessageListenerFilter(JNIEnv *jenv, jclass jcls, jlong jarg1, jlong jarg2) {
+  jboolean jresult = 0 ;
+  icsneojava_listener_t *arg1 = (icsneojava_listener_t *) 0 ;
+  icsneojava_filter_t *arg2 = (icsneojava_filter_t *) 0 ;
+  bool result;
+  
+  (void)jenv;
+  (void)jcls;
+  arg1 = *(icsneojava_listener_t **)&jarg1; 
+  arg2 = *(icsneojava_filter_t **)&jarg2; 
+  result = (bool)icsneojava_setMessageListenerFilter(arg1,(icsneojava_filter_t const *)arg2);
+  jresult = (jboolean)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneojava_1transmitMessages(JNIEnv *jenv, jclass jcls, jlong jarg2, jobject jarg2_, jintArray jarg3, jintArray jarg4, jintArray jarg5, jintArray jarg6, jbyteArray jarg7, jint jarg8) {
+  jboolean jresult = 0 ;
+  JNIEnv *arg1 = (JNIEnv *) 0 ;
+  neodevice_t *arg2 = (neodevice_t *) 0 ;
+  jintArray arg3 ;
+  jintArray arg4 ;
+  jintArray arg5 ;
+  jintArray arg6 ;
+  jbyteArray arg7 ;
+  int arg8 ;
+  bool result;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg2_;
+  arg1 = jenv;
+  arg2 = *(neodevice_t **)&jarg2; 
+  arg3 = jarg3; 
+  arg4 = jarg4; 
+  arg5 = jarg5; 
+  arg6 = jarg6; 
+  arg7 = jarg7; 
+  arg8 = (int)jarg8; 
+  result = (bool)icsneojava_transmitMessages(arg1,(neodevice_t const *)arg2,arg3,arg4,arg5,arg6,arg7,arg8);
+  jresult = (jboolean)result; 
+  return jresult;
+}
+
+
+SWIGEXPORT jboolean JNICALL Java_icsneojavaJNI_icsneojava_1transmitMessagesDirect(JNIEnv *jenv, jclass jcls, jlong jarg2, jobject jarg2_, jintArray jarg3, jintArray jarg4, jintArray jarg5, jintArray jarg6, jobject jarg7, jlong jarg8, jint jarg9) {
+  jboolean jresult = 0 ;
+  JNIEnv *arg1 = (JNIEnv *) 0 ;
+  neodevice_t *arg2 = (neodevice_t *) 0 ;
+  jintArray arg3 ;
+  jintArray arg4 ;
+  jintArray arg5 ;
+  jintArray arg6 ;
+  jobject arg7 ;
+  size_t arg8 ;
+  int arg9 ;
+  bool result;
+  
+  (void)jenv;
+  (void)jcls;
+  (void)jarg2_;
+  arg1 = jenv;
+  arg2 = *(neodevice_t **)&jarg2; 
+  arg3 = jarg3; 
+  arg4 = jarg4; 
+  arg5 = jarg5; 
+  arg6 = jarg6; 
+  arg7 = jarg7; 
+  arg8 = (size_t)jarg8; 
+  arg9 = (int)jarg9; 
+  result = (bool)icsneojava_transmitMessagesDirect(arg1,(neodevice_t const *)arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9);
+  jresult = (jboolean)result; 
+  return jresult;
+}
+
+
 #ifdef __cplusplus
 }
 #endif
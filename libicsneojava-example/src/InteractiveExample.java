@@ -1,6 +1,7 @@
-import java.math.BigInteger;
+import java.nio.ByteBuffer;
 import java.util.ArrayList;
 import java.util.Scanner;
+import java.util.concurrent.atomic.AtomicLong;
 
 public class InteractiveExample {
 
@@ -8,6 +9,25 @@ public class InteractiveExample {
     private neodevice_t selectedDevice;
     private ArrayList<neodevice_t> devices = new ArrayList<neodevice_t>();
     private int numDevices = 0;
+    private ByteBuffer packedBuffer = MessageRecordReader.allocate(1024 * 1024);
+    // Kept between presses of K, so messages which did not fit in packedBuffer are printed the next time
+    private SWIGTYPE_p_icsneojava_poller_t poller;
+    private neodevice_t polledDevice; // The device the poller's held messages came from
+    private MessageRecordReader recordReader = new MessageRecordReader();
+    private byte[] payload = new byte[64]; // Large enough for any CAN FD frame
+    private SWIGTYPE_p_icsneojava_listener_t messageListener;
+    private AtomicLong listenedMessages = new AtomicLong();
+    private AtomicLong listenedCANMessages = new AtomicLong();
+    // Applied in native code to F, K and L, so messages which do not pass never reach Java
+    private SWIGTYPE_p_icsneojava_filter_t receiveFilter = icsneojava.icsneojava_newFilter();
+    private TransmitBatch transmitBatch = new TransmitBatch(100, 100 * 64);
+    // Reused for every scan and every time events are read, filled in place
+    private NeoDeviceCursor foundDevices = new NeoDeviceCursor(icsneojava.new_neodevice_t_array(99), 99);
+    private NeoEventCursor events = new NeoEventCursor(icsneojava.new_neoevent_t_array(99), 99);
+    // Reused for every press of F, the cursor only has to be reset to the number of messages each poll returns
+    private neomessage_t polledMessages = icsneojava.new_neomessage_t_array(msgLimit);
+    private NeoMessageCursor polledCursor = new NeoMessageCursor(polledMessages, msgLimit);
+    private int[] polledCount = new int[1];
 
     private void printAllDevices() {
         if(numDevices == 0) {
@@ -41,20 +61,14 @@ public class InteractiveExample {
     }
 
     private int scanNewDevices() {
-        neodevice_t newDevices = icsneojava.new_neodevice_t_array(99);
+        int count = foundDevices.findAll();
 
-        int[] count = {10};
+        numDevices += count;
 
-        icsneojava.icsneo_findAllDevices(newDevices, count);
-
-        numDevices += count[0];
-
-        for(int i = 0; i < numDevices; i++) {
-            devices.add(icsneojava.neodevice_t_array_getitem(newDevices, i));
+        while(foundDevices.next()) {
+            devices.add(foundDevices.getDevice());
         }
-
-        icsneojava.delete_neodevice_t_array(newDevices);
-        return count[0];
+        return count;
     }
 
     private void printMainMenu() {
@@ -69,6 +83,10 @@ public class InteractiveExample {
         System.out.println("H - Get events");
         System.out.println("I - Set HS CAN to 250K");
         System.out.println("J - Set HS CAN to 500K");
+        System.out.println("K - Get messages into a buffer");
+        System.out.println("L - Start/stop listening for messages");
+        System.out.println("M - Set receive filter");
+        System.out.println("N - Send a batch of messages");
         System.out.println("X - Exit");
     }
 
@@ -81,45 +99,30 @@ public class InteractiveExample {
     }
 
     private void printAPIEvents() {
-        neoevent_t events = icsneojava.new_neoevent_t_array(99);
-        int[] eventCount = {99};
-        if(icsneojava.icsneo_getEvents(events, eventCount)) {
-            if(eventCount[0] == 1) {
-                neoevent_t evt = icsneojava.neoevent_t_array_getitem(events, 0);
-                System.out.println("1 API event found!");
-                System.out.println("Event 0x" + evt.getEventNumber() + ": " + evt.getDescription());
-            } else {
-                System.out.println(eventCount[0] + " API events found!");
-                for(var i = 0; i < eventCount[0]; ++i) {
-                    neoevent_t evt = icsneojava.neoevent_t_array_getitem(events, i);
-                    System.out.println("Event 0x" + evt.getEventNumber() + ": " + evt.getDescription());
-                }
-            }
+        if(events.getEvents() >= 0) {
+            printEvents("API");
         } else {
             System.out.println("Failed to get API events!");
         }
-        icsneojava.delete_neoevent_t_array(events);
     }
 
     private void printDeviceEvents(neodevice_t device) {
-        neoevent_t events = icsneojava.new_neoevent_t_array(99);
-        int[] eventCount = {99};
-        if(icsneojava.icsneo_getDeviceEvents(device, events, eventCount)) {
-             if(eventCount[0] == 1) {
-                neoevent_t evt = icsneojava.neoevent_t_array_getitem(events, 0);
-                System.out.println("1 device event found!");
-                System.out.println("Event 0x" + evt.getEventNumber() + ": " + evt.getDescription());
-            } else {
-                System.out.println(eventCount[0] + " device events found!");
-                for(int i = 0; i < eventCount[0]; ++i) {
-                    neoevent_t evt = icsneojava.neoevent_t_array_getitem(events, i);
-                    System.out.println("Event 0x" + evt.getEventNumber() + ": " + evt.getDescription());
-                }
-            }
+        if(events.getDeviceEvents(device) >= 0) {
+            printEvents("device");
         } else {
             System.out.println("Failed to get API events!");
         }
-        icsneojava.delete_neoevent_t_array(events);
+    }
+
+    private void printEvents(String kind) {
+        if(events.getCount() == 1)
+            System.out.println("1 " + kind + " event found!");
+        else
+            System.out.println(events.getCount() + " " + kind + " events found!");
+        while(events.next()) {
+            // The description is decoded once per event number, rather than for every event
+            System.out.println("Event 0x" + events.getEventNumber() + ": " + events.getDescription());
+        }
     }
 
     private char getCharInput(char[] allowed) {
@@ -170,7 +173,7 @@ public class InteractiveExample {
         while(true) {
             printMainMenu();
             System.out.println();
-            char input = getCharInput(new char[] { 'A', 'a', 'B', 'b', 'C', 'c', 'D', 'd', 'E', 'e', 'F', 'f', 'G', 'g', 'H', 'h', 'I', 'i', 'J', 'j', 'X', 'x' });
+            char input = getCharInput(new char[] { 'A', 'a', 'B', 'b', 'C', 'c', 'D', 'd', 'E', 'e', 'F', 'f', 'G', 'g', 'H', 'h', 'I', 'i', 'J', 'j', 'K', 'k', 'L', 'l', 'M', 'm', 'N', 'n', 'X', 'x' });
             System.out.println();
             switch(input) {
                 // List current devices
@@ -368,39 +371,37 @@ public class InteractiveExample {
 
                     icsneojava.icsneo_describeDevice(selectedDevice, description, maxLength);
 
-                    // Prepare the neomessage_t array and size for reading in the messages
-                    neomessage_t msgs = icsneojava.new_neomessage_t_array((int)msgLimit);
-                    int[] msgCount = {msgLimit};
-
-                    if(!icsneojava.icsneo_getMessages(selectedDevice, msgs, msgCount, BigInteger.ZERO)) {
+                    // Read into the array kept for polling, telling icsneoc how many messages it holds
+                    polledCount[0] = msgLimit;
+                    if(!icsneojava.icsneojava_getMessagesFiltered(selectedDevice, receiveFilter, polledMessages, polledCount, 0)) {
                         System.out.println("Failed to get messages for " + description + "!\n");
-                        icsneojava.delete_neomessage_t_array(msgs);
                         printLastError();
                         System.out.println();
                         break;
                     }
 
-                    if(msgCount[0] == 1) {
+                    if(polledCount[0] == 1) {
                         System.out.println("1 message received from " + description + "!");
                     } else {
-                        System.out.println(msgCount[0] + " messages received from " + description + "!");
+                        System.out.println(polledCount[0] + " messages received from " + description + "!");
                     }
 
                     // Print out the received messages
-                    for(int i = 0; i < msgCount[0]; i++) {
-                        neomessage_t msg = icsneojava.neomessage_t_array_getitem(msgs, i);
-                        if(msg.getType() == icsneojava.ICSNEO_NETWORK_TYPE_CAN) {
-                            System.out.print("\t0x" + String.format("%03x", icsneojava.neomessage_can_t_cast(msg).getArbid()) + " [" + msg.getLength() + "] ");
-                            for(int j = 0; j < msg.getLength(); j++) {
-                                System.out.print(String.format("%02x ", icsneojava.neomessage_can_t_cast(msg).getData()[j]));
+                    // The cursor reads each message in place, rather than copying it out with neomessage_t_array_getitem
+                    NeoMessageCursor cursor = polledCursor.reset(polledCount[0]);
+                    while(cursor.next()) {
+                        if(cursor.getType() == icsneojava.ICSNEO_NETWORK_TYPE_CAN) {
+                            int length = cursor.copyData(payload, 0);
+                            System.out.print("\t0x" + String.format("%03x", cursor.getArbid()) + " [" + length + "] ");
+                            for(int j = 0; j < length; j++) {
+                                System.out.print(String.format("%02x ", payload[j]));
                             }
-                            System.out.println("(" + msg.getTimestamp() + ")");
+                            System.out.println("(" + Long.toUnsignedString(cursor.getTimestamp()) + ")");
                         } else {
-                            if(msg.getNetid() != 0)
-                                System.out.println("\tMessage on netid " + msg.getNetid() + " with length " + msg.getLength());
+                            if(cursor.getNetid() != 0)
+                                System.out.println("\tMessage on netid " + cursor.getNetid() + " with length " + cursor.getLength());
                         }
                     }
-                    icsneojava.delete_neomessage_t_array(msgs);
                     break;
                 }
                 // Send message
@@ -498,6 +499,192 @@ public class InteractiveExample {
                     }
                     break;
                 }
+                // Get messages into a buffer
+                case 'K':
+                case 'k': {
+                    // Select a device and get its description
+                    if(numDevices == 0) {
+                        System.out.println("No devices found! Please scan for new devices.\n");
+                        break;
+                    }
+                    selectedDevice = selectDevice();
+
+                    // Get the product description for the device
+                    StringBuffer description = new StringBuffer(icsneojava.ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION);
+                    int[] maxLength = {icsneojava.ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION};
+
+                    icsneojava.icsneo_describeDevice(selectedDevice, description, maxLength);
+
+                    // Each call fills the buffer with as many messages as fit, in a single JNI call
+                    // Messages which did not fit are kept by the poller for the next call, even the next press of K
+                    if(poller == null)
+                        poller = icsneojava.icsneojava_newPoller(msgLimit);
+                    if(polledDevice != null && polledDevice != selectedDevice) {
+                        int dropped = icsneojava.icsneojava_clearPoller(poller);
+                        if(dropped != 0)
+                            System.out.println("Dropped " + dropped + " messages held from the previously selected device");
+                    }
+                    polledDevice = selectedDevice;
+                    icsneojava.icsneojava_setPollerFilter(poller, receiveFilter);
+                    int total = 0;
+                    int records;
+                    do {
+                        records = icsneojava.icsneojava_getMessagesPacked(poller, selectedDevice, packedBuffer, packedBuffer.capacity(), 0);
+                        if(records < 0) {
+                            System.out.println("Failed to get messages for " + description + "!\n");
+                            printLastError();
+                            break;
+                        }
+
+                        // The reader walks the records in place, no objects are created per message
+                        recordReader.reset(packedBuffer, records);
+                        while(recordReader.next()) {
+                            if(recordReader.getType() == icsneojava.ICSNEO_NETWORK_TYPE_CAN) {
+                                System.out.print("\t0x" + String.format("%03x", recordReader.getArbid()) + " [" + recordReader.getLength() + "] ");
+                                for(int j = 0; j < recordReader.getLength(); j++) {
+                                    System.out.print(String.format("%02x ", recordReader.getData(j)));
+                                }
+                                System.out.println("(" + Long.toUnsignedString(recordReader.getTimestamp()) + ")");
+                            } else if(recordReader.getNetid() != 0) {
+                                System.out.println("\tMessage on netid " + recordReader.getNetid() + " with length " + recordReader.getLength());
+                            }
+                        }
+                        total += records;
+                    } while(records > 0 && total < msgLimit);
+
+                    if(total == 1) {
+                        System.out.println("1 message received from " + description + "!\n");
+                    } else {
+                        System.out.println(total + " messages received from " + description + "!\n");
+                    }
+                    break;
+                }
+                // Start/stop listening for messages
+                case 'L':
+                case 'l': {
+                    if(messageListener != null) {
+                        // The listener is freed once removed, so read how many messages it dropped first
+                        // Removing the listener delivers the messages already collected before it returns
+                        long dropped = icsneojava.icsneojava_getMessageListenerDropped(messageListener);
+                        if(icsneojava.icsneojava_removeMessageListener(messageListener)) {
+                            System.out.println("Stopped listening, " + listenedMessages.get() + " messages received, " + listenedCANMessages.get() + " of them CAN!");
+                            System.out.println(dropped + " messages were dropped\n");
+                            messageListener = null;
+                        } else {
+                            System.out.println("Failed to stop listening!\n");
+                            printLastError();
+                            System.out.println();
+                        }
+                        break;
+                    }
+
+                    // Select a device and get its description
+                    if(numDevices == 0) {
+                        System.out.println("No devices found! Please scan for new devices.\n");
+                        break;
+                    }
+                    selectedDevice = selectDevice();
+
+                    // Get the product description for the device
+                    StringBuffer description = new StringBuffer(icsneojava.ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION);
+                    int[] maxLength = {icsneojava.ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION};
+
+                    icsneojava.icsneo_describeDevice(selectedDevice, description, maxLength);
+
+                    // The listener is called on a native thread with up to 256 messages at a time
+                    // A smaller batch is delivered once its first message has waited 1ms
+                    listenedMessages.set(0);
+                    listenedCANMessages.set(0);
+                    MessageRecordReader listenerReader = new MessageRecordReader();
+                    messageListener = icsneojava.icsneojava_addMessageListener(selectedDevice, (buffer, records) -> {
+                        listenerReader.reset(buffer, records);
+                        while(listenerReader.next()) {
+                            if(listenerReader.getType() == icsneojava.ICSNEO_NETWORK_TYPE_CAN)
+                                listenedCANMessages.incrementAndGet();
+                        }
+                        listenedMessages.addAndGet(records);
+                    }, 256, 1000);
+
+                    if(messageListener != null) {
+                        icsneojava.icsneojava_setMessageListenerFilter(messageListener, receiveFilter);
+                        System.out.println("Listening for messages from " + description + ", select L again to stop!\n");
+                    } else {
+                        System.out.println("Failed to listen for messages from " + description + "!\n");
+                        printLastError();
+                        System.out.println();
+                    }
+                    break;
+                }
+                // Set receive filter
+                case 'M':
+                case 'm': {
+                    System.out.println("Which messages would you like to receive?");
+                    System.out.println("[1] All messages\n[2] Only HS CAN\n[3] Only CAN messages with arbids 0x100 to 0x1FF\n[4] Cancel\n");
+
+                    char option = getCharInput(new char[] { '1', '2', '3', '4' });
+                    System.out.println();
+
+                    switch(option) {
+                        case '1':
+                            icsneojava.icsneojava_clearFilter(receiveFilter);
+                            System.out.println("Receiving all messages!\n");
+                            break;
+                        case '2':
+                            icsneojava.icsneojava_clearFilter(receiveFilter);
+                            icsneojava.icsneojava_filterAddNetid(receiveFilter, icsneojava.ICSNEO_NETID_HSCAN);
+                            System.out.println("Receiving only HS CAN messages!\n");
+                            break;
+                        case '3':
+                            // Arbids are masked to 11 bits before they are compared
+                            icsneojava.icsneojava_clearFilter(receiveFilter);
+                            icsneojava.icsneojava_filterAddType(receiveFilter, icsneojava.ICSNEO_NETWORK_TYPE_CAN);
+                            icsneojava.icsneojava_filterAddArbidRange(receiveFilter, 0x100, 0x1FF, 0x7FF);
+                            System.out.println("Receiving only CAN messages with arbids 0x100 to 0x1FF!\n");
+                            break;
+                        default:
+                            System.out.println("Canceling!\n");
+                            break;
+                    }
+
+                    // Listeners keep their own copy of the filter, so update the running one
+                    if(option != '4' && messageListener != null)
+                        icsneojava.icsneojava_setMessageListenerFilter(messageListener, receiveFilter);
+                    break;
+                }
+                // Send a batch of messages
+                case 'N':
+                case 'n': {
+                    // Select a device and get its description
+                    if(numDevices == 0) {
+                        System.out.println("No devices found! Please scan for new devices.\n");
+                        break;
+                    }
+                    selectedDevice = selectDevice();
+
+                    // Get the product description for the device
+                    StringBuffer description = new StringBuffer(icsneojava.ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION);
+                    int[] maxLength = {icsneojava.ICSNEO_DEVICETYPE_LONGEST_DESCRIPTION};
+
+                    icsneojava.icsneo_describeDevice(selectedDevice, description, maxLength);
+
+                    // Arbids 0x120 to 0x183 on HS CAN, each carrying its index as an 8 byte counter
+                    transmitBatch.clear();
+                    for(int i = 0; i < 100; i++) {
+                        for(int j = 0; j < 8; j++)
+                            payload[j] = (byte) ((long) i >>> 8 * (7 - j));
+                        transmitBatch.add(icsneojava.ICSNEO_NETID_HSCAN, 0x120 + i, 0, payload, 0, 8);
+                    }
+
+                    // All 100 messages go to the device in one call
+                    if(transmitBatch.transmit(selectedDevice)) {
+                        System.out.println("Transmitted " + transmitBatch.size() + " messages!");
+                    } else {
+                        System.out.println("Failed to transmit messages to " + description + "!\n");
+                        printLastError();
+                        System.out.println();
+                    }
+                    break;
+                }
                 case 'X':
                 case 'x':
                     System.out.println("Exiting program");
@@ -0,0 +1,16 @@
+import java.nio.ByteBuffer;
+
+/**
+ * Receives messages from a device in batches, see icsneojava.icsneojava_addMessageListener.
+ *
+ * onMessages is called on a native delivery thread, one per listener, never from two threads at once.
+ * Read the batch with MessageRecordReader. The buffer is reused for later batches, so do not keep it,
+ * or any part of it, after onMessages returns. Do not remove the listener from within onMessages.
+ */
+public interface MessageListener {
+    /**
+     * @param buffer the packed records, in the layout documented in MessageRecordReader.java
+     * @param records the number of records in the buffer
+     */
+    void onMessages(ByteBuffer buffer, int records);
+}
@@ -0,0 +1,153 @@
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * Walks the packed message records written by icsneojava.icsneojava_getMessagesPacked.
+ *
+ * The reader is a flyweight, it points at one record at a time and reads its fields straight out of the
+ * buffer, so going through a batch creates no objects. Reuse one reader for every batch.
+ *
+ * Each record starts 8 byte aligned, and all fields are in native byte order:
+ *
+ *   Offset  Size  Field
+ *        0     4  Record length, including the header and padding
+ *        4     2  Network ID
+ *        6     1  Network type
+ *        7     1  Flags, see the FLAG_ constants
+ *        8     8  Timestamp, in nanoseconds since 1/1/2007 (unsigned)
+ *       16     4  Arbitration ID for CAN, otherwise 0
+ *       20     4  Payload length
+ *       24    16  The raw neomessage_statusbitfield_t, as four 32-bit words
+ *       40     n  Payload
+ */
+public class MessageRecordReader {
+    public static final int HEADER_SIZE = 40;
+
+    public static final int FLAG_TRANSMITTED = 0x01;
+    public static final int FLAG_EXTENDED = 0x02;
+    public static final int FLAG_REMOTE = 0x04;
+    public static final int FLAG_CANFD = 0x08;
+    public static final int FLAG_BRS = 0x10;
+    public static final int FLAG_ERROR = 0x20;
+
+    private static final int RECORD_LENGTH_OFFSET = 0;
+    private static final int NETID_OFFSET = 4;
+    private static final int TYPE_OFFSET = 6;
+    private static final int FLAGS_OFFSET = 7;
+    private static final int TIMESTAMP_OFFSET = 8;
+    private static final int ARBID_OFFSET = 16;
+    private static final int LENGTH_OFFSET = 20;
+    private static final int STATUS_OFFSET = 24;
+
+    private ByteBuffer buffer;
+    private int remaining;
+    private int position;
+    private int nextPosition;
+
+    /**
+     * Allocates a buffer suitable for icsneojava_getMessagesPacked
+     * @param capacity the size in bytes, it should hold at least one full size frame plus HEADER_SIZE
+     */
+    public static ByteBuffer allocate(int capacity) {
+        return ByteBuffer.allocateDirect(capacity).order(ByteOrder.nativeOrder());
+    }
+
+    /**
+     * Points the reader at a new batch, call next() to move to the first record
+     * @param buffer the buffer passed to icsneojava_getMessagesPacked, its byte order is set to native
+     * @param records the number of records icsneojava_getMessagesPacked returned
+     */
+    public MessageRecordReader reset(ByteBuffer buffer, int records) {
+        this.buffer = buffer;
+        buffer.order(ByteOrder.nativeOrder());
+        remaining = Math.max(records, 0);
+        position = -1;
+        nextPosition = 0;
+        return this;
+    }
+
+    /**
+     * Moves to the next record
+     * @return false once every record in the batch has been visited
+     */
+    public boolean next() {
+        if(remaining == 0)
+            return false;
+        position = nextPosition;
+        nextPosition += buffer.getInt(position + RECORD_LENGTH_OFFSET);
+        remaining--;
+        return true;
+    }
+
+    public int getNetid() {
+        return buffer.getShort(position + NETID_OFFSET) & 0xFFFF;
+    }
+
+    public int getType() {
+        return buffer.get(position + TYPE_OFFSET) & 0xFF;
+    }
+
+    public int getFlags() {
+        return buffer.get(position + FLAGS_OFFSET) & 0xFF;
+    }
+
+    public boolean isTransmitted() {
+        return (getFlags() & FLAG_TRANSMITTED) != 0;
+    }
+
+    public boolean isExtended() {
+        return (getFlags() & FLAG_EXTENDED) != 0;
+    }
+
+    public boolean isCANFD() {
+        return (getFlags() & FLAG_CANFD) != 0;
+    }
+
+    /**
+     * The timestamp in nanoseconds since 1/1/2007. It is unsigned, though it only
+     * reaches the sign bit in the year 2299, so it can be treated as signed.
+     */
+    public long getTimestamp() {
+        return buffer.getLong(position + TIMESTAMP_OFFSET);
+    }
+
+    public long getArbid() {
+        return buffer.getInt(position + ARBID_OFFSET) & 0xFFFFFFFFL;
+    }
+
+    public int getLength() {
+        return buffer.getInt(position + LENGTH_OFFSET);
+    }
+
+    /**
+     * One of the four 32-bit words of the raw neomessage_statusbitfield_t
+     * @param word from 0 to 3
+     */
+    public int getStatus(int word) {
+        return buffer.getInt(position + STATUS_OFFSET + word * 4);
+    }
+
+    public byte getData(int index) {
+        return buffer.get(position + HEADER_SIZE + index);
+    }
+
+    /**
+     * Copies the payload out of the buffer
+     * @param destination where to copy to, it must hold at least getLength() bytes from offset
+     * @param offset where in destination to start
+     * @return the number of bytes copied
+     */
+    public int copyData(byte[] destination, int offset) {
+        int length = getLength();
+        for(int i = 0; i < length; i++)
+            destination[offset + i] = buffer.get(position + HEADER_SIZE + i);
+        return length;
+    }
+
+    /**
+     * Where the payload of the current record starts in the buffer, for reading it in place
+     */
+    public int getDataOffset() {
+        return position + HEADER_SIZE;
+    }
+}
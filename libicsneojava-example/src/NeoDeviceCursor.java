@@ -0,0 +1,151 @@
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.ConcurrentHashMap;
+
+/**
+ * Reads the devices in a native neodevice_t array, as filled by icsneojava.icsneojava_findAllDevices, in place.
+ *
+ * neodevice_t_array_getitem copies each device into a new native allocation owned by a new Java object, and
+ * every getSerial() on it makes a new String. The cursor is a flyweight instead, like NeoMessageCursor, and
+ * serial numbers are decoded the first time they are seen and the same String is returned every time after.
+ * getDevice() still makes a neodevice_t, for the calls which need one, but only for the devices it is called on.
+ *
+ * The cursor is only valid while the array is, do not use it after delete_neodevice_t_array.
+ */
+public class NeoDeviceCursor {
+    private static final int SIZE = icsneojava.ICSNEOJAVA_NEODEVICE_SIZE;
+    private static final int HANDLE_OFFSET = icsneojava.ICSNEOJAVA_NEODEVICE_HANDLE_OFFSET;
+    private static final int TYPE_OFFSET = icsneojava.ICSNEOJAVA_NEODEVICE_TYPE_OFFSET;
+    private static final int SERIAL_OFFSET = icsneojava.ICSNEOJAVA_NEODEVICE_SERIAL_OFFSET;
+    private static final int SERIAL_LENGTH = 7;
+
+    // Decoded serial numbers, by their bytes up to the terminator packed into a long
+    private static final ConcurrentHashMap<Long, String> serials = new ConcurrentHashMap<>();
+
+    private final neodevice_t devices;
+    private final ByteBuffer buffer;
+    private final int capacity;
+    private int count;
+    private int index;
+    private int position;
+
+    /**
+     * @param devices the array, from icsneojava.new_neodevice_t_array
+     * @param capacity the number of devices the array holds
+     */
+    public NeoDeviceCursor(neodevice_t devices, int capacity) {
+        this.devices = devices;
+        this.capacity = capacity;
+        buffer = icsneojava.icsneojava_wrapDevices(devices, capacity).order(ByteOrder.nativeOrder());
+        reset(0);
+    }
+
+    /**
+     * Fills the array with icsneojava_findAllDevices and starts over, call next() to move to the first device
+     * @return the number of devices found
+     */
+    public int findAll() {
+        reset(icsneojava.icsneojava_findAllDevices(devices, capacity));
+        return count;
+    }
+
+    /**
+     * Starts over, call next() to move to the first device
+     * @param count the number of devices in the array
+     */
+    public NeoDeviceCursor reset(int count) {
+        this.count = Math.max(0, Math.min(count, capacity));
+        index = -1;
+        position = -SIZE;
+        return this;
+    }
+
+    /**
+     * Moves to the next device
+     * @return false once every device has been visited
+     */
+    public boolean next() {
+        if(index + 1 >= count)
+            return false;
+        index++;
+        position += SIZE;
+        return true;
+    }
+
+    /**
+     * Moves to a device
+     * @param index from 0 to the count passed to reset()
+     */
+    public NeoDeviceCursor moveTo(int index) {
+        if(index < 0 || index >= count)
+            throw new IndexOutOfBoundsException("Device " + index + " of " + count);
+        this.index = index;
+        position = index * SIZE;
+        return this;
+    }
+
+    public int getIndex() {
+        return index;
+    }
+
+    public int getCount() {
+        return count;
+    }
+
+    public int getHandle() {
+        return buffer.getInt(position + HANDLE_OFFSET);
+    }
+
+    public long getType() {
+        return buffer.getInt(position + TYPE_OFFSET) & 0xFFFFFFFFL;
+    }
+
+    /**
+     * The serial number, the same String for every device with the same serial
+     */
+    public String getSerial() {
+        return internSerial(buffer, position + SERIAL_OFFSET);
+    }
+
+    /**
+     * Compares the serial number without decoding it
+     */
+    public boolean serialEquals(String serial) {
+        return serialEquals(buffer, position + SERIAL_OFFSET, serial);
+    }
+
+    /**
+     * A copy of the device, for the icsneojava functions which take a neodevice_t
+     */
+    public neodevice_t getDevice() {
+        return icsneojava.neodevice_t_array_getitem(devices, index);
+    }
+
+    static String internSerial(ByteBuffer buffer, int offset) {
+        long key = 0;
+        int length = 0;
+        byte b;
+        while(length < SERIAL_LENGTH && (b = buffer.get(offset + length)) != 0) {
+            key |= (b & 0xFFL) << (length * 8);
+            length++;
+        }
+        String serial = serials.get(key);
+        if(serial != null)
+            return serial;
+        byte[] bytes = new byte[length];
+        for(int i = 0; i < length; i++)
+            bytes[i] = buffer.get(offset + i);
+        return serials.computeIfAbsent(key, k -> new String(bytes, StandardCharsets.US_ASCII));
+    }
+
+    static boolean serialEquals(ByteBuffer buffer, int offset, String serial) {
+        if(serial == null || serial.length() > SERIAL_LENGTH)
+            return false;
+        for(int i = 0; i < serial.length(); i++) {
+            if(buffer.get(offset + i) != serial.charAt(i))
+                return false;
+        }
+        return serial.length() == SERIAL_LENGTH || buffer.get(offset + serial.length()) == 0;
+    }
+}
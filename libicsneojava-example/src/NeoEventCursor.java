@@ -0,0 +1,145 @@
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.concurrent.ConcurrentHashMap;
+
+/**
+ * Reads the events in a native neoevent_t array, as filled by icsneojava.icsneojava_getEvents or
+ * icsneojava_getDeviceEvents, in place.
+ *
+ * neoevent_t_array_getitem copies each event into a new native allocation owned by a new Java object, and
+ * every getDescription() on it decodes the description again. The cursor is a flyweight instead, like
+ * NeoMessageCursor. icsneoc describes every event with the same string for its event number, so a description
+ * is decoded the first time its event number is seen and the same String is returned every time after.
+ *
+ * The cursor is only valid while the array is, do not use it after delete_neoevent_t_array.
+ */
+public class NeoEventCursor {
+    private static final int SIZE = icsneojava.ICSNEOJAVA_NEOEVENT_SIZE;
+    private static final int TIMESTAMP_OFFSET = icsneojava.ICSNEOJAVA_NEOEVENT_TIMESTAMP_OFFSET;
+    private static final int TIMESTAMP_SIZE = icsneojava.ICSNEOJAVA_NEOEVENT_TIMESTAMP_SIZE;
+    private static final int EVENTNUMBER_OFFSET = icsneojava.ICSNEOJAVA_NEOEVENT_EVENTNUMBER_OFFSET;
+    private static final int SEVERITY_OFFSET = icsneojava.ICSNEOJAVA_NEOEVENT_SEVERITY_OFFSET;
+    private static final int SERIAL_OFFSET = icsneojava.ICSNEOJAVA_NEOEVENT_SERIAL_OFFSET;
+
+    private static final ConcurrentHashMap<Integer, String> descriptions = new ConcurrentHashMap<>();
+
+    private final neoevent_t events;
+    private final ByteBuffer buffer;
+    private final int capacity;
+    private int count;
+    private int index;
+    private int position;
+
+    /**
+     * @param events the array, from icsneojava.new_neoevent_t_array
+     * @param capacity the number of events the array holds
+     */
+    public NeoEventCursor(neoevent_t events, int capacity) {
+        this.events = events;
+        this.capacity = capacity;
+        buffer = icsneojava.icsneojava_wrapEvents(events, capacity).order(ByteOrder.nativeOrder());
+        reset(0);
+    }
+
+    /**
+     * Fills the array with icsneojava_getEvents, which takes the API events from icsneoc, and starts over
+     * @return the number of events, or -1 if they could not be read
+     */
+    public int getEvents() {
+        int result = icsneojava.icsneojava_getEvents(events, capacity);
+        reset(result);
+        return result;
+    }
+
+    /**
+     * Fills the array with icsneojava_getDeviceEvents and starts over
+     * @return the number of events, or -1 if they could not be read
+     */
+    public int getDeviceEvents(neodevice_t device) {
+        int result = icsneojava.icsneojava_getDeviceEvents(device, events, capacity);
+        reset(result);
+        return result;
+    }
+
+    /**
+     * Starts over, call next() to move to the first event
+     * @param count the number of events in the array
+     */
+    public NeoEventCursor reset(int count) {
+        this.count = Math.max(0, Math.min(count, capacity));
+        index = -1;
+        position = -SIZE;
+        return this;
+    }
+
+    /**
+     * Moves to the next event
+     * @return false once every event has been visited
+     */
+    public boolean next() {
+        if(index + 1 >= count)
+            return false;
+        index++;
+        position += SIZE;
+        return true;
+    }
+
+    /**
+     * Moves to an event
+     * @param index from 0 to the count passed to reset()
+     */
+    public NeoEventCursor moveTo(int index) {
+        if(index < 0 || index >= count)
+            throw new IndexOutOfBoundsException("Event " + index + " of " + count);
+        this.index = index;
+        position = index * SIZE;
+        return this;
+    }
+
+    public int getIndex() {
+        return index;
+    }
+
+    public int getCount() {
+        return count;
+    }
+
+    public int getEventNumber() {
+        return buffer.getInt(position + EVENTNUMBER_OFFSET);
+    }
+
+    public int getSeverity() {
+        return buffer.get(position + SEVERITY_OFFSET) & 0xFF;
+    }
+
+    /**
+     * When the event happened, as a time_t
+     */
+    public long getTimestamp() {
+        if(TIMESTAMP_SIZE == 8)
+            return buffer.getLong(position + TIMESTAMP_OFFSET);
+        return buffer.getInt(position + TIMESTAMP_OFFSET);
+    }
+
+    /**
+     * The description, the same String for every event with the same event number
+     */
+    public String getDescription() {
+        int eventNumber = getEventNumber();
+        String description = descriptions.get(eventNumber);
+        if(description != null)
+            return description;
+        description = icsneojava.icsneojava_getEventDescription(events, index);
+        if(description == null)
+            return null;
+        String existing = descriptions.putIfAbsent(eventNumber, description);
+        return existing != null ? existing : description;
+    }
+
+    /**
+     * The serial number of the device the event is for, empty for API events
+     */
+    public String getSerial() {
+        return NeoDeviceCursor.internSerial(buffer, position + SERIAL_OFFSET);
+    }
+}
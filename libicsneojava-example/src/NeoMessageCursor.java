@@ -0,0 +1,151 @@
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * Reads the messages in a native neomessage_t array, as filled by icsneojava.icsneo_getMessages, in place.
+ *
+ * neomessage_t_array_getitem copies each message into a new native allocation owned by a new Java object.
+ * The cursor is a flyweight instead, it points at one message at a time and reads its fields straight out of
+ * the array, so going through a batch creates no objects. Create one cursor per array and reuse it for every poll.
+ *
+ * The cursor is only valid while the array is, do not use it after delete_neomessage_t_array.
+ */
+public class NeoMessageCursor {
+    private static final int SIZE = icsneojava.ICSNEOJAVA_NEOMESSAGE_SIZE;
+    private static final int STATUS_OFFSET = icsneojava.ICSNEOJAVA_NEOMESSAGE_STATUS_OFFSET;
+    private static final int TIMESTAMP_OFFSET = icsneojava.ICSNEOJAVA_NEOMESSAGE_TIMESTAMP_OFFSET;
+    private static final int LENGTH_OFFSET = icsneojava.ICSNEOJAVA_NEOMESSAGE_LENGTH_OFFSET;
+    private static final int LENGTH_SIZE = icsneojava.ICSNEOJAVA_NEOMESSAGE_LENGTH_SIZE;
+    private static final int NETID_OFFSET = icsneojava.ICSNEOJAVA_NEOMESSAGE_NETID_OFFSET;
+    private static final int TYPE_OFFSET = icsneojava.ICSNEOJAVA_NEOMESSAGE_TYPE_OFFSET;
+    private static final int ARBID_OFFSET = icsneojava.ICSNEOJAVA_NEOMESSAGE_CAN_ARBID_OFFSET;
+
+    // Bits of the first word of neomessage_statusbitfield_t
+    private static final int STATUS_GLOBAL_ERROR = 0x01;
+    private static final int STATUS_TRANSMIT_MESSAGE = 0x02;
+    private static final int STATUS_EXTENDED_FRAME = 0x04;
+    private static final int STATUS_REMOTE_FRAME = 0x08;
+
+    private final neomessage_t messages;
+    private final ByteBuffer buffer;
+    private final int capacity;
+    private int count;
+    private int index;
+    private int position;
+
+    /**
+     * @param messages the array, from icsneojava.new_neomessage_t_array
+     * @param capacity the number of messages the array holds
+     */
+    public NeoMessageCursor(neomessage_t messages, int capacity) {
+        this.messages = messages;
+        this.capacity = capacity;
+        buffer = icsneojava.icsneojava_wrapMessages(messages, capacity).order(ByteOrder.nativeOrder());
+        reset(0);
+    }
+
+    /**
+     * Starts over after a poll, call next() to move to the first message
+     * @param count the number of messages icsneo_getMessages returned
+     */
+    public NeoMessageCursor reset(int count) {
+        this.count = Math.max(0, Math.min(count, capacity));
+        index = -1;
+        position = -SIZE;
+        return this;
+    }
+
+    /**
+     * Moves to the next message
+     * @return false once every message has been visited
+     */
+    public boolean next() {
+        if(index + 1 >= count)
+            return false;
+        index++;
+        position += SIZE;
+        return true;
+    }
+
+    /**
+     * Moves to a message
+     * @param index from 0 to the count passed to reset()
+     */
+    public NeoMessageCursor moveTo(int index) {
+        if(index < 0 || index >= count)
+            throw new IndexOutOfBoundsException("Message " + index + " of " + count);
+        this.index = index;
+        position = index * SIZE;
+        return this;
+    }
+
+    public int getIndex() {
+        return index;
+    }
+
+    public int getNetid() {
+        return buffer.getShort(position + NETID_OFFSET) & 0xFFFF;
+    }
+
+    public int getType() {
+        return buffer.get(position + TYPE_OFFSET) & 0xFF;
+    }
+
+    /**
+     * The timestamp in nanoseconds since 1/1/2007. It is unsigned, though it only
+     * reaches the sign bit in the year 2299, so it can be treated as signed.
+     */
+    public long getTimestamp() {
+        return buffer.getLong(position + TIMESTAMP_OFFSET);
+    }
+
+    public int getLength() {
+        if(LENGTH_SIZE == 8)
+            return (int) buffer.getLong(position + LENGTH_OFFSET);
+        return buffer.getInt(position + LENGTH_OFFSET);
+    }
+
+    /**
+     * The arbitration ID, only meaningful when getType() is ICSNEO_NETWORK_TYPE_CAN
+     */
+    public long getArbid() {
+        return buffer.getInt(position + ARBID_OFFSET) & 0xFFFFFFFFL;
+    }
+
+    /**
+     * One of the four 32-bit words of the raw neomessage_statusbitfield_t
+     * @param word from 0 to 3
+     */
+    public int getStatus(int word) {
+        return buffer.getInt(position + STATUS_OFFSET + word * 4);
+    }
+
+    public boolean isGlobalError() {
+        return (getStatus(0) & STATUS_GLOBAL_ERROR) != 0;
+    }
+
+    public boolean isTransmitted() {
+        return (getStatus(0) & STATUS_TRANSMIT_MESSAGE) != 0;
+    }
+
+    public boolean isExtended() {
+        return (getStatus(0) & STATUS_EXTENDED_FRAME) != 0;
+    }
+
+    public boolean isRemote() {
+        return (getStatus(0) & STATUS_REMOTE_FRAME) != 0;
+    }
+
+    /**
+     * Copies the payload, which lives outside of the array, with a single JNI call
+     * @param destination where to copy to, it must hold at least getLength() bytes from offset
+     * @param offset where in destination to start
+     * @return the number of bytes copied, or -1 if they did not fit
+     * @throws IndexOutOfBoundsException if the cursor is not on a message, such as before the first next()
+     */
+    public int copyData(byte[] destination, int offset) {
+        if(index < 0 || index >= count)
+            throw new IndexOutOfBoundsException("Message " + index + " of " + count);
+        return icsneojava.icsneojava_copyMessageData(messages, capacity, index, destination, offset);
+    }
+}
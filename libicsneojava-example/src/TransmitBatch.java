@@ -0,0 +1,73 @@
+/**
+ * Collects CAN frames into parallel primitive arrays and transmits them all with a single
+ * icsneojava.icsneojava_transmitMessages call.
+ *
+ * Building a neomessage_can_t for each frame takes a native allocation and a JNI call per field. A batch
+ * only writes into its arrays, so adding frames creates no objects. Create one batch and clear() it
+ * between sends rather than creating one per send.
+ */
+public class TransmitBatch {
+    private final int[] netids;
+    private final int[] arbids;
+    private final int[] flags;
+    private final int[] lengths;
+    private final byte[] payload;
+    private int count;
+    private int payloadUsed;
+
+    /**
+     * @param maxFrames the number of frames the batch holds
+     * @param maxPayloadBytes the total payload of those frames, 64 bytes per frame covers CAN FD
+     */
+    public TransmitBatch(int maxFrames, int maxPayloadBytes) {
+        netids = new int[maxFrames];
+        arbids = new int[maxFrames];
+        flags = new int[maxFrames];
+        lengths = new int[maxFrames];
+        payload = new byte[maxPayloadBytes];
+    }
+
+    /**
+     * Adds a frame to the batch
+     * @param netid the network to send on, such as icsneojava.ICSNEO_NETID_HSCAN
+     * @param arbid the arbitration ID
+     * @param flags MessageRecordReader.FLAG_EXTENDED, FLAG_REMOTE, FLAG_CANFD and FLAG_BRS, or 0
+     * @param data the array holding the payload
+     * @param offset where in data the payload starts
+     * @param length the payload length
+     * @return false if the batch is full, in which case nothing was added
+     */
+    public boolean add(int netid, int arbid, int flags, byte[] data, int offset, int length) {
+        if(count == netids.length || length > payload.length - payloadUsed)
+            return false;
+        netids[count] = netid;
+        arbids[count] = arbid;
+        this.flags[count] = flags;
+        lengths[count] = length;
+        System.arraycopy(data, offset, payload, payloadUsed, length);
+        payloadUsed += length;
+        count++;
+        return true;
+    }
+
+    public int size() {
+        return count;
+    }
+
+    /**
+     * Removes every frame, so the batch can be filled again
+     */
+    public TransmitBatch clear() {
+        count = 0;
+        payloadUsed = 0;
+        return this;
+    }
+
+    /**
+     * Queues every frame in the batch for transmit. The batch is left as it is, call clear() to start a new one.
+     * @return false if the frames could not be queued, see icsneo_getLastError
+     */
+    public boolean transmit(neodevice_t device) {
+        return icsneojava.icsneojava_transmitMessages(device, netids, arbids, flags, lengths, payload, count);
+    }
+}
@@ -64,7 +64,7 @@ public class icsneojava implements icsneojavaConstants {
     return icsneojavaJNI.icsneo_isMessagePollingEnabled(neodevice_t.getCPtr(device), device);
   }
 
-  public static boolean icsneo_getMessages(neodevice_t device, neomessage_t messages, int[] items, java.math.BigInteger timeout) {
+  public static boolean icsneo_getMessages(neodevice_t device, neomessage_t messages, int[] items, long timeout) {
     return icsneojavaJNI.icsneo_getMessages(neodevice_t.getCPtr(device), device, neomessage_t.getCPtr(messages), messages, items, timeout);
   }
 
@@ -259,4 +259,111 @@ public class icsneojava implements icsneojavaConstants {
     icsneojavaJNI.neomessage_t_array_setitem(neomessage_t.getCPtr(ary), ary, index, neomessage_t.getCPtr(value), value);
   }
 
+  public static SWIGTYPE_p_icsneojava_poller_t icsneojava_newPoller(long maxMessages) {
+    long cPtr = icsneojavaJNI.icsneojava_newPoller(maxMessages);
+    return (cPtr == 0) ? null : new SWIGTYPE_p_icsneojava_poller_t(cPtr, false);
+  }
+
+  public static void icsneojava_deletePoller(SWIGTYPE_p_icsneojava_poller_t poller) {
+    icsneojavaJNI.icsneojava_deletePoller(SWIGTYPE_p_icsneojava_poller_t.getCPtr(poller));
+  }
+
+  public static int icsneojava_clearPoller(SWIGTYPE_p_icsneojava_poller_t poller) {
+    return icsneojavaJNI.icsneojava_clearPoller(SWIGTYPE_p_icsneojava_poller_t.getCPtr(poller));
+  }
+
+  public static int icsneojava_getMessagesPacked(SWIGTYPE_p_icsneojava_poller_t poller, neodevice_t device, java.nio.ByteBuffer records, long capacity, long timeout) {
+    return icsneojavaJNI.icsneojava_getMessagesPacked(SWIGTYPE_p_icsneojava_poller_t.getCPtr(poller), neodevice_t.getCPtr(device), device, records, capacity, timeout);
+  }
+
+  public static SWIGTYPE_p_icsneojava_listener_t icsneojava_addMessageListener(neodevice_t device, MessageListener listener, long batchSize, long maxDelayMicroseconds) {
+    long cPtr = icsneojavaJNI.icsneojava_addMessageListener(neodevice_t.getCPtr(device), device, listener, batchSize, maxDelayMicroseconds);
+    return (cPtr == 0) ? null : new SWIGTYPE_p_icsneojava_listener_t(cPtr, false);
+  }
+
+  public static boolean icsneojava_removeMessageListener(SWIGTYPE_p_icsneojava_listener_t listener) {
+    return icsneojavaJNI.icsneojava_removeMessageListener(SWIGTYPE_p_icsneojava_listener_t.getCPtr(listener));
+  }
+
+  public static long icsneojava_getMessageListenerDropped(SWIGTYPE_p_icsneojava_listener_t listener) {
+    return icsneojavaJNI.icsneojava_getMessageListenerDropped(SWIGTYPE_p_icsneojava_listener_t.getCPtr(listener));
+  }
+
+  public static java.nio.ByteBuffer icsneojava_wrapMessages(neomessage_t messages, long count) {
+    return icsneojavaJNI.icsneojava_wrapMessages(neomessage_t.getCPtr(messages), messages, count);
+  }
+
+  public static int icsneojava_copyMessageData(neomessage_t messages, long capacity, long index, byte[] destination, int offset) {
+    return icsneojavaJNI.icsneojava_copyMessageData(neomessage_t.getCPtr(messages), messages, capacity, index, destination, offset);
+  }
+
+  public static java.nio.ByteBuffer icsneojava_wrapDevices(neodevice_t devices, long count) {
+    return icsneojavaJNI.icsneojava_wrapDevices(neodevice_t.getCPtr(devices), devices, count);
+  }
+
+  public static java.nio.ByteBuffer icsneojava_wrapEvents(neoevent_t events, long count) {
+    return icsneojavaJNI.icsneojava_wrapEvents(neoevent_t.getCPtr(events), events, count);
+  }
+
+  public static int icsneojava_findAllDevices(neodevice_t devices, int capacity) {
+    return icsneojavaJNI.icsneojava_findAllDevices(neodevice_t.getCPtr(devices), devices, capacity);
+  }
+
+  public static int icsneojava_getEvents(neoevent_t events, int capacity) {
+    return icsneojavaJNI.icsneojava_getEvents(neoevent_t.getCPtr(events), events, capacity);
+  }
+
+  public static int icsneojava_getDeviceEvents(neodevice_t device, neoevent_t events, int capacity) {
+    return icsneojavaJNI.icsneojava_getDeviceEvents(neodevice_t.getCPtr(device), device, neoevent_t.getCPtr(events), events, capacity);
+  }
+
+  public static String icsneojava_getEventDescription(neoevent_t events, long index) {
+    return icsneojavaJNI.icsneojava_getEventDescription(neoevent_t.getCPtr(events), events, index);
+  }
+
+  public static SWIGTYPE_p_icsneojava_filter_t icsneojava_newFilter() {
+    long cPtr = icsneojavaJNI.icsneojava_newFilter();
+    return (cPtr == 0) ? null : new SWIGTYPE_p_icsneojava_filter_t(cPtr, false);
+  }
+
+  public static void icsneojava_deleteFilter(SWIGTYPE_p_icsneojava_filter_t filter) {
+    icsneojavaJNI.icsneojava_deleteFilter(SWIGTYPE_p_icsneojava_filter_t.getCPtr(filter));
+  }
+
+  public static void icsneojava_clearFilter(SWIGTYPE_p_icsneojava_filter_t filter) {
+    icsneojavaJNI.icsneojava_clearFilter(SWIGTYPE_p_icsneojava_filter_t.getCPtr(filter));
+  }
+
+  public static boolean icsneojava_filterAddNetid(SWIGTYPE_p_icsneojava_filter_t filter, int netid) {
+    return icsneojavaJNI.icsneojava_filterAddNetid(SWIGTYPE_p_icsneojava_filter_t.getCPtr(filter), netid);
+  }
+
+  public static boolean icsneojava_filterAddType(SWIGTYPE_p_icsneojava_filter_t filter, int type) {
+    return icsneojavaJNI.icsneojava_filterAddType(SWIGTYPE_p_icsneojava_filter_t.getCPtr(filter), type);
+  }
+
+  public static boolean icsneojava_filterAddArbidRange(SWIGTYPE_p_icsneojava_filter_t filter, long low, long high, long mask) {
+    return icsneojavaJNI.icsneojava_filterAddArbidRange(SWIGTYPE_p_icsneojava_filter_t.getCPtr(filter), low, high, mask);
+  }
+
+  public static boolean icsneojava_getMessagesFiltered(neodevice_t device, SWIGTYPE_p_icsneojava_filter_t filter, neomessage_t messages, int[] items, long timeout) {
+    return icsneojavaJNI.icsneojava_getMessagesFiltered(neodevice_t.getCPtr(device), device, SWIGTYPE_p_icsneojava_filter_t.getCPtr(filter), neomessage_t.getCPtr(messages), messages, items, timeout);
+  }
+
+  public static boolean icsneojava_setPollerFilter(SWIGTYPE_p_icsneojava_poller_t poller, SWIGTYPE_p_icsneojava_filter_t filter) {
+    return icsneojavaJNI.icsneojava_setPollerFilter(SWIGTYPE_p_icsneojava_poller_t.getCPtr(poller), SWIGTYPE_p_icsneojava_filter_t.getCPtr(filter));
+  }
+
+  public static boolean icsneojava_setMessageListenerFilter(SWIGTYPE_p_icsneojava_listener_t listener, SWIGTYPE_p_icsneojava_filter_t filter) {
+    return icsneojavaJNI.icsneojava_setMessageListenerFilter(SWIGTYPE_p_icsneojava_listener_t.getCPtr(listener), SWIGTYPE_p_icsneojava_filter_t.getCPtr(filter));
+  }
+
+  public static boolean icsneojava_transmitMessages(neodevice_t device, int[] netids, int[] arbids, int[] flags, int[] lengths, byte[] payload, int count) {
+    return icsneojavaJNI.icsneojava_transmitMessages(neodevice_t.getCPtr(device), device, netids, arbids, flags, lengths, payload, count);
+  }
+
+  public static boolean icsneojava_transmitMessagesDirect(neodevice_t device, int[] netids, int[] arbids, int[] flags, int[] lengths, java.nio.ByteBuffer buffer, long capacity, int count) {
+    return icsneojavaJNI.icsneojava_transmitMessagesDirect(neodevice_t.getCPtr(device), device, netids, arbids, flags, lengths, buffer, capacity, count);
+  }
+
 }
@@ -118,4 +118,22 @@ public interface icsneojavaConstants {
   public final static int ICSNEO_NETWORK_TYPE_ETHERNET = icsneojavaJNI.ICSNEO_NETWORK_TYPE_ETHERNET_get();
   public final static int ICSNEO_NETWORK_TYPE_ANY = icsneojavaJNI.ICSNEO_NETWORK_TYPE_ANY_get();
   public final static int ICSNEO_NETWORK_TYPE_OTHER = icsneojavaJNI.ICSNEO_NETWORK_TYPE_OTHER_get();
+  public final static int ICSNEOJAVA_NEOMESSAGE_SIZE = icsneojavaJNI.ICSNEOJAVA_NEOMESSAGE_SIZE_get();
+  public final static int ICSNEOJAVA_NEOMESSAGE_STATUS_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEOMESSAGE_STATUS_OFFSET_get();
+  public final static int ICSNEOJAVA_NEOMESSAGE_TIMESTAMP_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEOMESSAGE_TIMESTAMP_OFFSET_get();
+  public final static int ICSNEOJAVA_NEOMESSAGE_LENGTH_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEOMESSAGE_LENGTH_OFFSET_get();
+  public final static int ICSNEOJAVA_NEOMESSAGE_LENGTH_SIZE = icsneojavaJNI.ICSNEOJAVA_NEOMESSAGE_LENGTH_SIZE_get();
+  public final static int ICSNEOJAVA_NEOMESSAGE_NETID_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEOMESSAGE_NETID_OFFSET_get();
+  public final static int ICSNEOJAVA_NEOMESSAGE_TYPE_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEOMESSAGE_TYPE_OFFSET_get();
+  public final static int ICSNEOJAVA_NEOMESSAGE_CAN_ARBID_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEOMESSAGE_CAN_ARBID_OFFSET_get();
+  public final static int ICSNEOJAVA_NEODEVICE_SIZE = icsneojavaJNI.ICSNEOJAVA_NEODEVICE_SIZE_get();
+  public final static int ICSNEOJAVA_NEODEVICE_HANDLE_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEODEVICE_HANDLE_OFFSET_get();
+  public final static int ICSNEOJAVA_NEODEVICE_TYPE_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEODEVICE_TYPE_OFFSET_get();
+  public final static int ICSNEOJAVA_NEODEVICE_SERIAL_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEODEVICE_SERIAL_OFFSET_get();
+  public final static int ICSNEOJAVA_NEOEVENT_SIZE = icsneojavaJNI.ICSNEOJAVA_NEOEVENT_SIZE_get();
+  public final static int ICSNEOJAVA_NEOEVENT_TIMESTAMP_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEOEVENT_TIMESTAMP_OFFSET_get();
+  public final static int ICSNEOJAVA_NEOEVENT_TIMESTAMP_SIZE = icsneojavaJNI.ICSNEOJAVA_NEOEVENT_TIMESTAMP_SIZE_get();
+  public final static int ICSNEOJAVA_NEOEVENT_EVENTNUMBER_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEOEVENT_EVENTNUMBER_OFFSET_get();
+  public final static int ICSNEOJAVA_NEOEVENT_SEVERITY_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEOEVENT_SEVERITY_OFFSET_get();
+  public final static int ICSNEOJAVA_NEOEVENT_SERIAL_OFFSET = icsneojavaJNI.ICSNEOJAVA_NEOEVENT_SERIAL_OFFSET_get();
 }
@@ -22,7 +22,7 @@ public class icsneojavaJNI {
   public final static native boolean icsneo_enableMessagePolling(long jarg1, neodevice_t jarg1_);
   public final static native boolean icsneo_disableMessagePolling(long jarg1, neodevice_t jarg1_);
   public final static native boolean icsneo_isMessagePollingEnabled(long jarg1, neodevice_t jarg1_);
-  public final static native boolean icsneo_getMessages(long jarg1, neodevice_t jarg1_, long jarg2, neomessage_t jarg2_, int[] jarg3, java.math.BigInteger jarg4);
+  public final static native boolean icsneo_getMessages(long jarg1, neodevice_t jarg1_, long jarg2, neomessage_t jarg2_, int[] jarg3, long jarg4);
   public final static native long icsneo_getPollingMessageLimit(long jarg1, neodevice_t jarg1_);
   public final static native boolean icsneo_setPollingMessageLimit(long jarg1, neodevice_t jarg1_, long jarg2);
   public final static native boolean icsneo_getProductName(long jarg1, neodevice_t jarg1_, StringBuffer jarg2, int[] jarg3);
@@ -179,10 +179,10 @@ public class icsneojavaJNI {
   public final static native void delete_neomessage_statusbitfield_t(long jarg1);
   public final static native void neomessage_t_status_set(long jarg1, neomessage_t jarg1_, long jarg2, neomessage_statusbitfield_t jarg2_);
   public final static native long neomessage_t_status_get(long jarg1, neomessage_t jarg1_);
-  public final static native void neomessage_t_timestamp_set(long jarg1, neomessage_t jarg1_, java.math.BigInteger jarg2);
-  public final static native java.math.BigInteger neomessage_t_timestamp_get(long jarg1, neomessage_t jarg1_);
-  public final static native void neomessage_t_timestampReserved_set(long jarg1, neomessage_t jarg1_, java.math.BigInteger jarg2);
-  public final static native java.math.BigInteger neomessage_t_timestampReserved_get(long jarg1, neomessage_t jarg1_);
+  public final static native void neomessage_t_timestamp_set(long jarg1, neomessage_t jarg1_, long jarg2);
+  public final static native long neomessage_t_timestamp_get(long jarg1, neomessage_t jarg1_);
+  public final static native void neomessage_t_timestampReserved_set(long jarg1, neomessage_t jarg1_, long jarg2);
+  public final static native long neomessage_t_timestampReserved_get(long jarg1, neomessage_t jarg1_);
   public final static native void neomessage_t_data_set(long jarg1, neomessage_t jarg1_, byte[] jarg2);
   public final static native byte[] neomessage_t_data_get(long jarg1, neomessage_t jarg1_);
   public final static native void neomessage_t_length_set(long jarg1, neomessage_t jarg1_, long jarg2);
@@ -199,10 +199,10 @@ public class icsneojavaJNI {
   public final static native void delete_neomessage_t(long jarg1);
   public final static native void neomessage_can_t_status_set(long jarg1, neomessage_can_t jarg1_, long jarg2, neomessage_statusbitfield_t jarg2_);
   public final static native long neomessage_can_t_status_get(long jarg1, neomessage_can_t jarg1_);
-  public final static native void neomessage_can_t_timestamp_set(long jarg1, neomessage_can_t jarg1_, java.math.BigInteger jarg2);
-  public final static native java.math.BigInteger neomessage_can_t_timestamp_get(long jarg1, neomessage_can_t jarg1_);
-  public final static native void neomessage_can_t_timestampReserved_set(long jarg1, neomessage_can_t jarg1_, java.math.BigInteger jarg2);
-  public final static native java.math.BigInteger neomessage_can_t_timestampReserved_get(long jarg1, neomessage_can_t jarg1_);
+  public final static native void neomessage_can_t_timestamp_set(long jarg1, neomessage_can_t jarg1_, long jarg2);
+  public final static native long neomessage_can_t_timestamp_get(long jarg1, neomessage_can_t jarg1_);
+  public final static native void neomessage_can_t_timestampReserved_set(long jarg1, neomessage_can_t jarg1_, long jarg2);
+  public final static native long neomessage_can_t_timestampReserved_get(long jarg1, neomessage_can_t jarg1_);
   public final static native void neomessage_can_t_data_set(long jarg1, neomessage_can_t jarg1_, byte[] jarg2);
   public final static native byte[] neomessage_can_t_data_get(long jarg1, neomessage_can_t jarg1_);
   public final static native void neomessage_can_t_length_set(long jarg1, neomessage_can_t jarg1_, long jarg2);
@@ -221,10 +221,10 @@ public class icsneojavaJNI {
   public final static native void delete_neomessage_can_t(long jarg1);
   public final static native void neomessage_eth_t_status_set(long jarg1, neomessage_eth_t jarg1_, long jarg2, neomessage_statusbitfield_t jarg2_);
   public final static native long neomessage_eth_t_status_get(long jarg1, neomessage_eth_t jarg1_);
-  public final static native void neomessage_eth_t_timestamp_set(long jarg1, neomessage_eth_t jarg1_, java.math.BigInteger jarg2);
-  public final static native java.math.BigInteger neomessage_eth_t_timestamp_get(long jarg1, neomessage_eth_t jarg1_);
-  public final static native void neomessage_eth_t_timestampReserved_set(long jarg1, neomessage_eth_t jarg1_, java.math.BigInteger jarg2);
-  public final static native java.math.BigInteger neomessage_eth_t_timestampReserved_get(long jarg1, neomessage_eth_t jarg1_);
+  public final static native void neomessage_eth_t_timestamp_set(long jarg1, neomessage_eth_t jarg1_, long jarg2);
+  public final static native long neomessage_eth_t_timestamp_get(long jarg1, neomessage_eth_t jarg1_);
+  public final static native void neomessage_eth_t_timestampReserved_set(long jarg1, neomessage_eth_t jarg1_, long jarg2);
+  public final static native long neomessage_eth_t_timestampReserved_get(long jarg1, neomessage_eth_t jarg1_);
   public final static native void neomessage_eth_t_data_set(long jarg1, neomessage_eth_t jarg1_, byte[] jarg2);
   public final static native byte[] neomessage_eth_t_data_get(long jarg1, neomessage_eth_t jarg1_);
   public final static native void neomessage_eth_t_length_set(long jarg1, neomessage_eth_t jarg1_, long jarg2);
@@ -397,4 +397,48 @@ public class icsneojavaJNI {
   public final static native void delete_neomessage_t_array(long jarg1, neomessage_t jarg1_);
   public final static native long neomessage_t_array_getitem(long jarg1, neomessage_t jarg1_, int jarg2);
   public final static native void neomessage_t_array_setitem(long jarg1, neomessage_t jarg1_, int jarg2, long jarg3, neomessage_t jarg3_);
+  public final static native long icsneojava_newPoller(long jarg1);
+  public final static native void icsneojava_deletePoller(long jarg1);
+  public final static native int icsneojava_clearPoller(long jarg1);
+  public final static native int icsneojava_getMessagesPacked(long jarg2, long jarg3, neodevice_t jarg3_, java.nio.ByteBuffer jarg4, long jarg5, long jarg6);
+  public final static native long icsneojava_addMessageListener(long jarg2, neodevice_t jarg2_, MessageListener jarg3, long jarg4, long jarg5);
+  public final static native boolean icsneojava_removeMessageListener(long jarg2);
+  public final static native long icsneojava_getMessageListenerDropped(long jarg1);
+  public final static native int ICSNEOJAVA_NEOMESSAGE_SIZE_get();
+  public final static native int ICSNEOJAVA_NEOMESSAGE_STATUS_OFFSET_get();
+  public final static native int ICSNEOJAVA_NEOMESSAGE_TIMESTAMP_OFFSET_get();
+  public final static native int ICSNEOJAVA_NEOMESSAGE_LENGTH_OFFSET_get();
+  public final static native int ICSNEOJAVA_NEOMESSAGE_LENGTH_SIZE_get();
+  public final static native int ICSNEOJAVA_NEOMESSAGE_NETID_OFFSET_get();
+  public final static native int ICSNEOJAVA_NEOMESSAGE_TYPE_OFFSET_get();
+  public final static native int ICSNEOJAVA_NEOMESSAGE_CAN_ARBID_OFFSET_get();
+  public final static native java.nio.ByteBuffer icsneojava_wrapMessages(long jarg2, neomessage_t jarg2_, long jarg3);
+  public final static native int icsneojava_copyMessageData(long jarg2, neomessage_t jarg2_, long jarg3, long jarg4, byte[] jarg5, int jarg6);
+  public final static native int ICSNEOJAVA_NEODEVICE_SIZE_get();
+  public final static native int ICSNEOJAVA_NEODEVICE_HANDLE_OFFSET_get();
+  public final static native int ICSNEOJAVA_NEODEVICE_TYPE_OFFSET_get();
+  public final static native int ICSNEOJAVA_NEODEVICE_SERIAL_OFFSET_get();
+  public final static native int ICSNEOJAVA_NEOEVENT_SIZE_get();
+  public final static native int ICSNEOJAVA_NEOEVENT_TIMESTAMP_OFFSET_get();
+  public final static native int ICSNEOJAVA_NEOEVENT_TIMESTAMP_SIZE_get();
+  public final static native int ICSNEOJAVA_NEOEVENT_EVENTNUMBER_OFFSET_get();
+  public final static native int ICSNEOJAVA_NEOEVENT_SEVERITY_OFFSET_get();
+  public final static native int ICSNEOJAVA_NEOEVENT_SERIAL_OFFSET_get();
+  public final static native java.nio.ByteBuffer icsneojava_wrapDevices(long jarg2, neodevice_t jarg2_, long jarg3);
+  public final static native java.nio.ByteBuffer icsneojava_wrapEvents(long jarg2, neoevent_t jarg2_, long jarg3);
+  public final static native int icsneojava_findAllDevices(long jarg1, neodevice_t jarg1_, int jarg2);
+  public final static native int icsneojava_getEvents(long jarg1, neoevent_t jarg1_, int jarg2);
+  public final static native int icsneojava_getDeviceEvents(long jarg1, neodevice_t jarg1_, long jarg2, neoevent_t jarg2_, int jarg3);
+  public final static native String icsneojava_getEventDescription(long jarg1, neoevent_t jarg1_, long jarg2);
+  public final static native long icsneojava_newFilter();
+  public final static native void icsneojava_deleteFilter(long jarg1);
+  public final static native void icsneojava_clearFilter(long jarg1);
+  public final static native boolean icsneojava_filterAddNetid(long jarg1, int jarg2);
+  public final static native boolean icsneojava_filterAddType(long jarg1, int jarg2);
+  public final static native boolean icsneojava_filterAddArbidRange(long jarg1, long jarg2, long jarg3, long jarg4);
+  public final static native boolean icsneojava_getMessagesFiltered(long jarg1, neodevice_t jarg1_, long jarg2, long jarg3, neomessage_t jarg3_, int[] jarg4, long jarg5);
+  public final static native boolean icsneojava_setPollerFilter(long jarg1, long jarg2);
+  public final static native boolean icsneojava_setMessageListenerFilter(long jarg1, long jarg2);
+  public final static native boolean icsneojava_transmitMessages(long jarg2, neodevice_t jarg2_, int[] jarg3, int[] jarg4, int[] jarg5, int[] jarg6, byte[] jarg7, int jarg8);
+  public final static native boolean icsneojava_transmitMessagesDirect(long jarg2, neodevice_t jarg2_, int[] jarg3, int[] jarg4, int[] jarg5, int[] jarg6, java.nio.ByteBuffer jarg7, long jarg8, int jarg9);
 }
@@ -44,19 +44,19 @@ public class neomessage_can_t {
     return (cPtr == 0) ? null : new neomessage_statusbitfield_t(cPtr, false);
   }
 
-  public void setTimestamp(java.math.BigInteger value) {
+  public void setTimestamp(long value) {
     icsneojavaJNI.neomessage_can_t_timestamp_set(swigCPtr, this, value);
   }
 
-  public java.math.BigInteger getTimestamp() {
+  public long getTimestamp() {
     return icsneojavaJNI.neomessage_can_t_timestamp_get(swigCPtr, this);
   }
 
-  public void setTimestampReserved(java.math.BigInteger value) {
+  public void setTimestampReserved(long value) {
     icsneojavaJNI.neomessage_can_t_timestampReserved_set(swigCPtr, this, value);
   }
 
-  public java.math.BigInteger getTimestampReserved() {
+  public long getTimestampReserved() {
     return icsneojavaJNI.neomessage_can_t_timestampReserved_get(swigCPtr, this);
   }
 
@@ -0,0 +1,442 @@
+/*
+ * A stand-in for libicsneo's icsneoc with a single simulated CAN device, so the Java and C# bindings can be
+ * exercised and benchmarked without hardware. Build either binding with -DICSNEOJAVA_SIMULATED_DEVICE=ON or
+ * -DICSNEOCSHARP_SIMULATED_DEVICE=ON to link against it, see their READMEs.
+ *
+ * Every poll returns up to ICSNEOSIM_MESSAGES_PER_POLL (default 100) classic CAN frames on HS CAN, with their
+ * data in a buffer which stays valid until the next poll, as libicsneo's does. Transmitted frames are copied
+ * and counted like libicsneo queues them, then handed to the message callbacks as transmit receipts.
+ * It is single threaded, callbacks are called on the thread which transmits.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "icsneo/icsneoc.h"
+
+#define ICSNEOSIM_SERIAL "SIM001"
+#define ICSNEOSIM_DESCRIPTION "neoVI SIM " ICSNEOSIM_SERIAL
+#define ICSNEOSIM_PRODUCT_NAME "neoVI SIM"
+#define ICSNEOSIM_DEFAULT_MESSAGES_PER_POLL 100
+#define ICSNEOSIM_MAX_MESSAGES_PER_POLL 20000
+#define ICSNEOSIM_MAX_CALLBACKS 16
+#define ICSNEOSIM_TIMESTAMP_STEP 1000 // ns between simulated frames, 1000 frames per ms
+
+typedef void (*icsneosim_callback_t)(neomessage_t);
+
+static struct {
+	bool found;
+	bool open;
+	bool online;
+	bool polling;
+	bool writeBlocks;
+	size_t pollingLimit;
+	size_t messagesPerPoll;
+	uint64_t timestamp;
+	uint32_t counter;
+	uint64_t transmitted;
+	uint8_t payload[ICSNEOSIM_MAX_MESSAGES_PER_POLL][8];
+	uint8_t transmitScratch[64];
+	icsneosim_callback_t callbacks[ICSNEOSIM_MAX_CALLBACKS];
+	int64_t baudrate;
+	int64_t fdBaudrate;
+	size_t eventLimit;
+	uint8_t settings[512];
+} sim = {
+	.pollingLimit = 20000,
+	.baudrate = 500000,
+	.fdBaudrate = 2000000,
+	.eventLimit = 10000
+};
+
+static void* const simHandle = &sim;
+
+static bool isSimDevice(const neodevice_t* device) {
+	return sim.found && device != NULL && device->device == simHandle;
+}
+
+static bool isReady(const neodevice_t* device) {
+	return isSimDevice(device) && sim.open && sim.online;
+}
+
+static bool copyString(const char* source, char* str, size_t* maxLength) {
+	if(str == NULL || maxLength == NULL || *maxLength == 0)
+		return false;
+	size_t length = strlen(source);
+	if(length >= *maxLength)
+		length = *maxLength - 1;
+	memcpy(str, source, length);
+	str[length] = '\0';
+	*maxLength = length;
+	return true;
+}
+
+static size_t messagesPerPoll(void) {
+	if(sim.messagesPerPoll == 0) {
+		const char* setting = getenv("ICSNEOSIM_MESSAGES_PER_POLL");
+		long value = setting ? strtol(setting, NULL, 10) : 0;
+		if(value <= 0)
+			value = ICSNEOSIM_DEFAULT_MESSAGES_PER_POLL;
+		else if(value > ICSNEOSIM_MAX_MESSAGES_PER_POLL)
+			value = ICSNEOSIM_MAX_MESSAGES_PER_POLL;
+		sim.messagesPerPoll = (size_t)value;
+	}
+	return sim.messagesPerPoll;
+}
+
+void icsneo_findAllDevices(neodevice_t* devices, size_t* count) {
+	if(count == NULL)
+		return;
+	if(devices == NULL || *count == 0) {
+		*count = 1;
+		return;
+	}
+	sim.found = true;
+	memset(devices, 0, sizeof(neodevice_t));
+	devices->device = simHandle;
+	devices->handle = -1;
+	memcpy(devices->serial, ICSNEOSIM_SERIAL, sizeof(devices->serial));
+	*count = 1;
+}
+
+void icsneo_freeUnconnectedDevices() {
+	if(!sim.open)
+		sim.found = false;
+}
+
+bool icsneo_serialNumToString(uint32_t num, char* str, size_t* count) {
+	char digits[7];
+	for(int i = 5; i >= 0; i--) {
+		uint32_t digit = num % 36;
+		digits[i] = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+		num /= 36;
+	}
+	digits[6] = '\0';
+	if(count == NULL || *count < sizeof(digits))
+		return false;
+	return copyString(digits, str, count);
+}
+
+uint32_t icsneo_serialStringToNum(const char* str) {
+	uint32_t num = 0;
+	for(int i = 0; str != NULL && i < 6 && str[i] != '\0'; i++) {
+		char c = str[i];
+		if(c >= '0' && c <= '9')
+			num = num * 36 + (uint32_t)(c - '0');
+		else if(c >= 'A' && c <= 'Z')
+			num = num * 36 + (uint32_t)(c - 'A' + 10);
+		else if(c >= 'a' && c <= 'z')
+			num = num * 36 + (uint32_t)(c - 'a' + 10);
+		else
+			return 0;
+	}
+	return num;
+}
+
+bool icsneo_isValidNeoDevice(const neodevice_t* device) {
+	return isSimDevice(device);
+}
+
+bool icsneo_openDevice(const neodevice_t* device) {
+	if(!isSimDevice(device) || sim.open)
+		return false;
+	sim.open = true;
+	sim.polling = false;
+	return true;
+}
+
+bool icsneo_closeDevice(const neodevice_t* device) {
+	if(!isSimDevice(device) || !sim.open)
+		return false;
+	sim.open = false;
+	sim.online = false;
+	sim.polling = false;
+	memset(sim.callbacks, 0, sizeof(sim.callbacks));
+	return true;
+}
+
+bool icsneo_isOpen(const neodevice_t* device) {
+	return isSimDevice(device) && sim.open;
+}
+
+bool icsneo_goOnline(const neodevice_t* device) {
+	if(!isSimDevice(device) || !sim.open)
+		return false;
+	sim.online = true;
+	return true;
+}
+
+bool icsneo_goOffline(const neodevice_t* device) {
+	if(!isSimDevice(device) || !sim.open)
+		return false;
+	sim.online = false;
+	return true;
+}
+
+bool icsneo_isOnline(const neodevice_t* device) {
+	return isSimDevice(device) && sim.online;
+}
+
+bool icsneo_enableMessagePolling(const neodevice_t* device) {
+	if(!isSimDevice(device) || !sim.open)
+		return false;
+	sim.polling = true;
+	return true;
+}
+
+bool icsneo_disableMessagePolling(const neodevice_t* device) {
+	if(!isSimDevice(device) || !sim.polling)
+		return false;
+	sim.polling = false;
+	return true;
+}
+
+bool icsneo_isMessagePollingEnabled(const neodevice_t* device) {
+	return isSimDevice(device) && sim.polling;
+}
+
+bool icsneo_getMessages(const neodevice_t* device, neomessage_t* messages, size_t* items, uint64_t timeout) {
+	(void)timeout;
+	if(!isSimDevice(device) || !sim.polling || items == NULL)
+		return false;
+
+	size_t available = sim.online ? messagesPerPoll() : 0;
+	if(messages == NULL) {
+		*items = available;
+		return true;
+	}
+	if(*items > available)
+		*items = available;
+
+	for(size_t i = 0; i < *items; i++) {
+		neomessage_can_t* can = (neomessage_can_t*)(messages + i);
+		uint8_t* data = sim.payload[i];
+		uint32_t counter = sim.counter++;
+
+		for(int j = 0; j < 8; j++)
+			data[j] = (uint8_t)(counter >> 8 * (j & 3));
+
+		memset(can, 0, sizeof(neomessage_t));
+		can->timestamp = sim.timestamp += ICSNEOSIM_TIMESTAMP_STEP;
+		can->data = data;
+		can->length = 8;
+		can->arbid = 0x100 + counter % 0x100;
+		can->netid = ICSNEO_NETID_HSCAN;
+		can->type = ICSNEO_NETWORK_TYPE_CAN;
+		can->dlcOnWire = 8;
+	}
+	return true;
+}
+
+int icsneo_getPollingMessageLimit(const neodevice_t* device) {
+	return isSimDevice(device) ? (int)sim.pollingLimit : -1;
+}
+
+bool icsneo_setPollingMessageLimit(const neodevice_t* device, size_t newLimit) {
+	if(!isSimDevice(device))
+		return false;
+	sim.pollingLimit = newLimit;
+	return true;
+}
+
+int icsneo_addMessageCallback(const neodevice_t* device, void (*callback)(neomessage_t), void* reserved) {
+	(void)reserved;
+	if(!isSimDevice(device) || callback == NULL)
+		return -1;
+	for(int i = 0; i < ICSNEOSIM_MAX_CALLBACKS; i++) {
+		if(sim.callbacks[i] == NULL) {
+			sim.callbacks[i] = callback;
+			return i;
+		}
+	}
+	return -1;
+}
+
+bool icsneo_removeMessageCallback(const neodevice_t* device, int id) {
+	if(!isSimDevice(device) || id < 0 || id >= ICSNEOSIM_MAX_CALLBACKS || sim.callbacks[id] == NULL)
+		return false;
+	sim.callbacks[id] = NULL;
+	return true;
+}
+
+bool icsneo_getProductName(const neodevice_t* device, char* str, size_t* maxLength) {
+	return isSimDevice(device) && copyString(ICSNEOSIM_PRODUCT_NAME, str, maxLength);
+}
+
+bool icsneo_getProductNameForType(devicetype_t type, char* str, size_t* maxLength) {
+	(void)type;
+	return copyString(ICSNEOSIM_PRODUCT_NAME, str, maxLength);
+}
+
+bool icsneo_settingsRefresh(const neodevice_t* device) {
+	return isSimDevice(device) && sim.open;
+}
+
+bool icsneo_settingsApply(const neodevice_t* device) {
+	return isSimDevice(device) && sim.open;
+}
+
+bool icsneo_settingsApplyTemporary(const neodevice_t* device) {
+	return isSimDevice(device) && sim.open;
+}
+
+bool icsneo_settingsApplyDefaults(const neodevice_t* device) {
+	if(!isSimDevice(device) || !sim.open)
+		return false;
+	memset(sim.settings, 0, sizeof(sim.settings));
+	sim.baudrate = 500000;
+	sim.fdBaudrate = 2000000;
+	return true;
+}
+
+bool icsneo_settingsApplyDefaultsTemporary(const neodevice_t* device) {
+	return icsneo_settingsApplyDefaults(device);
+}
+
+int icsneo_settingsReadStructure(const neodevice_t* device, void* structure, size_t structureSize) {
+	if(!isSimDevice(device) || !sim.open)
+		return -1;
+	if(structure == NULL)
+		return (int)sizeof(sim.settings);
+	if(structureSize > sizeof(sim.settings))
+		structureSize = sizeof(sim.settings);
+	memcpy(structure, sim.settings, structureSize);
+	return (int)structureSize;
+}
+
+bool icsneo_settingsApplyStructure(const neodevice_t* device, const void* structure, size_t structureSize) {
+	if(!isSimDevice(device) || !sim.open || structure == NULL || structureSize != sizeof(sim.settings))
+		return false;
+	memcpy(sim.settings, structure, structureSize);
+	return true;
+}
+
+bool icsneo_settingsApplyStructureTemporary(const neodevice_t* device, const void* structure, size_t structureSize) {
+	return icsneo_settingsApplyStructure(device, structure, structureSize);
+}
+
+int64_t icsneo_getBaudrate(const neodevice_t* device, uint16_t netid) {
+	if(!isSimDevice(device) || netid != ICSNEO_NETID_HSCAN)
+		return -1;
+	return sim.baudrate;
+}
+
+bool icsneo_setBaudrate(const neodevice_t* device, uint16_t netid, int64_t newBaudrate) {
+	if(!isSimDevice(device) || !sim.open || netid != ICSNEO_NETID_HSCAN || newBaudrate <= 0)
+		return false;
+	sim.baudrate = newBaudrate;
+	return true;
+}
+
+int64_t icsneo_getFDBaudrate(const neodevice_t* device, uint16_t netid) {
+	if(!isSimDevice(device) || netid != ICSNEO_NETID_HSCAN)
+		return -1;
+	return sim.fdBaudrate;
+}
+
+bool icsneo_setFDBaudrate(const neodevice_t* device, uint16_t netid, int64_t newBaudrate) {
+	if(!isSimDevice(device) || !sim.open || netid != ICSNEO_NETID_HSCAN || newBaudrate <= 0)
+		return false;
+	sim.fdBaudrate = newBaudrate;
+	return true;
+}
+
+bool icsneo_transmit(const neodevice_t* device, const neomessage_t* message) {
+	if(!isReady(device) || message == NULL || message->length > sizeof(sim.transmitScratch))
+		return false;
+	if(message->length != 0 && message->data == NULL)
+		return false;
+
+	// libicsneo copies the frame into its own transmit queue before returning
+	memcpy(sim.transmitScratch, message->data, message->length);
+	sim.transmitted++;
+
+	for(int i = 0; i < ICSNEOSIM_MAX_CALLBACKS; i++) {
+		if(sim.callbacks[i] != NULL) {
+			neomessage_t receipt = *message;
+			receipt.status.transmitMessage = true;
+			receipt.timestamp = sim.timestamp += ICSNEOSIM_TIMESTAMP_STEP;
+			receipt.data = sim.transmitScratch;
+			sim.callbacks[i](receipt);
+		}
+	}
+	return true;
+}
+
+bool icsneo_transmitMessages(const neodevice_t* device, const neomessage_t* messages, size_t count) {
+	if(!isReady(device) || (messages == NULL && count != 0))
+		return false;
+	for(size_t i = 0; i < count; i++) {
+		if(!icsneo_transmit(device, messages + i))
+			return false;
+	}
+	return true;
+}
+
+void icsneo_setWriteBlocks(const neodevice_t* device, bool blocks) {
+	if(isSimDevice(device))
+		sim.writeBlocks = blocks;
+}
+
+bool icsneo_describeDevice(const neodevice_t* device, char* str, size_t* maxLength) {
+	return isSimDevice(device) && copyString(ICSNEOSIM_DESCRIPTION, str, maxLength);
+}
+
+neoversion_t icsneo_getVersion() {
+	neoversion_t version;
+	memset(&version, 0, sizeof(version));
+	version.major = 0;
+	version.minor = 2;
+	version.patch = 0;
+	version.metadata = "sim";
+	version.buildBranch = "";
+	version.buildTag = "";
+	return version;
+}
+
+bool icsneo_getEvents(neoevent_t* events, size_t* size) {
+	(void)events;
+	if(size == NULL)
+		return false;
+	*size = 0;
+	return true;
+}
+
+bool icsneo_getDeviceEvents(const neodevice_t* device, neoevent_t* events, size_t* size) {
+	(void)device;
+	return icsneo_getEvents(events, size);
+}
+
+bool icsneo_getLastError(neoevent_t* error) {
+	(void)error;
+	return false;
+}
+
+void icsneo_discardAllEvents() {}
+
+void icsneo_discardDeviceEvents(const neodevice_t* device) {
+	(void)device;
+}
+
+void icsneo_setEventLimit(size_t newLimit) {
+	sim.eventLimit = newLimit;
+}
+
+size_t icsneo_getEventLimit() {
+	return sim.eventLimit;
+}
+
+bool icsneo_getSupportedDevices(devicetype_t* devices, size_t* count) {
+	(void)devices;
+	if(count == NULL)
+		return false;
+	*count = 0;
+	return true;
+}
+
+bool icsneo_getTimestampResolution(const neodevice_t* device, uint16_t* resolution) {
+	if(!isSimDevice(device) || resolution == NULL)
+		return false;
+	*resolution = 1; // ns
+	return true;
+}